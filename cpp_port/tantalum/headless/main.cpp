@@ -0,0 +1,250 @@
+#include <lodepng.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "cpu_renderer.h"
+#include "scene_info.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+static const std::string scene_path = std::string(PROJECT_DIR) + "/scenes/";
+
+static void usage()
+{
+    cout << "usage: tantalum_headless [options]\n"
+            "  --scene N       index in scenes/scenes.list (default 0)\n"
+            "  --scene-file F  render scene file F instead\n"
+            "  --width W       image width (default 1024)\n"
+            "  --height H      image height (default 576)\n"
+            "  --samples S     light paths to trace (default 1000000)\n"
+            "  --length L      maximum light path length (default 12)\n"
+            "  --threads T     worker threads (default: all cores)\n"
+            "  --reduce MODE   wave buffer tiles to reduce, dirty or all\n"
+            "                  (default dirty)\n"
+            "  --wavefront B   1 to sort rays by material and shade each\n"
+            "                  material in SIMD packets (default 0)\n"
+            "  --regenerate B  1 to re-emit rays as soon as their path ends\n"
+            "                  (default 0). CPU only: the viewer always\n"
+            "                  traces whole waves\n"
+            "  --hero B        1 to trace four wavelengths per ray until the\n"
+            "                  path disperses (default 0)\n"
+            "  --spectral B    1 to accumulate spectral bins and convert them\n"
+            "                  to color at the end (default 0). The wave\n"
+            "                  and the image then take 64 bytes per pixel\n"
+            "                  each, about 265 MB at 1920 x 1080, whatever\n"
+            "                  the thread count\n"
+            "  --spectral-output O\n"
+            "                  rgb or xyz, what spectral bins are converted\n"
+            "                  to (default rgb)\n"
+            "  --accelerator A linear, bvh, grid or quadtree (default: the\n"
+            "                  one of the scene)\n"
+            "  --specialize B  0 to intersect linear built-in scenes from\n"
+            "                  their primitive lists instead of the C++\n"
+            "                  compiled for them (default 1)\n"
+            "  --benchmark B   1 to render with every accelerator in turn and\n"
+            "                  compare their speed, writing no image\n"
+            "                  (default 0)\n"
+            "  --output FILE   output png (default tantalum.png)"
+         << endl;
+}
+
+int main(int argc, char** argv)
+{
+    int         scene       = 0;
+    std::string sceneFile   = "";
+    int         width       = 1024;
+    int         height      = 576;
+    int         samples     = 1000000;
+    int         length      = 12;
+    int         threads     = 0;
+    std::string reduce      = "dirty";
+    int         wavefront   = 0;
+    int         regenerate  = 0;
+    int         hero        = 0;
+    int         spectral    = 0;
+    std::string spectralOut = "rgb";
+    std::string accelerator = "";
+    int         specialize  = 1;
+    int         benchmark   = 0;
+    std::string output      = "tantalum.png";
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg   = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "--help" || arg == "-h")
+        {
+            usage();
+            return 0;
+        }
+        if (!value)
+        {
+            usage();
+            return 1;
+        }
+
+        if (arg == "--scene")
+            scene = atoi(value);
+        else if (arg == "--scene-file")
+            sceneFile = value;
+        else if (arg == "--width")
+            width = atoi(value);
+        else if (arg == "--height")
+            height = atoi(value);
+        else if (arg == "--samples")
+            samples = atoi(value);
+        else if (arg == "--length")
+            length = atoi(value);
+        else if (arg == "--threads")
+            threads = atoi(value);
+        else if (arg == "--reduce")
+            reduce = value;
+        else if (arg == "--wavefront")
+            wavefront = atoi(value);
+        else if (arg == "--regenerate")
+            regenerate = atoi(value);
+        else if (arg == "--hero")
+            hero = atoi(value);
+        else if (arg == "--spectral")
+            spectral = atoi(value);
+        else if (arg == "--spectral-output")
+            spectralOut = value;
+        else if (arg == "--accelerator")
+            accelerator = value;
+        else if (arg == "--specialize")
+            specialize = atoi(value);
+        else if (arg == "--benchmark")
+            benchmark = atoi(value);
+        else if (arg == "--output")
+            output = value;
+        else
+        {
+            usage();
+            return 1;
+        }
+        i++;
+    }
+
+    if ((reduce != "dirty" && reduce != "all") ||
+        (spectralOut != "rgb" && spectralOut != "xyz"))
+    {
+        usage();
+        return 1;
+    }
+
+    std::vector<TSceneInfo> scenes;
+    try
+    {
+        if (sceneFile.empty())
+            scenes = builtinSceneInfos(scene_path);
+        else
+            scenes = {loadSceneInfo(sceneFile)};
+    }
+    catch (const std::runtime_error& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    if (!sceneFile.empty()) scene = 0;
+    if (scene < 0 || scene >= int(scenes.size()))
+    {
+        cerr << "no such scene : " << scene << endl;
+        return 1;
+    }
+
+    if (!accelerator.empty() &&
+        !parseAccelerator(accelerator, scenes[scene].accelerator))
+    {
+        usage();
+        return 1;
+    }
+
+    /* The benchmark renders the same paths with every accelerator, and
+       linear intersection both from the primitive list and specialized */
+    struct TRun
+    {
+        EAcceleratorType accelerator;
+        bool             specialize;
+    };
+    std::vector<TRun> runs = {{scenes[scene].accelerator, specialize != 0}};
+    if (benchmark)
+    {
+        runs = {{EAcceleratorType::LINEAR, false},
+                {EAcceleratorType::LINEAR, true},
+                {EAcceleratorType::BVH, false},
+                {EAcceleratorType::GRID, false},
+                {EAcceleratorType::QUADTREE, false}};
+    }
+
+    for (const TRun& run : runs)
+    {
+        EAcceleratorType type     = run.accelerator;
+        scenes[scene].accelerator = type;
+
+        TCpuRenderer renderer(width, height, scenes, threads);
+        if (!run.specialize) renderer.scenes[scene].specialized = nullptr;
+        bool specialized = renderer.scenes[scene].specialized != nullptr;
+        if (benchmark && run.specialize && !specialized) continue;
+
+        renderer.reduceDirtyTilesOnly = reduce == "dirty";
+        renderer.wavefront            = wavefront != 0;
+        renderer.regenerate           = regenerate != 0;
+        renderer.heroWavelengths      = hero != 0;
+        renderer.setSpectral(spectral != 0);
+        renderer.setSpectralOutput(spectralOut == "xyz"
+                                       ? ESpectralOutput::SPECTRAL_XYZ
+                                       : ESpectralOutput::SPECTRAL_RGB);
+        renderer.setMaxSampleCount(samples);
+        renderer.setMaxPathLength(length);
+        renderer.changeScene(scene);
+        renderer.setSpreadType(scenes[scene].spread);
+        renderer.setNormalizedEmitterPos(scenes[scene].posA,
+                                         scenes[scene].posB);
+
+        if (spectral)
+        {
+            double bytes = renderer.screenBuffer.size() * sizeof(float);
+            for (const auto& buffer : renderer.waveBuffers)
+                bytes += buffer.pixels.size() * sizeof(float);
+            cout << "spectral buffers take " << bytes * 1e-6 << " MB" << endl;
+        }
+
+        cout << "rendering " << scenes[scene].name << " at " << width
+             << " x " << height << " on " << renderer.numThreads
+             << " threads, " << acceleratorName(type)
+             << (specialized ? " specialized" : "") << " intersection" << endl;
+
+        auto start = std::chrono::steady_clock::now();
+        while (!renderer.finished())
+        {
+            renderer.render();
+        }
+        auto seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+        cout << renderer.totalRaysTraced() << " rays traced in " << seconds
+             << " s (" << renderer.totalRaysTraced() / seconds * 1e-6
+             << " Mrays/s)" << endl;
+        if (benchmark) continue;
+
+        std::vector<unsigned char> pixels;
+        renderer.composite(pixels);
+        unsigned error = lodepng::encode(output, pixels, width, height);
+        if (error)
+        {
+            cerr << "cannot write " << output << " : "
+                 << lodepng_error_text(error) << endl;
+            return 1;
+        }
+        cout << "saved " << output << endl;
+    }
+
+    return 0;
+}
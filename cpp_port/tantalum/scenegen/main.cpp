@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "scene_compiler.h"
+#include "scene_info.h"
+
+using std::cerr;
+using std::endl;
+
+/* Writes the built-in scenes of cpu_builtin_scenes.cpp: one TStaticScene
+   per scene of scenes.list without polylines, found by sceneFingerprint.
+   Scenes with an accelerator are compiled as LINEAR, for runs that
+   override it */
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        cerr << "usage: tantalum_scenegen SCENE_DIR OUTPUT" << endl;
+        return 1;
+    }
+
+    std::vector<TSceneInfo> scenes;
+    try
+    {
+        scenes = builtinSceneInfos(argv[1]);
+    }
+    catch (const std::runtime_error& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    std::ostringstream out;
+    std::ostringstream entries;
+    out << "// Generated by tantalum_scenegen, do not edit\n";
+    for (size_t i = 0; i < scenes.size(); i++)
+    {
+        TSceneInfo scene  = scenes[i];
+        scene.accelerator = EAcceleratorType::LINEAR;
+        if (!canCompileSceneCpp(scene)) continue;
+
+        std::string typeName = "TBuiltinScene" + std::to_string(i);
+        char        fingerprint[32];
+        std::snprintf(fingerprint,
+                      sizeof(fingerprint),
+                      "0x%016llxull",
+                      (unsigned long long)sceneFingerprint(scene));
+
+        out << "\n" << compileSceneCpp(scene, typeName);
+        entries << "    staticSceneEntry<" << typeName << ">(" << fingerprint
+                << "),\n";
+    }
+    out << "\n"
+        << "static const TStaticSceneEntry builtinStaticScenes[] = {\n"
+        << entries.str() << "    {0, nullptr, nullptr, nullptr},\n"
+        << "};\n";
+
+    /* Leave an unchanged file alone so its dependents are not rebuilt */
+    std::ifstream     previous(argv[2]);
+    std::stringstream text;
+    text << previous.rdbuf();
+    if (previous && text.str() == out.str()) return 0;
+    previous.close();
+
+    std::ofstream file(argv[2]);
+    file << out.str();
+    if (!file)
+    {
+        cerr << "cannot write " << argv[2] << endl;
+        return 1;
+    }
+    return 0;
+}
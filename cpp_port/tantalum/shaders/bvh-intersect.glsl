@@ -0,0 +1,35 @@
+/* Traversal of the scene BVH built by TSceneBvh, see scene_bvh.h for the
+   layout of SceneData. Needs scene-data.glsl */
+
+#define BVH_STACK_SIZE 32
+
+bool nodeIntersect(Ray ray, vec4 bounds, Intersection isect) {
+    vec2 t1 = (bounds.xy - ray.pos)*ray.invDir;
+    vec2 t2 = (bounds.zw - ray.pos)*ray.invDir;
+    vec2 tLo = min(t1, t2), tHi = max(t1, t2);
+    return max(max(tLo.x, tLo.y), isect.tMin) <= min(min(tHi.x, tHi.y), isect.tMax);
+}
+
+void bvhIntersect(Ray ray, inout Intersection isect) {
+    float stack[BVH_STACK_SIZE];
+    int size = 1;
+    stack[0] = 0.0;
+    while (size > 0) {
+        size--;
+        float node = stack[size];
+        if (!nodeIntersect(ray, sceneTexel(node), isect))
+            continue;
+
+        /* (first texel, count, axis, 0) */
+        vec4 info = sceneTexel(node + 1.0);
+        if (info.y > 0.0) {
+            for (float i = 0.0; i < info.y; i += 1.0)
+                primitiveIntersect(ray, info.x + 3.0*i, isect);
+        } else {
+            /* Visit the nearer child first; the left one has the lower centroids */
+            bool leftFirst = (info.z == 0.0 ? ray.dir.x : ray.dir.y) >= 0.0;
+            stack[size++] = info.x + (leftFirst ? 2.0 : 0.0);
+            stack[size++] = info.x + (leftFirst ? 0.0 : 2.0);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#include </preamble.glsl>
+// #include "preamble"
+
+#define SPECTRAL_PLANES 4
+#define SPECTRAL_BINS 16
+
+uniform sampler2D Frame;
+uniform sampler2D BinResponse;
+uniform float Exposure;
+
+varying vec2 vTexCoord;
+
+vec3 binResponse(int bin) {
+    return texture2D(BinResponse, vec2((float(bin) + 0.5)*(1.0/float(SPECTRAL_BINS)), 0.5)).rgb;
+}
+
+// Converts the spectral bins of Frame, SPECTRAL_PLANES images stacked
+// vertically, to color through the response of each bin
+void main() {
+    vec3 color = vec3(0.0);
+    for (int plane = 0; plane < SPECTRAL_PLANES; plane++) {
+        vec2 uv = vec2(vTexCoord.x, (vTexCoord.y + float(plane))*(1.0/float(SPECTRAL_PLANES)));
+        vec4 bins = texture2D(Frame, uv);
+        color += bins.x*binResponse(plane*4 + 0);
+        color += bins.y*binResponse(plane*4 + 1);
+        color += bins.z*binResponse(plane*4 + 2);
+        color += bins.w*binResponse(plane*4 + 3);
+    }
+    gl_FragColor = vec4(pow(max(color*Exposure, vec3(0.0)), vec3(1.0/2.2)), 1.0);
+}
@@ -0,0 +1,126 @@
+/* Quadratic and cubic Bezier curves, with the normal to the left of the
+   tangent like lineIntersect. A curve stays inside the hull of its control
+   points, so it is skipped if they all lie on one side of the ray line or
+   outside [tMin, tMax] along it. Otherwise it crosses the ray where its
+   signed distance d(u) to the ray line has a root in [0, 1]: in closed form
+   for quadratics, by safeguarded Newton on each monotonic piece of d for
+   cubics */
+
+#define CUBIC_ITERATIONS 16
+
+vec2 bezierLerp(vec2 a, vec2 b, float u) {
+    return a + (b - a)*u;
+}
+
+void bezierHit(Ray ray, float u, vec2 point, vec2 tangent, float matId, inout Intersection isect) {
+    float t = dot(point - ray.pos, ray.dir);
+    if (u < 0.0 || u > 1.0 || t <= isect.tMin || t >= isect.tMax)
+        return;
+
+    isect.tMax = t;
+    isect.n = normalize(vec2(-tangent.y, tangent.x));
+    isect.mat = matId;
+}
+
+void quadraticBezierHit(Ray ray, vec2 p0, vec2 p1, vec2 p2, float u, float matId, inout Intersection isect) {
+    vec2 q0 = bezierLerp(p0, p1, u);
+    vec2 q1 = bezierLerp(p1, p2, u);
+    vec2 tangent = q1 - q0;
+    if (tangent.x == 0.0 && tangent.y == 0.0)
+        tangent = p2 - p0;
+    bezierHit(ray, u, bezierLerp(q0, q1, u), tangent, matId, isect);
+}
+
+void cubicBezierHit(Ray ray, vec2 p0, vec2 p1, vec2 p2, vec2 p3, float u, float matId, inout Intersection isect) {
+    vec2 q0 = bezierLerp(p0, p1, u);
+    vec2 q1 = bezierLerp(p1, p2, u);
+    vec2 q2 = bezierLerp(p2, p3, u);
+    vec2 r0 = bezierLerp(q0, q1, u);
+    vec2 r1 = bezierLerp(q1, q2, u);
+    vec2 tangent = r1 - r0;
+    if (tangent.x == 0.0 && tangent.y == 0.0)
+        tangent = p3 - p0;
+    bezierHit(ray, u, bezierLerp(r0, r1, u), tangent, matId, isect);
+}
+
+/* Root in [lo, hi] of c.x + c.y*u + c.z*u^2 + c.w*u^3, monotonic there, or
+   -1 if it keeps its sign. Newton steps that leave the bracket of the root
+   bisect it instead */
+float cubicRoot(vec4 c, float lo, float hi) {
+    float dLo = ((c.w*lo + c.z)*lo + c.y)*lo + c.x;
+    float dHi = ((c.w*hi + c.z)*hi + c.y)*hi + c.x;
+    if (min(dLo, dHi) > 0.0 || max(dLo, dHi) < 0.0)
+        return -1.0;
+
+    float u = dLo != dHi ? lo + (hi - lo)*(dLo/(dLo - dHi)) : lo;
+    for (int i = 0; i < CUBIC_ITERATIONS; i++) {
+        float d = ((c.w*u + c.z)*u + c.y)*u + c.x;
+        float slope = (3.0*c.w*u + 2.0*c.z)*u + c.y;
+        if ((d < 0.0) == (dLo < 0.0))
+            lo = u;
+        else
+            hi = u;
+
+        float next = slope != 0.0 ? u - d/slope : lo - 1.0;
+        u = next >= lo && next <= hi ? next : 0.5*(lo + hi);
+    }
+    return u;
+}
+
+void quadraticBezierIntersect(Ray ray, vec2 p0, vec2 p1, vec2 p2, float matId, inout Intersection isect) {
+    vec2 n = vec2(-ray.dir.y, ray.dir.x);
+    float d0 = dot(n, p0 - ray.pos), s0 = dot(ray.dir, p0 - ray.pos);
+    float d1 = dot(n, p1 - ray.pos), s1 = dot(ray.dir, p1 - ray.pos);
+    float d2 = dot(n, p2 - ray.pos), s2 = dot(ray.dir, p2 - ray.pos);
+    if (min(min(d0, d1), d2) > 0.0 || max(max(d0, d1), d2) < 0.0 ||
+        max(max(s0, s1), s2) <= isect.tMin || min(min(s0, s1), s2) >= isect.tMax)
+        return;
+
+    /* d(u) = a*u^2 + b*u + c, solved without cancellation */
+    float a = d0 - 2.0*d1 + d2;
+    float b = 2.0*(d1 - d0);
+    float c = d0;
+    float disc = b*b - 4.0*a*c;
+    if (disc < 0.0)
+        return;
+
+    float root = sqrt(disc);
+    float q = -0.5*(b + (b >= 0.0 ? root : -root));
+    float u1 = a != 0.0 ? q/a : -1.0;
+    float u2 = q != 0.0 ? c/q : -1.0;
+    quadraticBezierHit(ray, p0, p1, p2, u1, matId, isect);
+    quadraticBezierHit(ray, p0, p1, p2, u2, matId, isect);
+}
+
+void cubicBezierIntersect(Ray ray, vec2 p0, vec2 p1, vec2 p2, vec2 p3, float matId, inout Intersection isect) {
+    vec2 n = vec2(-ray.dir.y, ray.dir.x);
+    float d0 = dot(n, p0 - ray.pos), s0 = dot(ray.dir, p0 - ray.pos);
+    float d1 = dot(n, p1 - ray.pos), s1 = dot(ray.dir, p1 - ray.pos);
+    float d2 = dot(n, p2 - ray.pos), s2 = dot(ray.dir, p2 - ray.pos);
+    float d3 = dot(n, p3 - ray.pos), s3 = dot(ray.dir, p3 - ray.pos);
+    if (min(min(d0, d1), min(d2, d3)) > 0.0 || max(max(d0, d1), max(d2, d3)) < 0.0 ||
+        max(max(s0, s1), max(s2, s3)) <= isect.tMin || min(min(s0, s1), min(s2, s3)) >= isect.tMax)
+        return;
+
+    /* d(u) in the power basis, split at the roots of d'(u) = a*u^2 + b*u + c */
+    vec4 coeffs = vec4(d0, 3.0*(d1 - d0), 3.0*(d0 - 2.0*d1 + d2), d3 - d0 + 3.0*(d1 - d2));
+    float a = 3.0*coeffs.w;
+    float b = 2.0*coeffs.z;
+    float c = coeffs.y;
+    float disc = b*b - 4.0*a*c;
+    float e1 = 1.0, e2 = 1.0;
+    if (disc >= 0.0) {
+        float root = sqrt(disc);
+        float q = -0.5*(b + (b >= 0.0 ? root : -root));
+        float r1 = a != 0.0 ? q/a : 1.0;
+        float r2 = q != 0.0 ? c/q : 1.0;
+        r1 = r1 > 0.0 && r1 < 1.0 ? r1 : 1.0;
+        r2 = r2 > 0.0 && r2 < 1.0 ? r2 : 1.0;
+        e1 = min(r1, r2);
+        e2 = max(r1, r2);
+    }
+
+    cubicBezierHit(ray, p0, p1, p2, p3, cubicRoot(coeffs, 0.0, e1), matId, isect);
+    cubicBezierHit(ray, p0, p1, p2, p3, cubicRoot(coeffs, e1, e2), matId, isect);
+    cubicBezierHit(ray, p0, p1, p2, p3, cubicRoot(coeffs, e2, 1.0), matId, isect);
+}
@@ -0,0 +1,36 @@
+/* Amanatides-Woo traversal of the uniform grid built by TSceneGrid, see
+   scene_grid.h for the layout of SceneData. Needs scene-data.glsl */
+
+void gridIntersect(Ray ray, inout Intersection isect) {
+    /* (lower, cellSize) (upper, resolution) */
+    vec4 header0 = sceneTexel(0.0);
+    vec4 header1 = sceneTexel(1.0);
+    vec2 lower = header0.xy, cellSize = header0.zw;
+    vec2 upper = header1.xy, resolution = header1.zw;
+
+    float tEnter, tExit;
+    if (!clipRay(ray, lower, upper, isect, tEnter, tExit))
+        return;
+
+    vec2 far = max(ray.dirSign, vec2(0.0));
+    vec2 cell = clamp(floor((ray.pos + ray.dir*tEnter - lower)/cellSize), vec2(0.0), resolution - 1.0);
+    while (true) {
+        /* (first index texel, count, 0, 0) */
+        vec4 range = sceneTexel(2.0 + cell.y*resolution.x + cell.x);
+        for (float i = 0.0; i < range.y; i += 1.0)
+            primitiveIntersect(ray, sceneTexel(range.x + i).x, isect);
+
+        /* Primitives are listed by every cell they overlap, so no later
+           cell can hold a hit closer than one before the far side of this one */
+        vec2 tNext = (lower + (cell + far)*cellSize - ray.pos)*ray.invDir;
+        if (isect.tMax <= min(tNext.x, tNext.y))
+            break;
+
+        if (tNext.x < tNext.y)
+            cell.x += ray.dirSign.x;
+        else
+            cell.y += ray.dirSign.y;
+        if (any(lessThan(cell, vec2(0.0))) || any(greaterThanEqual(cell, resolution)))
+            break;
+    }
+}
@@ -7,17 +7,36 @@
 
 uniform sampler2D RngData;
 uniform sampler2D Spectrum;
-uniform sampler2D Emission;
-uniform sampler2D ICDF;
-uniform sampler2D PDF;
+uniform sampler2D SpectrumAlias;
 uniform vec2 EmitterPos;
 uniform vec2 EmitterDir;
 uniform float EmitterPower;
 uniform float SpatialSpread;
 uniform vec2 AngularSpread;
+uniform float HeroWavelengths;
+uniform float Spectral;
 
 varying vec2 vTexCoord;
 
+// Alias table lookup: the bin picked by u is kept with probability
+// alias.x, otherwise its alias alias.y is sampled. alias.zw are the
+// emission/pdf weights of the two. Spectral accumulation splits the
+// radiance over rgb in proportion to the color of lambda, so albedos still
+// filter it, and ray-vert sums it back up into the bin of lambda
+vec3 sampleWavelength(float u, float jitter, out float lambda) {
+    u *= 256.0;
+    float bin = floor(u);
+    vec4 alias = texture2D(SpectrumAlias, vec2((bin + 0.5)*(1.0/256.0), 0.5));
+    bool keep = u - bin < alias.x;
+    bin = keep ? bin : alias.y;
+    float spectrumOffset = (bin + jitter)*(1.0/256.0);
+    lambda = 360.0 + (750.0 - 360.0)*spectrumOffset;
+    vec3 color = texture2D(Spectrum, vec2(spectrumOffset, 0.5)).rgb;
+    if (Spectral != 0.0)
+        color = abs(color)/max(dot(abs(color), vec3(1.0)), 1e-6);
+    return EmitterPower*(keep ? alias.z : alias.w)*color;
+}
+
 void main() {
     vec4 state = texture2D(RngData, vTexCoord);
 
@@ -26,14 +45,25 @@ void main() {
     vec2 pos = EmitterPos + (rand(state) - 0.5)*SpatialSpread*vec2(-EmitterDir.y, EmitterDir.x);
     
     float randL = rand(state);
-    float spectrumOffset = texture2D(ICDF, vec2(randL, 0.5)).r + rand(state)*(1.0/256.0);
-    float lambda = 360.0 + (750.0 - 360.0)*spectrumOffset;
-    vec3 rgb = EmitterPower
-                    *texture2D(Emission, vec2(spectrumOffset, 0.5)).r
-                    *texture2D(Spectrum, vec2(spectrumOffset, 0.5)).rgb
-                    /texture2D(PDF,      vec2(spectrumOffset, 0.5)).r;
+    float jitter = rand(state);
+    float lambda;
+    vec3 rgb = sampleWavelength(randL, jitter, lambda);
+    
+    // Hero wavelength mode: the ray carries the mean color of lambda and
+    // three more wavelengths, stratified in sample space, and the color of
+    // lambda alone in case the path disperses later on (see trace-frag)
+    vec4 hero = vec4(0.0);
+    if (HeroWavelengths != 0.0) {
+        float unused;
+        hero = vec4(rgb, 1.0);
+        rgb += sampleWavelength(fract(randL + 0.25), jitter, unused);
+        rgb += sampleWavelength(fract(randL + 0.50), jitter, unused);
+        rgb += sampleWavelength(fract(randL + 0.75), jitter, unused);
+        rgb *= 0.25;
+    }
     
     gl_FragData[0] = vec4(pos, dir);
     gl_FragData[1] = state;
     gl_FragData[2] = vec4(rgb, lambda);
+    gl_FragData[3] = hero;
 }
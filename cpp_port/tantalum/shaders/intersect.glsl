@@ -52,3 +52,13 @@ void prismIntersect(Ray ray, vec2 center, float radius, float matId, inout Inter
     lineIntersect(ray, center + vec2( 0.866, -0.5)*radius, center + vec2(-0.866, -0.5)*radius, matId, isect);
     lineIntersect(ray, center + vec2(-0.866, -0.5)*radius, center + vec2(   0.0,  1.0)*radius, matId, isect);
 }
+
+/* Clips the ray to [lower, upper] and [tMin, tMax] */
+bool clipRay(Ray ray, vec2 lower, vec2 upper, Intersection isect, out float tEnter, out float tExit) {
+    vec2 t1 = (lower - ray.pos)*ray.invDir;
+    vec2 t2 = (upper - ray.pos)*ray.invDir;
+    vec2 tLo = min(t1, t2), tHi = max(t1, t2);
+    tEnter = max(max(tLo.x, tLo.y), isect.tMin);
+    tExit = min(min(tHi.x, tHi.y), isect.tMax);
+    return tEnter <= tExit;
+}
@@ -0,0 +1,47 @@
+/* sample() for every scene, from the MaterialData texture of the scene
+   materials, see scene_data.h. A material is MATERIAL_TEXELS texels at
+   its id times MATERIAL_TEXELS; the table covers every id the scene uses,
+   so a scene change only swaps the texture. Dielectrics look up their IOR
+   in row id of the IorData texture instead of evaluating sellmeierIor */
+
+#define MATERIAL_TEXELS 6.0
+
+uniform sampler2D MaterialData;
+uniform vec2 MaterialDataSize;
+uniform sampler2D IorData;
+uniform vec2 IorDataSize;
+
+vec4 materialTexel(float index) {
+    float y = floor(index/MaterialDataSize.x);
+    float x = index - y*MaterialDataSize.x;
+    return texture2D(MaterialData, (vec2(x, y) + 0.5)/MaterialDataSize);
+}
+
+vec2 sample(inout vec4 state, Intersection isect, float lambda, vec2 wiLocal, inout vec3 throughput) {
+    float index = isect.mat*MATERIAL_TEXELS;
+    vec4 params = materialTexel(index);
+
+    if (params.x == 1.0)
+        return sampleMirror(wiLocal);
+    if (params.x == 2.0)
+        return sampleRoughMirror(state, wiLocal, throughput, params.y);
+    if (params.x >= 3.0) {
+        float x = (lambda - 360.0)/(750.0 - 360.0)*(IorDataSize.x - 1.0) + 0.5;
+        float ior = texture2D(IorData, vec2(x, isect.mat + 0.5)/IorDataSize).r;
+        if (params.x == 3.0)
+            return sampleDielectric(state, wiLocal, ior);
+        return sampleRoughDielectric(state, wiLocal, params.y, ior);
+    }
+
+    /* Diffuse, with the left and right albedos on the faces they color */
+    float face = isect.n.x == -1.0 ? 2.0 : (isect.n.x == 1.0 ? 3.0 : 1.0);
+    throughput *= materialTexel(index + face).rgb;
+    return sampleDiffuse(state, wiLocal);
+}
+
+/* Whether sample() depends on lambda at this hit: dielectrics, unless their
+   Sellmeier C coefficients are all zero and the IOR is constant */
+bool dispersive(Intersection isect) {
+    float index = isect.mat*MATERIAL_TEXELS;
+    return materialTexel(index).x >= 3.0 && materialTexel(index + 5.0).xyz != vec3(0.0);
+}
@@ -0,0 +1,60 @@
+/* Polylines of TPolylineGrid, see scene_polyline.h for the layout of
+   PolylineData. Texel i of PolylineData is the header texel of polyline i */
+
+uniform sampler2D PolylineData;
+uniform vec2 PolylineDataSize;
+
+vec4 polylineTexel(float index) {
+    float y = floor(index/PolylineDataSize.x);
+    float x = index - y*PolylineDataSize.x;
+    return texture2D(PolylineData, (vec2(x, y) + 0.5)/PolylineDataSize);
+}
+
+/* End of a piece in cell, packed as x + 4096*y lattice steps from the
+   corner of the cell */
+vec2 polylineDecode(vec2 lower, vec2 unit, vec2 cell, float end) {
+    float y = floor(end/4096.0);
+    float x = end - y*4096.0;
+    return lower + (cell*2048.0 + vec2(x, y))*unit;
+}
+
+void polylineIntersect(Ray ray, float index, float matId, inout Intersection isect) {
+    /* (lower, cellSize) (upper, resolution) (unit, piece texel, 0) */
+    float base = polylineTexel(index).x;
+    vec4 header0 = polylineTexel(base);
+    vec4 header1 = polylineTexel(base + 1.0);
+    vec4 header2 = polylineTexel(base + 2.0);
+    vec2 lower = header0.xy, cellSize = header0.zw;
+    vec2 upper = header1.xy, resolution = header1.zw;
+    vec2 unit = header2.xy;
+    float pieceTexel = header2.z;
+
+    float tEnter, tExit;
+    if (!clipRay(ray, lower, upper, isect, tEnter, tExit))
+        return;
+
+    /* Same walk as gridIntersect */
+    vec2 far = max(ray.dirSign, vec2(0.0));
+    vec2 cell = clamp(floor((ray.pos + ray.dir*tEnter - lower)/cellSize), vec2(0.0), resolution - 1.0);
+    while (true) {
+        /* (first piece, count, 0, 0), two pieces (a, b, a, b) per texel */
+        vec4 range = polylineTexel(base + 3.0 + cell.y*resolution.x + cell.x);
+        for (float i = range.x; i < range.x + range.y; i += 1.0) {
+            vec4 pieces = polylineTexel(pieceTexel + floor(i*0.5));
+            vec2 ends = mod(i, 2.0) == 0.0 ? pieces.xy : pieces.zw;
+            lineIntersect(ray, polylineDecode(lower, unit, cell, ends.x),
+                               polylineDecode(lower, unit, cell, ends.y), matId, isect);
+        }
+
+        vec2 tNext = (lower + (cell + far)*cellSize - ray.pos)*ray.invDir;
+        if (isect.tMax <= min(tNext.x, tNext.y))
+            break;
+
+        if (tNext.x < tNext.y)
+            cell.x += ray.dirSign.x;
+        else
+            cell.y += ray.dirSign.y;
+        if (any(lessThan(cell, vec2(0.0))) || any(greaterThanEqual(cell, resolution)))
+            break;
+    }
+}
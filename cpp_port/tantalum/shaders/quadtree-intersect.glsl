@@ -0,0 +1,36 @@
+/* Stackless traversal of the quadtree built by TSceneQuadtree, see
+   scene_grid.h for the layout of SceneData. Needs scene-data.glsl */
+
+void quadtreeIntersect(Ray ray, inout Intersection isect) {
+    vec4 root = sceneTexel(0.0);
+    float t, tExit;
+    if (!clipRay(ray, root.xy, root.zw, isect, t, tExit))
+        return;
+
+    vec2 upperSide = step(0.0, ray.dirSign);
+    while (true) {
+        /* Descend to the leaf the ray is in at distance t. A ray right on a
+           split goes to the side it is heading to */
+        vec4 bounds = root;
+        vec4 info = sceneTexel(1.0);
+        while (info.y < 0.0) {
+            vec2 tMid = (0.5*(bounds.xy + bounds.zw) - ray.pos)*ray.invDir;
+            bool right = ray.dirSign.x > 0.0 ? t >= tMid.x : t < tMid.x;
+            bool top   = ray.dirSign.y > 0.0 ? t >= tMid.y : t < tMid.y;
+            float node = info.x + 2.0*((right ? 1.0 : 0.0) + (top ? 2.0 : 0.0));
+            bounds = sceneTexel(node);
+            info = sceneTexel(node + 1.0);
+        }
+
+        for (float i = 0.0; i < info.y; i += 1.0)
+            primitiveIntersect(ray, sceneTexel(info.x + i).x, isect);
+
+        /* Leave through the far side, the same distance as the split the
+           next descent compares t to */
+        vec2 tSide = (mix(bounds.xy, bounds.zw, upperSide) - ray.pos)*ray.invDir;
+        float tLeave = min(tSide.x, tSide.y);
+        if (isect.tMax <= tLeave || tLeave >= tExit)
+            break;
+        t = tLeave;
+    }
+}
@@ -8,5 +8,8 @@ float rand(inout vec4 state) {
     vec4 p = a*(state - beta*q) - beta*r;
     beta = (1.0 - sign(p))*0.5*m;
     state = p + beta;
-    return fract(dot(state/m, vec4(1.0, -1.0, 1.0, -1.0)));
+    /* Spelled out rather than dot(), whose summation order is up to the
+       driver; src/cpu_rand.h sums in the same order */
+    vec4 u = state/m;
+    return fract((u.x - u.y) + (u.z - u.w));
 }
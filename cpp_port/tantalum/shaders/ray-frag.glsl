@@ -1,8 +1,8 @@
 #include </preamble.glsl>
 // #include "preamble"
 
-varying vec3 vColor;
+varying vec4 vColor;
 
 void main() {
-    gl_FragColor = vec4(vColor, 1.0);
+    gl_FragColor = vColor;
 }
@@ -5,18 +5,50 @@ uniform sampler2D PosDataA;
 uniform sampler2D PosDataB;
 uniform sampler2D RgbData;
 uniform float Aspect;
+uniform float SpectralPlanes;
+uniform float FrameHeight;
 
 attribute vec3 TexCoord;
 
-varying vec3 vColor;
+varying vec4 vColor;
 
 void main() {
     vec2 posA = texture2D(PosDataA, TexCoord.xy).xy;
     vec2 posB = texture2D(PosDataB, TexCoord.xy).xy;
-    vec2 pos = mix(posA, posB, TexCoord.z);
     vec2 dir = posB - posA;
     float biasCorrection = clamp(length(dir)/max(abs(dir.x), abs(dir.y)), 1.0, 1.414214);
+    vec4 rgbL = texture2D(RgbData, TexCoord.xy);
     
-    gl_Position = vec4(pos.x/Aspect, pos.y, 0.0, 1.0);
-    vColor = texture2D(RgbData, TexCoord.xy).rgb*biasCorrection;
+    if (SpectralPlanes == 1.0) {
+        vec2 pos = mix(posA, posB, TexCoord.z);
+        gl_Position = vec4(pos.x/Aspect, pos.y, 0.0, 1.0);
+        vColor = vec4(rgbL.rgb*biasCorrection, 1.0);
+        return;
+    }
+    
+    // Spectral accumulation: the frame is SpectralPlanes images stacked
+    // vertically, four bins each, and the segment goes to the image of the
+    // bin of its wavelength. It is clipped to the rows of that image first,
+    // half a pixel in, so it cannot bleed into its neighbours
+    float limit = 1.0 - 1.0/FrameHeight;
+    float t0 = 0.0;
+    float t1 = 1.0;
+    if (dir.y != 0.0) {
+        float tA = (-limit - posA.y)/dir.y;
+        float tB = ( limit - posA.y)/dir.y;
+        t0 = max(t0, min(tA, tB));
+        t1 = min(t1, max(tA, tB));
+    } else if (abs(posA.y) > limit) {
+        t1 = -1.0;
+    }
+    vec2 pos = mix(posA, posB, mix(t0, t1, TexCoord.z));
+    
+    float bin = clamp(floor((rgbL.w - 360.0)/(750.0 - 360.0)*SpectralPlanes*4.0), 0.0, SpectralPlanes*4.0 - 1.0);
+    float plane = floor(bin*0.25);
+    float channel = bin - plane*4.0;
+    
+    gl_Position = vec4(pos.x/Aspect, (plane + pos.y*0.5 + 0.5)/SpectralPlanes*2.0 - 1.0, 0.0, 1.0);
+    vColor = t1 > t0
+        ? vec4(equal(vec4(channel), vec4(0.0, 1.0, 2.0, 3.0)))*dot(rgbL.rgb, vec3(1.0))*biasCorrection
+        : vec4(0.0);
 }
@@ -0,0 +1,35 @@
+/* Access to the SceneData texture of the current scene, see
+   scene_data.h. Needs intersect.glsl, csg-intersect.glsl,
+   curve-intersect.glsl and polyline-intersect.glsl */
+
+uniform sampler2D SceneData;
+uniform vec2 SceneDataSize;
+/* First texel and length of the primitive list */
+uniform vec2 SceneList;
+/* The EAcceleratorType of the scene */
+uniform float SceneAccelerator;
+
+vec4 sceneTexel(float index) {
+    float y = floor(index/SceneDataSize.x);
+    float x = index - y*SceneDataSize.x;
+    return texture2D(SceneData, (vec2(x, y) + 0.5)/SceneDataSize);
+}
+
+void primitiveIntersect(Ray ray, float index, inout Intersection isect) {
+    vec4 a = sceneTexel(index);
+    vec4 b = sceneTexel(index + 1.0);
+    vec4 c = sceneTexel(index + 2.0);
+
+         if (a.x == 0.0) bboxIntersect(ray, a.zw, b.xy, a.y, isect);
+    else if (a.x == 1.0) sphereIntersect(ray, a.zw, b.z, a.y, isect);
+    else if (a.x == 2.0) lineIntersect(ray, a.zw, b.xy, a.y, isect);
+    else if (a.x == 3.0) prismIntersect(ray, a.zw, b.z, a.y, isect);
+    else if (a.x == 4.0) biconvexLensIntersect    (ray, a.zw, b.z, b.w, c.x, c.y, a.y, isect);
+    else if (a.x == 5.0) biconcaveLensIntersect   (ray, a.zw, b.z, b.w, c.x, c.y, a.y, isect);
+    else if (a.x == 6.0) meniscusLensIntersect    (ray, a.zw, b.z, b.w, c.x, c.y, a.y, isect);
+    else if (a.x == 7.0) planoConvexLensIntersect (ray, a.zw, b.z, b.w, c.x,      a.y, isect);
+    else if (a.x == 8.0) planoConcaveLensIntersect(ray, a.zw, b.z, b.w, c.x,      a.y, isect);
+    else if (a.x == 10.0) quadraticBezierIntersect(ray, a.zw, b.xy, b.zw,      a.y, isect);
+    else if (a.x == 11.0) cubicBezierIntersect    (ray, a.zw, b.xy, b.zw, c.xy, a.y, isect);
+    else if (a.x == 9.0) polylineIntersect(ray, b.z, a.y, isect);
+}
@@ -7,6 +7,7 @@
 uniform sampler2D PosData;
 uniform sampler2D RngData;
 uniform sampler2D RgbData;
+uniform sampler2D HeroData;
 
 varying vec2 vTexCoord;
 
@@ -23,9 +24,6 @@ struct Intersection {
     float mat;
 };
 
-void intersect(Ray ray, inout Intersection isect);
-vec2 sample(inout vec4 state, Intersection isect, float lambda, vec2 wiLocal, inout vec3 throughput);
-
 Ray unpackRay(vec4 posDir) {
     vec2 pos = posDir.xy;
     vec2 dir = posDir.zw;
@@ -34,23 +32,59 @@ Ray unpackRay(vec4 posDir) {
     return Ray(pos, normalize(dir), 1.0/dir, sign(dir));
 }
 
+#include </bsdf.glsl>
+#include </material-data.glsl>
+#include </intersect.glsl>
+#include </csg-intersect.glsl>
+#include </curve-intersect.glsl>
+#include </polyline-intersect.glsl>
+#include </scene-data.glsl>
+#include </bvh-intersect.glsl>
+#include </grid-intersect.glsl>
+#include </quadtree-intersect.glsl>
+
+/* Every scene, from the SceneData texture: the primitive list in order,
+   then the accelerator, if any */
+void intersect(Ray ray, inout Intersection isect) {
+    for (float i = 0.0; i < SceneList.y; i += 1.0)
+        primitiveIntersect(ray, SceneList.x + 3.0*i, isect);
+
+         if (SceneAccelerator == 1.0) bvhIntersect(ray, isect);
+    else if (SceneAccelerator == 2.0) gridIntersect(ray, isect);
+    else if (SceneAccelerator == 3.0) quadtreeIntersect(ray, isect);
+}
+
 void main() {
     vec4 posDir    = texture2D(PosData, vTexCoord);
     vec4 state     = texture2D(RngData, vTexCoord);
     vec4 rgbLambda = texture2D(RgbData, vTexCoord);
+    vec4 hero      = texture2D(HeroData, vTexCoord);
     
     Ray ray = unpackRay(posDir);
     Intersection isect;
     isect.tMin = 1e-4;
     isect.tMax = 1e30;
+    isect.mat = 0.0; /* Misses still sample(), from material 0 */
     intersect(ray, isect);
     
     vec2 t = vec2(-isect.n.y, isect.n.x);
     vec2 wiLocal = -vec2(dot(t, ray.dir), dot(isect.n, ray.dir));
-    vec2 woLocal = sample(state, isect, rgbLambda.w, wiLocal, rgbLambda.rgb);
+    
+    /* A path carrying four wavelengths (see init-frag) keeps only the hero
+       wavelength in rgbLambda.w from the first event that depends on it on */
+    if (hero.w != 0.0 && dispersive(isect)) {
+        rgbLambda.rgb = hero.rgb;
+        hero.w = 0.0;
+    }
+    
+    vec3 throughput = vec3(1.0);
+    vec2 woLocal = sample(state, isect, rgbLambda.w, wiLocal, throughput);
+    rgbLambda.rgb *= throughput;
+    hero.rgb *= throughput;
     
     if (isect.tMax == 1e30) {
         rgbLambda.rgb = vec3(0.0);
+        hero.rgb = vec3(0.0);
     } else {
         posDir.xy = ray.pos + ray.dir*isect.tMax;
         posDir.zw = woLocal.y*isect.n + woLocal.x*t;
@@ -59,4 +93,5 @@ void main() {
     gl_FragData[0] = posDir;
     gl_FragData[1] = state;
     gl_FragData[2] = rgbLambda;
+    gl_FragData[3] = hero;
 }
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "cpu_preamble.h"
+#include "cpu_rand.h"
+#include "emitter.h"
+#include "scene_data.h"
+
+/* Mirror of shaders/bsdf.glsl. tanh/atanh are renamed to stay clear of the
+   C library functions; they keep the GLSL formulations */
+
+inline float sellmeierIor(glm::vec3 b, glm::vec3 c, float lambda)
+{
+    float lSq = (lambda * 1e-3f) * (lambda * 1e-3f);
+    return 1.0f + glm::dot((b * lSq) / (lSq - c), glm::vec3(1.0f));
+}
+
+/* The filtered IorData fetch of material-data.glsl, from the IOR_SAMPLES
+   texels of one material */
+inline float tableIor(const float* table, float lambda)
+{
+    float x = (lambda - LAMBDA_MIN) / (LAMBDA_MAX - LAMBDA_MIN) *
+              (IOR_SAMPLES - 1);
+    x       = glm::clamp(x, 0.0f, float(IOR_SAMPLES - 1));
+    int   i = std::min(int(x), IOR_SAMPLES - 2);
+    float f = x - float(i);
+    return table[i] + (table[i + 1] - table[i]) * f;
+}
+
+inline float tanhSafe(float x)
+{
+    if (std::abs(x) > 10.0f) /* Prevent nasty overflow problems */
+        return glm::sign(x);
+    float e = std::exp(-2.0f * x);
+    return (1.0f - e) / (1.0f + e);
+}
+
+inline float atanhSafe(float x)
+{
+    return 0.5f * std::log((1.0f + x) / (1.0f - x));
+}
+
+inline float dielectricReflectance(float eta, float cosThetaI, float& cosThetaT)
+{
+    float sinThetaTSq = eta * eta * (1.0f - cosThetaI * cosThetaI);
+    if (sinThetaTSq > 1.0f)
+    {
+        cosThetaT = 0.0f;
+        return 1.0f;
+    }
+    cosThetaT = std::sqrt(1.0f - sinThetaTSq);
+
+    float Rs = (eta * cosThetaI - cosThetaT) / (eta * cosThetaI + cosThetaT);
+    float Rp = (eta * cosThetaT - cosThetaI) / (eta * cosThetaT + cosThetaI);
+
+    return (Rs * Rs + Rp * Rp) * 0.5f;
+}
+
+inline glm::vec2 sampleDiffuse(glm::vec4& state, glm::vec2 wi)
+{
+    float x = rand(state) * 2.0f - 1.0f;
+    float y = std::sqrt(1.0f - x * x);
+    return glm::vec2(x, y * glm::sign(wi.y));
+}
+
+inline glm::vec2 sampleMirror(glm::vec2 wi)
+{
+    return glm::vec2(-wi.x, wi.y);
+}
+
+inline glm::vec2 sampleDielectric(glm::vec4& state, glm::vec2 wi, float ior)
+{
+    float cosThetaT;
+    float eta = wi.y < 0.0f ? ior : 1.0f / ior;
+    float Fr  = dielectricReflectance(eta, std::abs(wi.y), cosThetaT);
+    if (rand(state) < Fr)
+        return glm::vec2(-wi.x, wi.y);
+    else
+        return glm::vec2(-wi.x * eta, -cosThetaT * glm::sign(wi.y));
+}
+
+inline float sampleVisibleNormal(float sigma,
+                                 float xi,
+                                 float theta0,
+                                 float theta1)
+{
+    float sigmaSq    = sigma * sigma;
+    float invSigmaSq = 1.0f / sigmaSq;
+
+    float cdf0 = tanhSafe(theta0 * 0.5f * invSigmaSq);
+    float cdf1 = tanhSafe(theta1 * 0.5f * invSigmaSq);
+
+    return 2.0f * sigmaSq * atanhSafe(cdf0 + (cdf1 - cdf0) * xi);
+}
+
+inline glm::vec2 sampleRoughMirror(glm::vec4& state,
+                                   glm::vec2  wi,
+                                   glm::vec3& throughput,
+                                   float      sigma)
+{
+    float theta  = std::asin(glm::clamp(wi.x, -1.0f, 1.0f));
+    float theta0 = glm::max(theta - PI_HALF, -PI_HALF);
+    float theta1 = glm::min(theta + PI_HALF, PI_HALF);
+
+    float thetaM = sampleVisibleNormal(sigma, rand(state), theta0, theta1);
+    glm::vec2 m  = glm::vec2(std::sin(thetaM), std::cos(thetaM));
+    glm::vec2 wo = m * (glm::dot(wi, m) * 2.0f) - wi;
+    if (wo.y < 0.0f) throughput = glm::vec3(0.0f);
+    return wo;
+}
+
+inline glm::vec2 sampleRoughDielectric(glm::vec4& state,
+                                       glm::vec2  wi,
+                                       float      sigma,
+                                       float      ior)
+{
+    float theta  = std::asin(glm::min(std::abs(wi.x), 1.0f));
+    float theta0 = glm::max(theta - PI_HALF, -PI_HALF);
+    float theta1 = glm::min(theta + PI_HALF, PI_HALF);
+
+    float thetaM = sampleVisibleNormal(sigma, rand(state), theta0, theta1);
+    glm::vec2 m  = glm::vec2(std::sin(thetaM), std::cos(thetaM));
+
+    float wiDotM = glm::dot(wi, m);
+
+    float cosThetaT;
+    float etaM = wiDotM < 0.0f ? ior : 1.0f / ior;
+    float F    = dielectricReflectance(etaM, std::abs(wiDotM), cosThetaT);
+    if (wiDotM < 0.0f) cosThetaT = -cosThetaT;
+
+    if (rand(state) < F)
+        return 2.0f * wiDotM * m - wi;
+    else
+        return (etaM * wiDotM - cosThetaT) * m - etaM * wi;
+}
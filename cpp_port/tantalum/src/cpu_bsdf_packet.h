@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "cpu_bsdf.h"
+#include "cpu_rand_packet.h"
+#include "cpu_simd.h"
+#include "scene_info.h"
+
+/* Packet versions of cpu_bsdf.h for V::SIZE rays that hit the same material.
+   The arithmetic runs on whole packets in the order of the scalar code, so
+   every lane gets the direction and throughput of its scalar call bit for
+   bit. asin, sin, cos and the tanh/atanh of the rough materials have no
+   exact SIMD counterpart and run lane by lane through the scalar functions */
+
+template <typename V>
+struct TDirectionPacket
+{
+    V x, y;
+};
+
+/* f applied to every lane of x */
+template <typename V, typename F>
+inline V mapLanes(V x, F f)
+{
+    alignas(64) float lanes[V::SIZE];
+    x.store(lanes);
+    for (int k = 0; k < V::SIZE; k++)
+    {
+        lanes[k] = f(lanes[k]);
+    }
+    return V::load(lanes);
+}
+
+/* glm::sign */
+template <typename V>
+inline V signPacket(V x)
+{
+    return select(x > V(0.0f), V(1.0f), V(0.0f)) -
+           select(x < V(0.0f), V(1.0f), V(0.0f));
+}
+
+/* tableIor() on the lambdas of a packet, all reading table */
+template <typename V>
+inline V tableIor(const float* table, V lambda)
+{
+    V x = (lambda - V(LAMBDA_MIN)) / V(LAMBDA_MAX - LAMBDA_MIN) *
+          V(float(IOR_SAMPLES - 1));
+    x   = min(max(x, V(0.0f)), V(float(IOR_SAMPLES - 1)));
+
+    /* x is not negative, so floor() is the truncation of int(x) */
+    V i = min(floor(x), V(float(IOR_SAMPLES - 2)));
+    V f = x - i;
+
+    alignas(64) float index[V::SIZE], lower[V::SIZE], upper[V::SIZE];
+    i.store(index);
+    for (int k = 0; k < V::SIZE; k++)
+    {
+        lower[k] = table[int(index[k])];
+        upper[k] = table[int(index[k]) + 1];
+    }
+    V a = V::load(lower);
+    return a + (V::load(upper) - a) * f;
+}
+
+template <typename V>
+inline V dielectricReflectance(V eta, V cosThetaI, V& cosThetaT)
+{
+    V    sinThetaTSq = eta * eta * (V(1.0f) - cosThetaI * cosThetaI);
+    auto total       = sinThetaTSq > V(1.0f);
+
+    /* Totally reflecting lanes take the square root of a negative number,
+       and are overwritten below */
+    cosThetaT = sqrt(V(1.0f) - sinThetaTSq);
+
+    V Rs = (eta * cosThetaI - cosThetaT) / (eta * cosThetaI + cosThetaT);
+    V Rp = (eta * cosThetaT - cosThetaI) / (eta * cosThetaT + cosThetaI);
+
+    cosThetaT = select(total, V(0.0f), cosThetaT);
+    return select(total, V(1.0f), (Rs * Rs + Rp * Rp) * V(0.5f));
+}
+
+template <typename V>
+inline TDirectionPacket<V> sampleDiffuse(V (&state)[4], V wiY)
+{
+    V x = rand(state) * V(2.0f) - V(1.0f);
+    V y = sqrt(V(1.0f) - x * x);
+    return {x, y * signPacket(wiY)};
+}
+
+template <typename V>
+inline TDirectionPacket<V> sampleMirror(V wiX, V wiY)
+{
+    return {-wiX, wiY};
+}
+
+template <typename V>
+inline TDirectionPacket<V> sampleDielectric(V (&state)[4],
+                                            V wiX,
+                                            V wiY,
+                                            V ior)
+{
+    V cosThetaT;
+    V eta = select(wiY < V(0.0f), ior, V(1.0f) / ior);
+    V Fr  = dielectricReflectance(eta, abs(wiY), cosThetaT);
+
+    auto reflect = rand(state) < Fr;
+    return {select(reflect, -wiX, -wiX * eta),
+            select(reflect, wiY, -cosThetaT * signPacket(wiY))};
+}
+
+/* sampleVisibleNormal() of each lane, with theta0 and theta1 computed from
+   the packet of theta */
+template <typename V>
+inline V sampleVisibleNormal(float sigma, V xi, V theta)
+{
+    V theta0 = max(theta - V(PI_HALF), V(-PI_HALF));
+    V theta1 = min(theta + V(PI_HALF), V(PI_HALF));
+
+    alignas(64) float lanes[3][V::SIZE];
+    xi.store(lanes[0]);
+    theta0.store(lanes[1]);
+    theta1.store(lanes[2]);
+    for (int k = 0; k < V::SIZE; k++)
+    {
+        lanes[0][k] =
+            sampleVisibleNormal(sigma, lanes[0][k], lanes[1][k], lanes[2][k]);
+    }
+    return V::load(lanes[0]);
+}
+
+template <typename V>
+inline TDirectionPacket<V> sampleRoughMirror(V (&state)[4],
+                                             V wiX,
+                                             V wiY,
+                                             V (&throughput)[3],
+                                             float sigma)
+{
+    V theta = mapLanes(min(max(wiX, V(-1.0f)), V(1.0f)),
+                       [](float x) { return std::asin(x); });
+
+    V thetaM = sampleVisibleNormal(sigma, rand(state), theta);
+    V mX     = mapLanes(thetaM, [](float x) { return std::sin(x); });
+    V mY     = mapLanes(thetaM, [](float x) { return std::cos(x); });
+    V d      = (wiX * mX + wiY * mY) * V(2.0f);
+    V woX    = mX * d - wiX;
+    V woY    = mY * d - wiY;
+
+    auto below = woY < V(0.0f);
+    for (int c = 0; c < 3; c++)
+    {
+        throughput[c] = select(below, V(0.0f), throughput[c]);
+    }
+    return {woX, woY};
+}
+
+template <typename V>
+inline TDirectionPacket<V> sampleRoughDielectric(V (&state)[4],
+                                                 V     wiX,
+                                                 V     wiY,
+                                                 float sigma,
+                                                 V     ior)
+{
+    V theta = mapLanes(min(abs(wiX), V(1.0f)),
+                       [](float x) { return std::asin(x); });
+
+    V thetaM = sampleVisibleNormal(sigma, rand(state), theta);
+    V mX     = mapLanes(thetaM, [](float x) { return std::sin(x); });
+    V mY     = mapLanes(thetaM, [](float x) { return std::cos(x); });
+
+    V wiDotM = wiX * mX + wiY * mY;
+
+    V    cosThetaT;
+    auto entering = wiDotM < V(0.0f);
+    V    etaM     = select(entering, ior, V(1.0f) / ior);
+    V    F = dielectricReflectance(etaM, abs(wiDotM), cosThetaT);
+    cosThetaT     = select(entering, -cosThetaT, cosThetaT);
+
+    auto reflect = rand(state) < F;
+    V    r       = V(2.0f) * wiDotM;
+    V    s       = etaM * wiDotM - cosThetaT;
+    return {select(reflect, r * mX - wiX, s * mX - etaM * wiX),
+            select(reflect, r * mY - wiY, s * mY - etaM * wiY)};
+}
+
+/* TCpuScene::sample() for a packet of rays that all hit material m, whose
+   IorData texels are iorTable if it is a dielectric */
+template <typename V>
+inline TDirectionPacket<V> sampleMaterial(const TSceneMaterial& m,
+                                          const float*          iorTable,
+                                          V (&state)[4],
+                                          V nX,
+                                          V lambda,
+                                          V wiX,
+                                          V wiY,
+                                          V (&throughput)[3])
+{
+    switch (m.type)
+    {
+        case EMaterialType::MIRROR:
+            return sampleMirror(wiX, wiY);
+        case EMaterialType::ROUGH_MIRROR:
+            return sampleRoughMirror(state, wiX, wiY, throughput, m.roughness);
+        case EMaterialType::DIELECTRIC:
+            return sampleDielectric(
+                state, wiX, wiY, tableIor(iorTable, lambda));
+        case EMaterialType::ROUGH_DIELECTRIC:
+            return sampleRoughDielectric(
+                state, wiX, wiY, m.roughness, tableIor(iorTable, lambda));
+        default:
+            for (int c = 0; c < 3; c++)
+            {
+                V albedo = V(m.albedo[c]);
+                if (m.faceAlbedo)
+                {
+                    albedo = select(nX == V(-1.0f),
+                                    V(m.leftAlbedo[c]),
+                                    select(nX == V(1.0f),
+                                           V(m.rightAlbedo[c]),
+                                           albedo));
+                }
+                throughput[c] = throughput[c] * albedo;
+            }
+            return sampleDiffuse(state, wiY);
+    }
+}
@@ -0,0 +1,18 @@
+#include <tuple>
+
+#include "cpu_static_scene.h"
+
+/* builtinStaticScenes[], written by tantalum_scenegen from scenes.list and
+   ending with a null entry */
+#include "cpu_builtin_scenes.inc"
+
+const TStaticSceneEntry* findStaticScene(uint64_t fingerprint)
+{
+    for (const TStaticSceneEntry* entry = builtinStaticScenes;
+         entry->intersect;
+         entry++)
+    {
+        if (entry->fingerprint == fingerprint) return entry;
+    }
+    return nullptr;
+}
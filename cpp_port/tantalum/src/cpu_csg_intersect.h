@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "cpu_intersect.h"
+
+/* Mirror of shaders/csg-intersect.glsl */
+
+struct Segment
+{
+    float     tNear, tFar;
+    glm::vec2 nNear, nFar;
+};
+
+inline Segment segmentIntersection(const Segment& a, const Segment& b)
+{
+    return Segment{glm::max(a.tNear, b.tNear),
+                   glm::min(a.tFar, b.tFar),
+                   (a.tNear > b.tNear) ? a.nNear : b.nNear,
+                   (a.tFar < b.tFar) ? a.nFar : b.nFar};
+}
+
+inline Segment segmentSubtraction(const Segment& a,
+                                  const Segment& b,
+                                  float          tMin)
+{
+    if (a.tNear >= a.tFar || b.tNear >= b.tFar || a.tFar <= b.tNear ||
+        a.tNear >= b.tFar)
+        return a;
+
+    Segment s1     = Segment{a.tNear, b.tNear, a.nNear, -b.nNear};
+    Segment s2     = Segment{b.tFar, a.tFar, -b.nFar, a.nFar};
+    bool    valid1 = s1.tNear <= s1.tFar;
+    bool    valid2 = s2.tNear <= s2.tFar;
+
+    if (valid1 && valid2)
+    {
+        if (s1.tFar >= tMin)
+            return s1;
+        else
+            return s2;
+    }
+    else
+    {
+        if (valid1)
+            return s1;
+        else
+            return s2;
+    }
+}
+
+inline void segmentCollapse(Segment segment, float matId, Intersection& isect)
+{
+    segment.tNear = glm::max(segment.tNear, isect.tMin);
+    segment.tFar  = glm::min(segment.tFar, isect.tMax);
+
+    if (segment.tNear <= segment.tFar)
+    {
+        if (segment.tNear > isect.tMin)
+        {
+            isect.tMax = segment.tNear;
+            isect.n    = segment.nNear;
+            isect.mat  = matId;
+        }
+        else if (segment.tFar < isect.tMax)
+        {
+            isect.tMax = segment.tFar;
+            isect.n    = segment.nFar;
+            isect.mat  = matId;
+        }
+    }
+}
+
+inline Segment horzSpanIntersect(const Ray& ray, float y, float radius)
+{
+    float dc = (y - ray.pos.y) * ray.invDir.y;
+    float dt = ray.dirSign.y * radius * ray.invDir.y;
+    return Segment{dc - dt,
+                   dc + dt,
+                   glm::vec2(0.0f, -ray.dirSign.y),
+                   glm::vec2(0.0f, ray.dirSign.y)};
+}
+
+inline Segment vertSpanIntersect(const Ray& ray, float x, float radius)
+{
+    float dc = (x - ray.pos.x) * ray.invDir.x;
+    float dt = ray.dirSign.x * radius * ray.invDir.x;
+    return Segment{dc - dt,
+                   dc + dt,
+                   glm::vec2(-ray.dirSign.x, 0.0f),
+                   glm::vec2(ray.dirSign.x, 0.0f)};
+}
+
+inline Segment boxSegmentIntersect(const Ray& ray,
+                                   glm::vec2  center,
+                                   glm::vec2  radius)
+{
+    return segmentIntersection(horzSpanIntersect(ray, center.y, radius.y),
+                               vertSpanIntersect(ray, center.x, radius.x));
+}
+
+inline Segment sphereSegmentIntersect(const Ray& ray,
+                                      glm::vec2  center,
+                                      float      radius)
+{
+    Segment result = {};
+
+    glm::vec2 p     = ray.pos - center;
+    float     B     = glm::dot(p, ray.dir);
+    float     C     = glm::dot(p, p) - radius * radius;
+    float     detSq = B * B - C;
+    if (detSq >= 0.0f)
+    {
+        float det    = std::sqrt(detSq);
+        result.tNear = -B - det;
+        result.tFar  = -B + det;
+        result.nNear = (p + ray.dir * result.tNear) * (1.0f / radius);
+        result.nFar  = (p + ray.dir * result.tFar) * (1.0f / radius);
+    }
+    else
+    {
+        result.tNear = 1e30f;
+        result.tFar  = -1e30f;
+    }
+
+    return result;
+}
+
+inline void biconvexLensIntersect(const Ray&    ray,
+                                  glm::vec2     center,
+                                  float         h,
+                                  float         d,
+                                  float         r1,
+                                  float         r2,
+                                  float         matId,
+                                  Intersection& isect)
+{
+    segmentCollapse(
+        segmentIntersection(
+            segmentIntersection(
+                horzSpanIntersect(ray, center.y, h),
+                sphereSegmentIntersect(
+                    ray, center + glm::vec2(r1 - d, 0.0f), r1)),
+            sphereSegmentIntersect(ray, center - glm::vec2(r2 - d, 0.0f), r2)),
+        matId,
+        isect);
+}
+
+inline void biconcaveLensIntersect(const Ray&    ray,
+                                   glm::vec2     center,
+                                   float         h,
+                                   float         d,
+                                   float         r1,
+                                   float         r2,
+                                   float         matId,
+                                   Intersection& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentSubtraction(
+                segmentIntersection(
+                    horzSpanIntersect(ray, center.y, h),
+                    vertSpanIntersect(ray,
+                                      center.x + 0.5f * (r2 - r1),
+                                      0.5f * (std::abs(r1) + std::abs(r2)) +
+                                          d)),
+                sphereSegmentIntersect(
+                    ray, center + glm::vec2(r2 + d, 0.0f), r2),
+                isect.tMin),
+            sphereSegmentIntersect(ray, center - glm::vec2(r1 + d, 0.0f), r1),
+            isect.tMin),
+        matId,
+        isect);
+}
+
+inline void meniscusLensIntersect(const Ray&    ray,
+                                  glm::vec2     center,
+                                  float         h,
+                                  float         d,
+                                  float         r1,
+                                  float         r2,
+                                  float         matId,
+                                  Intersection& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentIntersection(
+                segmentIntersection(
+                    horzSpanIntersect(ray, center.y, h),
+                    vertSpanIntersect(
+                        ray, center.x + 0.5f * r2, 0.5f * std::abs(r2) + d)),
+                sphereSegmentIntersect(
+                    ray,
+                    center + glm::vec2(r1 - glm::sign(r1) * d, 0.0f),
+                    std::abs(r1))),
+            sphereSegmentIntersect(
+                ray,
+                center + glm::vec2(r2 + glm::sign(r2) * d, 0.0f),
+                std::abs(r2)),
+            isect.tMin),
+        matId,
+        isect);
+}
+
+inline void planoConvexLensIntersect(const Ray&    ray,
+                                     glm::vec2     center,
+                                     float         h,
+                                     float         d,
+                                     float         r,
+                                     float         matId,
+                                     Intersection& isect)
+{
+    segmentCollapse(
+        segmentIntersection(
+            boxSegmentIntersect(ray, center, glm::vec2(d, h)),
+            sphereSegmentIntersect(
+                ray, center + glm::vec2(r - d, 0.0f), std::abs(r))),
+        matId,
+        isect);
+}
+
+inline void planoConcaveLensIntersect(const Ray&    ray,
+                                      glm::vec2     center,
+                                      float         h,
+                                      float         d,
+                                      float         r,
+                                      float         matId,
+                                      Intersection& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentIntersection(
+                horzSpanIntersect(ray, center.y, h),
+                vertSpanIntersect(
+                    ray, center.x - 0.5f * r, 0.5f * std::abs(r) + d)),
+            sphereSegmentIntersect(
+                ray, center - glm::vec2(r + d, 0.0f), std::abs(r)),
+            isect.tMin),
+        matId,
+        isect);
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "cpu_csg_intersect.h"
+#include "cpu_intersect_packet.h"
+
+/* Packet versions of cpu_csg_intersect.h. The branches of the scalar segment
+   algebra become lane selects, evaluated in the same order on the same
+   operands, so each lane reproduces the scalar Segment and Intersection
+   exactly */
+
+template <typename V>
+struct TSegmentPacket
+{
+    V tNear, tFar;
+    V nNearX, nNearY;
+    V nFarX, nFarY;
+};
+
+template <typename V, typename M>
+inline TSegmentPacket<V> select(M                        mask,
+                                const TSegmentPacket<V>& a,
+                                const TSegmentPacket<V>& b)
+{
+    return TSegmentPacket<V>{select(mask, a.tNear, b.tNear),
+                             select(mask, a.tFar, b.tFar),
+                             select(mask, a.nNearX, b.nNearX),
+                             select(mask, a.nNearY, b.nNearY),
+                             select(mask, a.nFarX, b.nFarX),
+                             select(mask, a.nFarY, b.nFarY)};
+}
+
+template <typename V>
+inline TSegmentPacket<V> segmentIntersection(const TSegmentPacket<V>& a,
+                                             const TSegmentPacket<V>& b)
+{
+    auto nearA = a.tNear > b.tNear;
+    auto farA  = a.tFar < b.tFar;
+    return TSegmentPacket<V>{max(a.tNear, b.tNear),
+                             min(a.tFar, b.tFar),
+                             select(nearA, a.nNearX, b.nNearX),
+                             select(nearA, a.nNearY, b.nNearY),
+                             select(farA, a.nFarX, b.nFarX),
+                             select(farA, a.nFarY, b.nFarY)};
+}
+
+template <typename V>
+inline TSegmentPacket<V> segmentSubtraction(const TSegmentPacket<V>& a,
+                                            const TSegmentPacket<V>& b,
+                                            V                        tMin)
+{
+    auto disjoint = (a.tNear >= a.tFar) | (b.tNear >= b.tFar) |
+                    (a.tFar <= b.tNear) | (a.tNear >= b.tFar);
+
+    TSegmentPacket<V> s1 = {a.tNear, b.tNear, a.nNearX, a.nNearY, -b.nNearX,
+                            -b.nNearY};
+    TSegmentPacket<V> s2 = {b.tFar, a.tFar, -b.nFarX, -b.nFarY, a.nFarX,
+                            a.nFarY};
+
+    auto valid1 = s1.tNear <= s1.tFar;
+    auto valid2 = s2.tNear <= s2.tFar;
+
+    /* s1 when both are valid and s1 ends past tMin, or when only s1 is */
+    auto useS1 = valid1 & (~valid2 | (s1.tFar >= tMin));
+
+    return select(disjoint, a, select(useS1, s1, s2));
+}
+
+template <typename V>
+inline void segmentCollapse(const TSegmentPacket<V>& segment,
+                            float                    matId,
+                            TIntersectionPacket<V>&  isect)
+{
+    V tNear = max(segment.tNear, isect.tMin);
+    V tFar  = min(segment.tFar, isect.tMax);
+
+    auto overlap = tNear <= tFar;
+    auto hitNear = overlap & (tNear > isect.tMin);
+    auto hitFar  = andNot(overlap & (tFar < isect.tMax), hitNear);
+    auto hit     = hitNear | hitFar;
+    if (none(hit)) return;
+
+    isect.tMax = select(hitNear, tNear, select(hitFar, tFar, isect.tMax));
+    isect.nX   = select(
+        hitNear, segment.nNearX, select(hitFar, segment.nFarX, isect.nX));
+    isect.nY = select(
+        hitNear, segment.nNearY, select(hitFar, segment.nFarY, isect.nY));
+    isect.mat = select(hit, V(matId), isect.mat);
+}
+
+template <typename V>
+inline TSegmentPacket<V> horzSpanIntersect(const TRayPacket<V>& ray,
+                                           float                y,
+                                           float                radius)
+{
+    V dc = (V(y) - ray.posY) * ray.invDirY;
+    V dt = ray.dirSignY * V(radius) * ray.invDirY;
+    return TSegmentPacket<V>{
+        dc - dt, dc + dt, V(0.0f), -ray.dirSignY, V(0.0f), ray.dirSignY};
+}
+
+template <typename V>
+inline TSegmentPacket<V> vertSpanIntersect(const TRayPacket<V>& ray,
+                                           float                x,
+                                           float                radius)
+{
+    V dc = (V(x) - ray.posX) * ray.invDirX;
+    V dt = ray.dirSignX * V(radius) * ray.invDirX;
+    return TSegmentPacket<V>{
+        dc - dt, dc + dt, -ray.dirSignX, V(0.0f), ray.dirSignX, V(0.0f)};
+}
+
+template <typename V>
+inline TSegmentPacket<V> boxSegmentIntersect(const TRayPacket<V>& ray,
+                                             glm::vec2            center,
+                                             glm::vec2            radius)
+{
+    return segmentIntersection(horzSpanIntersect(ray, center.y, radius.y),
+                               vertSpanIntersect(ray, center.x, radius.x));
+}
+
+template <typename V>
+inline TSegmentPacket<V> sphereSegmentIntersect(const TRayPacket<V>& ray,
+                                                glm::vec2            center,
+                                                float                radius)
+{
+    V pX    = ray.posX - V(center.x);
+    V pY    = ray.posY - V(center.y);
+    V B     = pX * ray.dirX + pY * ray.dirY;
+    V C     = (pX * pX + pY * pY) - V(radius * radius);
+    V detSq = B * B - C;
+
+    auto valid = detSq >= V(0.0f);
+
+    /* Misses keep the zero normals of the scalar code's Segment result = {} */
+    V det       = sqrt(detSq);
+    V tNear     = -B - det;
+    V tFar      = -B + det;
+    V invRadius = V(1.0f / radius);
+
+    TSegmentPacket<V> result;
+    result.tNear  = select(valid, tNear, V(1e30f));
+    result.tFar   = select(valid, tFar, V(-1e30f));
+    result.nNearX = select(valid, (pX + ray.dirX * tNear) * invRadius, V(0.0f));
+    result.nNearY = select(valid, (pY + ray.dirY * tNear) * invRadius, V(0.0f));
+    result.nFarX  = select(valid, (pX + ray.dirX * tFar) * invRadius, V(0.0f));
+    result.nFarY  = select(valid, (pY + ray.dirY * tFar) * invRadius, V(0.0f));
+    return result;
+}
+
+template <typename V>
+inline void biconvexLensIntersect(const TRayPacket<V>&    ray,
+                                  glm::vec2               center,
+                                  float                   h,
+                                  float                   d,
+                                  float                   r1,
+                                  float                   r2,
+                                  float                   matId,
+                                  TIntersectionPacket<V>& isect)
+{
+    segmentCollapse(
+        segmentIntersection(
+            segmentIntersection(
+                horzSpanIntersect(ray, center.y, h),
+                sphereSegmentIntersect(
+                    ray, center + glm::vec2(r1 - d, 0.0f), r1)),
+            sphereSegmentIntersect(ray, center - glm::vec2(r2 - d, 0.0f), r2)),
+        matId,
+        isect);
+}
+
+template <typename V>
+inline void biconcaveLensIntersect(const TRayPacket<V>&    ray,
+                                   glm::vec2               center,
+                                   float                   h,
+                                   float                   d,
+                                   float                   r1,
+                                   float                   r2,
+                                   float                   matId,
+                                   TIntersectionPacket<V>& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentSubtraction(
+                segmentIntersection(
+                    horzSpanIntersect(ray, center.y, h),
+                    vertSpanIntersect(ray,
+                                      center.x + 0.5f * (r2 - r1),
+                                      0.5f * (std::abs(r1) + std::abs(r2)) +
+                                          d)),
+                sphereSegmentIntersect(
+                    ray, center + glm::vec2(r2 + d, 0.0f), r2),
+                isect.tMin),
+            sphereSegmentIntersect(ray, center - glm::vec2(r1 + d, 0.0f), r1),
+            isect.tMin),
+        matId,
+        isect);
+}
+
+template <typename V>
+inline void meniscusLensIntersect(const TRayPacket<V>&    ray,
+                                  glm::vec2               center,
+                                  float                   h,
+                                  float                   d,
+                                  float                   r1,
+                                  float                   r2,
+                                  float                   matId,
+                                  TIntersectionPacket<V>& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentIntersection(
+                segmentIntersection(
+                    horzSpanIntersect(ray, center.y, h),
+                    vertSpanIntersect(
+                        ray, center.x + 0.5f * r2, 0.5f * std::abs(r2) + d)),
+                sphereSegmentIntersect(
+                    ray,
+                    center + glm::vec2(r1 - glm::sign(r1) * d, 0.0f),
+                    std::abs(r1))),
+            sphereSegmentIntersect(
+                ray,
+                center + glm::vec2(r2 + glm::sign(r2) * d, 0.0f),
+                std::abs(r2)),
+            isect.tMin),
+        matId,
+        isect);
+}
+
+template <typename V>
+inline void planoConvexLensIntersect(const TRayPacket<V>&    ray,
+                                     glm::vec2               center,
+                                     float                   h,
+                                     float                   d,
+                                     float                   r,
+                                     float                   matId,
+                                     TIntersectionPacket<V>& isect)
+{
+    segmentCollapse(
+        segmentIntersection(
+            boxSegmentIntersect(ray, center, glm::vec2(d, h)),
+            sphereSegmentIntersect(
+                ray, center + glm::vec2(r - d, 0.0f), std::abs(r))),
+        matId,
+        isect);
+}
+
+template <typename V>
+inline void planoConcaveLensIntersect(const TRayPacket<V>&    ray,
+                                      glm::vec2               center,
+                                      float                   h,
+                                      float                   d,
+                                      float                   r,
+                                      float                   matId,
+                                      TIntersectionPacket<V>& isect)
+{
+    segmentCollapse(
+        segmentSubtraction(
+            segmentIntersection(
+                horzSpanIntersect(ray, center.y, h),
+                vertSpanIntersect(
+                    ray, center.x - 0.5f * r, 0.5f * std::abs(r) + d)),
+            sphereSegmentIntersect(
+                ray, center - glm::vec2(r + d, 0.0f), std::abs(r)),
+            isect.tMin),
+        matId,
+        isect);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "cpu_intersect.h"
+
+/* Mirror of shaders/curve-intersect.glsl */
+
+constexpr int CUBIC_ITERATIONS = 16;
+
+inline glm::vec2 bezierLerp(glm::vec2 a, glm::vec2 b, float u)
+{
+    return a + (b - a) * u;
+}
+
+inline void bezierHit(const Ray&    ray,
+                      float         u,
+                      glm::vec2     point,
+                      glm::vec2     tangent,
+                      float         matId,
+                      Intersection& isect)
+{
+    float t = glm::dot(point - ray.pos, ray.dir);
+    if (u < 0.0f || u > 1.0f || t <= isect.tMin || t >= isect.tMax) return;
+
+    isect.tMax = t;
+    isect.n    = glm::normalize(glm::vec2(-tangent.y, tangent.x));
+    isect.mat  = matId;
+}
+
+inline void quadraticBezierHit(const Ray&    ray,
+                               glm::vec2     p0,
+                               glm::vec2     p1,
+                               glm::vec2     p2,
+                               float         u,
+                               float         matId,
+                               Intersection& isect)
+{
+    glm::vec2 q0      = bezierLerp(p0, p1, u);
+    glm::vec2 q1      = bezierLerp(p1, p2, u);
+    glm::vec2 tangent = q1 - q0;
+    if (tangent.x == 0.0f && tangent.y == 0.0f) tangent = p2 - p0;
+    bezierHit(ray, u, bezierLerp(q0, q1, u), tangent, matId, isect);
+}
+
+inline void cubicBezierHit(const Ray&    ray,
+                           glm::vec2     p0,
+                           glm::vec2     p1,
+                           glm::vec2     p2,
+                           glm::vec2     p3,
+                           float         u,
+                           float         matId,
+                           Intersection& isect)
+{
+    glm::vec2 q0      = bezierLerp(p0, p1, u);
+    glm::vec2 q1      = bezierLerp(p1, p2, u);
+    glm::vec2 q2      = bezierLerp(p2, p3, u);
+    glm::vec2 r0      = bezierLerp(q0, q1, u);
+    glm::vec2 r1      = bezierLerp(q1, q2, u);
+    glm::vec2 tangent = r1 - r0;
+    if (tangent.x == 0.0f && tangent.y == 0.0f) tangent = p3 - p0;
+    bezierHit(ray, u, bezierLerp(r0, r1, u), tangent, matId, isect);
+}
+
+inline float cubicRoot(glm::vec4 c, float lo, float hi)
+{
+    float dLo = ((c.w * lo + c.z) * lo + c.y) * lo + c.x;
+    float dHi = ((c.w * hi + c.z) * hi + c.y) * hi + c.x;
+    if (glm::min(dLo, dHi) > 0.0f || glm::max(dLo, dHi) < 0.0f) return -1.0f;
+
+    float u = dLo != dHi ? lo + (hi - lo) * (dLo / (dLo - dHi)) : lo;
+    for (int i = 0; i < CUBIC_ITERATIONS; i++)
+    {
+        float d     = ((c.w * u + c.z) * u + c.y) * u + c.x;
+        float slope = (3.0f * c.w * u + 2.0f * c.z) * u + c.y;
+        if ((d < 0.0f) == (dLo < 0.0f))
+            lo = u;
+        else
+            hi = u;
+
+        float next = slope != 0.0f ? u - d / slope : lo - 1.0f;
+        u          = next >= lo && next <= hi ? next : 0.5f * (lo + hi);
+    }
+    return u;
+}
+
+inline void quadraticBezierIntersect(const Ray&    ray,
+                                     glm::vec2     p0,
+                                     glm::vec2     p1,
+                                     glm::vec2     p2,
+                                     float         matId,
+                                     Intersection& isect)
+{
+    glm::vec2 n  = glm::vec2(-ray.dir.y, ray.dir.x);
+    float     d0 = glm::dot(n, p0 - ray.pos);
+    float     d1 = glm::dot(n, p1 - ray.pos);
+    float     d2 = glm::dot(n, p2 - ray.pos);
+    float     s0 = glm::dot(ray.dir, p0 - ray.pos);
+    float     s1 = glm::dot(ray.dir, p1 - ray.pos);
+    float     s2 = glm::dot(ray.dir, p2 - ray.pos);
+    if (glm::min(glm::min(d0, d1), d2) > 0.0f ||
+        glm::max(glm::max(d0, d1), d2) < 0.0f ||
+        glm::max(glm::max(s0, s1), s2) <= isect.tMin ||
+        glm::min(glm::min(s0, s1), s2) >= isect.tMax)
+        return;
+
+    float a    = d0 - 2.0f * d1 + d2;
+    float b    = 2.0f * (d1 - d0);
+    float c    = d0;
+    float disc = b * b - 4.0f * a * c;
+    if (disc < 0.0f) return;
+
+    float root = std::sqrt(disc);
+    float q    = -0.5f * (b + (b >= 0.0f ? root : -root));
+    float u1   = a != 0.0f ? q / a : -1.0f;
+    float u2   = q != 0.0f ? c / q : -1.0f;
+    quadraticBezierHit(ray, p0, p1, p2, u1, matId, isect);
+    quadraticBezierHit(ray, p0, p1, p2, u2, matId, isect);
+}
+
+inline void cubicBezierIntersect(const Ray&    ray,
+                                 glm::vec2     p0,
+                                 glm::vec2     p1,
+                                 glm::vec2     p2,
+                                 glm::vec2     p3,
+                                 float         matId,
+                                 Intersection& isect)
+{
+    glm::vec2 n  = glm::vec2(-ray.dir.y, ray.dir.x);
+    float     d0 = glm::dot(n, p0 - ray.pos);
+    float     d1 = glm::dot(n, p1 - ray.pos);
+    float     d2 = glm::dot(n, p2 - ray.pos);
+    float     d3 = glm::dot(n, p3 - ray.pos);
+    float     s0 = glm::dot(ray.dir, p0 - ray.pos);
+    float     s1 = glm::dot(ray.dir, p1 - ray.pos);
+    float     s2 = glm::dot(ray.dir, p2 - ray.pos);
+    float     s3 = glm::dot(ray.dir, p3 - ray.pos);
+    if (glm::min(glm::min(d0, d1), glm::min(d2, d3)) > 0.0f ||
+        glm::max(glm::max(d0, d1), glm::max(d2, d3)) < 0.0f ||
+        glm::max(glm::max(s0, s1), glm::max(s2, s3)) <= isect.tMin ||
+        glm::min(glm::min(s0, s1), glm::min(s2, s3)) >= isect.tMax)
+        return;
+
+    glm::vec4 coeffs = glm::vec4(d0,
+                                 3.0f * (d1 - d0),
+                                 3.0f * (d0 - 2.0f * d1 + d2),
+                                 d3 - d0 + 3.0f * (d1 - d2));
+    float     a      = 3.0f * coeffs.w;
+    float     b      = 2.0f * coeffs.z;
+    float     c      = coeffs.y;
+    float     disc   = b * b - 4.0f * a * c;
+    float     e1 = 1.0f, e2 = 1.0f;
+    if (disc >= 0.0f)
+    {
+        float root = std::sqrt(disc);
+        float q    = -0.5f * (b + (b >= 0.0f ? root : -root));
+        float r1   = a != 0.0f ? q / a : 1.0f;
+        float r2   = q != 0.0f ? c / q : 1.0f;
+        r1         = r1 > 0.0f && r1 < 1.0f ? r1 : 1.0f;
+        r2         = r2 > 0.0f && r2 < 1.0f ? r2 : 1.0f;
+        e1         = glm::min(r1, r2);
+        e2         = glm::max(r1, r2);
+    }
+
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, cubicRoot(coeffs, 0.0f, e1), matId, isect);
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, cubicRoot(coeffs, e1, e2), matId, isect);
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, cubicRoot(coeffs, e2, 1.0f), matId, isect);
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "cpu_curve_intersect.h"
+#include "cpu_intersect_packet.h"
+
+/* Packet versions of cpu_curve_intersect.h. The root solves run their fixed
+   iteration counts on every lane with the branches as lane selects, and
+   lanes without roots get u = -1 like the scalar code, so each lane
+   reproduces the scalar Intersection exactly */
+
+template <typename V>
+inline V bezierLerp(V a, V b, V u)
+{
+    return a + (b - a) * u;
+}
+
+template <typename V>
+inline void bezierHit(const TRayPacket<V>&    ray,
+                      V                       u,
+                      V                       pointX,
+                      V                       pointY,
+                      V                       tangentX,
+                      V                       tangentY,
+                      float                   matId,
+                      TIntersectionPacket<V>& isect)
+{
+    V t = (pointX - ray.posX) * ray.dirX + (pointY - ray.posY) * ray.dirY;
+
+    auto hit = (u >= V(0.0f)) & (u <= V(1.0f)) & (t > isect.tMin) &
+               (t < isect.tMax);
+    if (none(hit)) return;
+
+    V nX        = -tangentY;
+    V nY        = tangentX;
+    V invLength = V(1.0f) / sqrt(nX * nX + nY * nY);
+
+    isect.tMax = select(hit, t, isect.tMax);
+    isect.nX   = select(hit, nX * invLength, isect.nX);
+    isect.nY   = select(hit, nY * invLength, isect.nY);
+    isect.mat  = select(hit, V(matId), isect.mat);
+}
+
+template <typename V>
+inline void quadraticBezierHit(const TRayPacket<V>&    ray,
+                               glm::vec2               p0,
+                               glm::vec2               p1,
+                               glm::vec2               p2,
+                               V                       u,
+                               float                   matId,
+                               TIntersectionPacket<V>& isect)
+{
+    V q0X = bezierLerp(V(p0.x), V(p1.x), u);
+    V q0Y = bezierLerp(V(p0.y), V(p1.y), u);
+    V q1X = bezierLerp(V(p1.x), V(p2.x), u);
+    V q1Y = bezierLerp(V(p1.y), V(p2.y), u);
+    V tX  = q1X - q0X;
+    V tY  = q1Y - q0Y;
+
+    auto zero = (tX == V(0.0f)) & (tY == V(0.0f));
+    tX        = select(zero, V(p2.x - p0.x), tX);
+    tY        = select(zero, V(p2.y - p0.y), tY);
+    bezierHit(ray,
+              u,
+              bezierLerp(q0X, q1X, u),
+              bezierLerp(q0Y, q1Y, u),
+              tX,
+              tY,
+              matId,
+              isect);
+}
+
+template <typename V>
+inline void cubicBezierHit(const TRayPacket<V>&    ray,
+                           glm::vec2               p0,
+                           glm::vec2               p1,
+                           glm::vec2               p2,
+                           glm::vec2               p3,
+                           V                       u,
+                           float                   matId,
+                           TIntersectionPacket<V>& isect)
+{
+    V q0X = bezierLerp(V(p0.x), V(p1.x), u);
+    V q0Y = bezierLerp(V(p0.y), V(p1.y), u);
+    V q1X = bezierLerp(V(p1.x), V(p2.x), u);
+    V q1Y = bezierLerp(V(p1.y), V(p2.y), u);
+    V q2X = bezierLerp(V(p2.x), V(p3.x), u);
+    V q2Y = bezierLerp(V(p2.y), V(p3.y), u);
+    V r0X = bezierLerp(q0X, q1X, u);
+    V r0Y = bezierLerp(q0Y, q1Y, u);
+    V r1X = bezierLerp(q1X, q2X, u);
+    V r1Y = bezierLerp(q1Y, q2Y, u);
+    V tX  = r1X - r0X;
+    V tY  = r1Y - r0Y;
+
+    auto zero = (tX == V(0.0f)) & (tY == V(0.0f));
+    tX        = select(zero, V(p3.x - p0.x), tX);
+    tY        = select(zero, V(p3.y - p0.y), tY);
+    bezierHit(ray,
+              u,
+              bezierLerp(r0X, r1X, u),
+              bezierLerp(r0Y, r1Y, u),
+              tX,
+              tY,
+              matId,
+              isect);
+}
+
+template <typename V>
+inline V cubicRoot(V c0, V c1, V c2, V c3, V lo, V hi)
+{
+    V dLo = ((c3 * lo + c2) * lo + c1) * lo + c0;
+    V dHi = ((c3 * hi + c2) * hi + c1) * hi + c0;
+
+    auto noRoot = (min(dLo, dHi) > V(0.0f)) | (max(dLo, dHi) < V(0.0f));
+    auto negLo  = dLo < V(0.0f);
+
+    V u = select(dLo != dHi, lo + (hi - lo) * (dLo / (dLo - dHi)), lo);
+    for (int i = 0; i < CUBIC_ITERATIONS; i++)
+    {
+        V d     = ((c3 * u + c2) * u + c1) * u + c0;
+        V slope = (V(3.0f) * c3 * u + V(2.0f) * c2) * u + c1;
+
+        auto neg  = d < V(0.0f);
+        auto same = (neg & negLo) | ~(neg | negLo);
+        lo        = select(same, u, lo);
+        hi        = select(same, hi, u);
+
+        V next = select(slope != V(0.0f), u - d / slope, lo - V(1.0f));
+        u      = select((next >= lo) & (next <= hi), next, V(0.5f) * (lo + hi));
+    }
+    return select(noRoot, V(-1.0f), u);
+}
+
+template <typename V>
+inline void quadraticBezierIntersect(const TRayPacket<V>&    ray,
+                                     glm::vec2               p0,
+                                     glm::vec2               p1,
+                                     glm::vec2               p2,
+                                     float                   matId,
+                                     TIntersectionPacket<V>& isect)
+{
+    V nX  = -ray.dirY;
+    V nY  = ray.dirX;
+    V p0X = V(p0.x) - ray.posX, p0Y = V(p0.y) - ray.posY;
+    V p1X = V(p1.x) - ray.posX, p1Y = V(p1.y) - ray.posY;
+    V p2X = V(p2.x) - ray.posX, p2Y = V(p2.y) - ray.posY;
+    V d0  = nX * p0X + nY * p0Y;
+    V d1  = nX * p1X + nY * p1Y;
+    V d2  = nX * p2X + nY * p2Y;
+    V s0  = ray.dirX * p0X + ray.dirY * p0Y;
+    V s1  = ray.dirX * p1X + ray.dirY * p1Y;
+    V s2  = ray.dirX * p2X + ray.dirY * p2Y;
+
+    auto live = ~((min(min(d0, d1), d2) > V(0.0f)) |
+                  (max(max(d0, d1), d2) < V(0.0f)) |
+                  (max(max(s0, s1), s2) <= isect.tMin) |
+                  (min(min(s0, s1), s2) >= isect.tMax));
+    if (none(live)) return;
+
+    V a    = d0 - V(2.0f) * d1 + d2;
+    V b    = V(2.0f) * (d1 - d0);
+    V c    = d0;
+    V disc = b * b - V(4.0f) * a * c;
+    live   = live & (disc >= V(0.0f));
+    if (none(live)) return;
+
+    /* Lanes with disc < 0 produce NaNs here, but get u = -1 below */
+    V root = sqrt(disc);
+    V q    = V(-0.5f) * (b + select(b >= V(0.0f), root, -root));
+    V u1   = select(a != V(0.0f), q / a, V(-1.0f));
+    V u2   = select(q != V(0.0f), c / q, V(-1.0f));
+    quadraticBezierHit(
+        ray, p0, p1, p2, select(live, u1, V(-1.0f)), matId, isect);
+    quadraticBezierHit(
+        ray, p0, p1, p2, select(live, u2, V(-1.0f)), matId, isect);
+}
+
+template <typename V>
+inline void cubicBezierIntersect(const TRayPacket<V>&    ray,
+                                 glm::vec2               p0,
+                                 glm::vec2               p1,
+                                 glm::vec2               p2,
+                                 glm::vec2               p3,
+                                 float                   matId,
+                                 TIntersectionPacket<V>& isect)
+{
+    V nX  = -ray.dirY;
+    V nY  = ray.dirX;
+    V p0X = V(p0.x) - ray.posX, p0Y = V(p0.y) - ray.posY;
+    V p1X = V(p1.x) - ray.posX, p1Y = V(p1.y) - ray.posY;
+    V p2X = V(p2.x) - ray.posX, p2Y = V(p2.y) - ray.posY;
+    V p3X = V(p3.x) - ray.posX, p3Y = V(p3.y) - ray.posY;
+    V d0  = nX * p0X + nY * p0Y;
+    V d1  = nX * p1X + nY * p1Y;
+    V d2  = nX * p2X + nY * p2Y;
+    V d3  = nX * p3X + nY * p3Y;
+    V s0  = ray.dirX * p0X + ray.dirY * p0Y;
+    V s1  = ray.dirX * p1X + ray.dirY * p1Y;
+    V s2  = ray.dirX * p2X + ray.dirY * p2Y;
+    V s3  = ray.dirX * p3X + ray.dirY * p3Y;
+
+    auto live = ~((min(min(d0, d1), min(d2, d3)) > V(0.0f)) |
+                  (max(max(d0, d1), max(d2, d3)) < V(0.0f)) |
+                  (max(max(s0, s1), max(s2, s3)) <= isect.tMin) |
+                  (min(min(s0, s1), min(s2, s3)) >= isect.tMax));
+    if (none(live)) return;
+
+    V c0   = d0;
+    V c1   = V(3.0f) * (d1 - d0);
+    V c2   = V(3.0f) * (d0 - V(2.0f) * d1 + d2);
+    V c3   = d3 - d0 + V(3.0f) * (d1 - d2);
+    V a    = V(3.0f) * c3;
+    V b    = V(2.0f) * c2;
+    V c    = c1;
+    V disc = b * b - V(4.0f) * a * c;
+
+    /* Lanes with disc < 0 produce NaNs here, but keep e1 = e2 = 1 */
+    V root = sqrt(disc);
+    V q    = V(-0.5f) * (b + select(b >= V(0.0f), root, -root));
+    V r1   = select(a != V(0.0f), q / a, V(1.0f));
+    V r2   = select(q != V(0.0f), c / q, V(1.0f));
+    r1     = select((r1 > V(0.0f)) & (r1 < V(1.0f)), r1, V(1.0f));
+    r2     = select((r2 > V(0.0f)) & (r2 < V(1.0f)), r2, V(1.0f));
+
+    auto extrema = disc >= V(0.0f);
+    V    e1      = select(extrema, min(r1, r2), V(1.0f));
+    V    e2      = select(extrema, max(r1, r2), V(1.0f));
+
+    V u1 = cubicRoot(c0, c1, c2, c3, V(0.0f), e1);
+    V u2 = cubicRoot(c0, c1, c2, c3, e1, e2);
+    V u3 = cubicRoot(c0, c1, c2, c3, e2, V(1.0f));
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, select(live, u1, V(-1.0f)), matId, isect);
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, select(live, u2, V(-1.0f)), matId, isect);
+    cubicBezierHit(
+        ray, p0, p1, p2, p3, select(live, u3, V(-1.0f)), matId, isect);
+}
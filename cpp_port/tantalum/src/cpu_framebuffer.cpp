@@ -0,0 +1,90 @@
+#include "cpu_framebuffer.h"
+
+#include <algorithm>
+
+void TCpuFramebuffer::resize(int width, int height, int planes)
+{
+    this->width  = width;
+    this->height = height;
+    this->planes = planes;
+    this->tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    this->tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    this->pixels.assign(width * height * 4 * planes, 0.0f);
+    this->dirty.assign(this->tilesX * this->tilesY, 0);
+}
+
+void TCpuFramebuffer::clear()
+{
+    std::fill(this->pixels.begin(), this->pixels.end(), 0.0f);
+    std::fill(this->dirty.begin(), this->dirty.end(), 0);
+}
+
+void TCpuFramebuffer::tileBounds(
+    int tile, int& x0, int& y0, int& x1, int& y1) const
+{
+    x0 = (tile % this->tilesX) * TILE_SIZE;
+    y0 = (tile / this->tilesX) * TILE_SIZE;
+    x1 = std::min(x0 + TILE_SIZE, this->width);
+    y1 = std::min(y0 + TILE_SIZE, this->height);
+}
+
+float* TCpuFramebuffer::tileRow(int tile, int row)
+{
+    int x0, y0, x1, y1;
+    this->tileBounds(tile, x0, y0, x1, y1);
+
+    /* Planes are whole images stacked bottom to top */
+    int plane = row / (y1 - y0);
+    int y     = y0 + row % (y1 - y0);
+    return &this->pixels[((plane * this->height + y) * this->width + x0) * 4];
+}
+
+void TCpuFramebuffer::clearTile(int tile)
+{
+    int x0, y0, x1, y1;
+    this->tileBounds(tile, x0, y0, x1, y1);
+
+    for (int row = 0; row < (y1 - y0) * this->planes; row++)
+    {
+        float* dst = this->tileRow(tile, row);
+        std::fill(dst, dst + (x1 - x0) * 4, 0.0f);
+    }
+    this->dirty[tile] = 0;
+}
+
+void TCpuFramebuffer::mergeTile(TCpuFramebuffer& src, int tile)
+{
+    int x0, y0, x1, y1;
+    this->tileBounds(tile, x0, y0, x1, y1);
+
+    for (int row = 0; row < (y1 - y0) * this->planes; row++)
+    {
+        float*       dstRow = this->tileRow(tile, row);
+        const float* srcRow = src.tileRow(tile, row);
+        for (int i = 0; i < (x1 - x0) * 4; i++)
+        {
+            dstRow[i] += srcRow[i];
+        }
+    }
+    this->dirty[tile] = 1;
+
+    src.clearTile(tile);
+}
+
+void TCpuFramebuffer::resolveTile(float* rgba, int tile)
+{
+    int x0, y0, x1, y1;
+    this->tileBounds(tile, x0, y0, x1, y1);
+
+    for (int row = 0; row < (y1 - y0) * this->planes; row++)
+    {
+        const float* src = this->tileRow(tile, row);
+        float*       dst = rgba + (src - this->pixels.data());
+        for (int i = 0; i < (x1 - x0) * 4; i++)
+        {
+            dst[i] += src[i];
+        }
+    }
+
+    this->clearTile(tile);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu_ray_state.h"
+
+/* Private float framebuffer of one scheduler worker, the CPU stand-in for
+   waveBuffer with additive blending. Pixels are RGBA like the RGBA32F
+   texture, alpha unused, so a fragment is one 16 byte vector add; rows are
+   stored bottom row first. Spectral accumulation stacks SPECTRAL_PLANES
+   such images, four bins to a pixel. A flag per TILE_SIZE x TILE_SIZE tile
+   records whether anything was splatted into it, in any plane, since it
+   was last cleared */
+class TCpuFramebuffer
+{
+public:
+    static constexpr int TILE_SIZE = 32;
+
+    void resize(int width, int height, int planes = 1);
+
+    void clear();
+
+    int tileCount() const
+    {
+        return this->tilesX * this->tilesY;
+    }
+
+    bool tileDirty(int tile) const
+    {
+        return this->dirty[tile] != 0;
+    }
+
+    /* Adds tile of src to the same tile of this buffer, then clears it in
+       src */
+    void mergeTile(TCpuFramebuffer& src, int tile);
+
+    /* Adds tile to the matching pixels of an RGBA buffer of the same size
+       and planes, such as screenBuffer, then clears it */
+    void resolveTile(float* rgba, int tile);
+
+    int width  = 0;
+    int height = 0;
+    int planes = 1;
+    int tilesX = 0;
+    int tilesY = 0;
+
+    TAlignedVector<float> pixels;
+    std::vector<uint8_t>  dirty;
+
+private:
+    void tileBounds(int tile, int& x0, int& y0, int& x1, int& y1) const;
+
+    /* Row row of tile, counting through the rows of every plane */
+    float* tileRow(int tile, int row);
+
+    void clearTile(int tile);
+};
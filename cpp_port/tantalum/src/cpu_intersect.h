@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cmath>
+#include <glm/glm.hpp>
+
+/* Mirror of the Ray/Intersection structs in shaders/trace-frag.glsl and of
+   the primitives in shaders/intersect.glsl */
+
+struct Ray
+{
+    glm::vec2 pos;
+    glm::vec2 dir;
+    glm::vec2 invDir;
+    glm::vec2 dirSign;
+};
+
+struct Intersection
+{
+    float     tMin;
+    float     tMax;
+    glm::vec2 n;
+    float     mat;
+};
+
+inline Ray unpackRay(glm::vec4 posDir)
+{
+    glm::vec2 pos = glm::vec2(posDir.x, posDir.y);
+    glm::vec2 dir = glm::vec2(posDir.z, posDir.w);
+    /* The nuclear option to fix NaN issues on some platforms */
+    dir.x = std::abs(dir.x) < 1e-5f ? 1e-5f : dir.x;
+    dir.y = std::abs(dir.y) < 1e-5f ? 1e-5f : dir.y;
+    return Ray{pos, glm::normalize(dir), 1.0f / dir, glm::sign(dir)};
+}
+
+inline void bboxIntersect(const Ray&    ray,
+                          glm::vec2     center,
+                          glm::vec2     radius,
+                          float         matId,
+                          Intersection& isect)
+{
+    glm::vec2 pos = ray.pos - center;
+    float     tx1 = (-radius.x - pos.x) * ray.invDir.x;
+    float     tx2 = (radius.x - pos.x) * ray.invDir.x;
+    float     ty1 = (-radius.y - pos.y) * ray.invDir.y;
+    float     ty2 = (radius.y - pos.y) * ray.invDir.y;
+
+    float minX = glm::min(tx1, tx2), maxX = glm::max(tx1, tx2);
+    float minY = glm::min(ty1, ty2), maxY = glm::max(ty1, ty2);
+
+    float tmin = glm::max(isect.tMin, glm::max(minX, minY));
+    float tmax = glm::min(isect.tMax, glm::min(maxX, maxY));
+
+    if (tmax >= tmin)
+    {
+        isect.tMax = (tmin == isect.tMin) ? tmax : tmin;
+        isect.n    = isect.tMax == tx1   ? glm::vec2(-1.0f, 0.0f)
+                     : isect.tMax == tx2 ? glm::vec2(1.0f, 0.0f)
+                     : isect.tMax == ty1 ? glm::vec2(0.0f, 1.0f)
+                                         : glm::vec2(0.0f, 1.0f);
+        isect.mat  = matId;
+    }
+}
+
+inline void sphereIntersect(const Ray&    ray,
+                            glm::vec2     center,
+                            float         radius,
+                            float         matId,
+                            Intersection& isect)
+{
+    glm::vec2 p     = ray.pos - center;
+    float     B     = glm::dot(p, ray.dir);
+    float     C     = glm::dot(p, p) - radius * radius;
+    float     detSq = B * B - C;
+    if (detSq >= 0.0f)
+    {
+        float det = std::sqrt(detSq);
+        float t   = -B - det;
+        if (t <= isect.tMin || t >= isect.tMax) t = -B + det;
+        if (t > isect.tMin && t < isect.tMax)
+        {
+            isect.tMax = t;
+            isect.n    = glm::normalize(p + ray.dir * t);
+            isect.mat  = matId;
+        }
+    }
+}
+
+inline void lineIntersect(const Ray&    ray,
+                          glm::vec2     a,
+                          glm::vec2     b,
+                          float         matId,
+                          Intersection& isect)
+{
+    glm::vec2 sT = b - a;
+    glm::vec2 sN = glm::vec2(-sT.y, sT.x);
+    float     t  = glm::dot(sN, a - ray.pos) / glm::dot(sN, ray.dir);
+    float     u  = glm::dot(sT, ray.pos + ray.dir * t - a);
+    if (t < isect.tMin || t >= isect.tMax || u < 0.0f || u > glm::dot(sT, sT))
+        return;
+
+    isect.tMax = t;
+    isect.n    = glm::normalize(sN);
+    isect.mat  = matId;
+}
+
+inline void prismIntersect(const Ray&    ray,
+                           glm::vec2     center,
+                           float         radius,
+                           float         matId,
+                           Intersection& isect)
+{
+    lineIntersect(ray,
+                  center + glm::vec2(0.0f, 1.0f) * radius,
+                  center + glm::vec2(0.866f, -0.5f) * radius,
+                  matId,
+                  isect);
+    lineIntersect(ray,
+                  center + glm::vec2(0.866f, -0.5f) * radius,
+                  center + glm::vec2(-0.866f, -0.5f) * radius,
+                  matId,
+                  isect);
+    lineIntersect(ray,
+                  center + glm::vec2(-0.866f, -0.5f) * radius,
+                  center + glm::vec2(0.0f, 1.0f) * radius,
+                  matId,
+                  isect);
+}
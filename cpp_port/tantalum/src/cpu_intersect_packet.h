@@ -0,0 +1,178 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "cpu_intersect.h"
+#include "cpu_simd.h"
+
+/* Packet versions of the primitives in cpu_intersect.h. V is one of the lane
+   types of cpu_simd.h; each lane carries one ray and the primitives only
+   update the tMax/n/mat of lanes that hit, so every lane ends up with the
+   same Intersection the scalar code computes for its ray, bit for bit */
+
+template <typename V>
+struct TRayPacket
+{
+    V posX, posY;
+    V dirX, dirY;
+    V invDirX, invDirY;
+    V dirSignX, dirSignY;
+};
+
+template <typename V>
+struct TIntersectionPacket
+{
+    V tMin;
+    V tMax;
+    V nX, nY;
+    V mat;
+};
+
+/* Packets of the native SIMD width */
+typedef TRayPacket<vfloat>          RayPacket;
+typedef TIntersectionPacket<vfloat> IntersectionPacket;
+
+/* unpackRay() on V::SIZE rays */
+template <typename V>
+inline TRayPacket<V> unpackRayPacket(V posX, V posY, V dirX, V dirY)
+{
+    dirX = select(abs(dirX) < V(1e-5f), V(1e-5f), dirX);
+    dirY = select(abs(dirY) < V(1e-5f), V(1e-5f), dirY);
+
+    /* glm::normalize is v * inversesqrt(dot(v, v)) */
+    V invLength = V(1.0f) / sqrt(dirX * dirX + dirY * dirY);
+
+    TRayPacket<V> ray;
+    ray.posX     = posX;
+    ray.posY     = posY;
+    ray.dirX     = dirX * invLength;
+    ray.dirY     = dirY * invLength;
+    ray.invDirX  = V(1.0f) / dirX;
+    ray.invDirY  = V(1.0f) / dirY;
+    ray.dirSignX = select(dirX > V(0.0f), V(1.0f), V(0.0f)) -
+                   select(dirX < V(0.0f), V(1.0f), V(0.0f));
+    ray.dirSignY = select(dirY > V(0.0f), V(1.0f), V(0.0f)) -
+                   select(dirY < V(0.0f), V(1.0f), V(0.0f));
+    return ray;
+}
+
+template <typename V>
+inline void bboxIntersect(const TRayPacket<V>&    ray,
+                          glm::vec2               center,
+                          glm::vec2               radius,
+                          float                   matId,
+                          TIntersectionPacket<V>& isect)
+{
+    V posX = ray.posX - V(center.x);
+    V posY = ray.posY - V(center.y);
+    V tx1  = (V(-radius.x) - posX) * ray.invDirX;
+    V tx2  = (V(radius.x) - posX) * ray.invDirX;
+    V ty1  = (V(-radius.y) - posY) * ray.invDirY;
+    V ty2  = (V(radius.y) - posY) * ray.invDirY;
+
+    V minX = min(tx1, tx2), maxX = max(tx1, tx2);
+    V minY = min(ty1, ty2), maxY = max(ty1, ty2);
+
+    V tmin = max(isect.tMin, max(minX, minY));
+    V tmax = min(isect.tMax, min(maxX, maxY));
+
+    auto hit = tmax >= tmin;
+    if (none(hit)) return;
+
+    V t = select(tmin == isect.tMin, tmax, tmin);
+
+    /* The ty1 and ty2 cases of the scalar code share a normal */
+    auto onX1 = t == tx1;
+    auto onX2 = andNot(t == tx2, onX1);
+    V    nX   = select(onX1, V(-1.0f), select(onX2, V(1.0f), V(0.0f)));
+    V    nY   = select(onX1 | onX2, V(0.0f), V(1.0f));
+
+    isect.tMax = select(hit, t, isect.tMax);
+    isect.nX   = select(hit, nX, isect.nX);
+    isect.nY   = select(hit, nY, isect.nY);
+    isect.mat  = select(hit, V(matId), isect.mat);
+}
+
+template <typename V>
+inline void sphereIntersect(const TRayPacket<V>&    ray,
+                            glm::vec2               center,
+                            float                   radius,
+                            float                   matId,
+                            TIntersectionPacket<V>& isect)
+{
+    V pX    = ray.posX - V(center.x);
+    V pY    = ray.posY - V(center.y);
+    V B     = pX * ray.dirX + pY * ray.dirY;
+    V C     = (pX * pX + pY * pY) - V(radius * radius);
+    V detSq = B * B - C;
+
+    auto valid = detSq >= V(0.0f);
+    if (none(valid)) return;
+
+    /* Lanes with detSq < 0 produce NaNs here, but are masked off below */
+    V det = sqrt(detSq);
+    V t   = -B - det;
+    t     = select((t <= isect.tMin) | (t >= isect.tMax), -B + det, t);
+
+    auto hit = valid & (t > isect.tMin) & (t < isect.tMax);
+    if (none(hit)) return;
+
+    V nX        = pX + ray.dirX * t;
+    V nY        = pY + ray.dirY * t;
+    V invLength = V(1.0f) / sqrt(nX * nX + nY * nY);
+
+    isect.tMax = select(hit, t, isect.tMax);
+    isect.nX   = select(hit, nX * invLength, isect.nX);
+    isect.nY   = select(hit, nY * invLength, isect.nY);
+    isect.mat  = select(hit, V(matId), isect.mat);
+}
+
+template <typename V>
+inline void lineIntersect(const TRayPacket<V>&    ray,
+                          glm::vec2               a,
+                          glm::vec2               b,
+                          float                   matId,
+                          TIntersectionPacket<V>& isect)
+{
+    glm::vec2 sT = b - a;
+    glm::vec2 sN = glm::vec2(-sT.y, sT.x);
+    glm::vec2 n  = glm::normalize(sN);
+
+    V t = (V(sN.x) * (V(a.x) - ray.posX) + V(sN.y) * (V(a.y) - ray.posY)) /
+          (V(sN.x) * ray.dirX + V(sN.y) * ray.dirY);
+    V u = V(sT.x) * ((ray.posX + ray.dirX * t) - V(a.x)) +
+          V(sT.y) * ((ray.posY + ray.dirY * t) - V(a.y));
+
+    /* Written as a rejection test like the scalar code, so NaN lanes hit */
+    auto miss = (t < isect.tMin) | (t >= isect.tMax) | (u < V(0.0f)) |
+                (u > V(glm::dot(sT, sT)));
+
+    isect.tMax = select(miss, isect.tMax, t);
+    isect.nX   = select(miss, isect.nX, V(n.x));
+    isect.nY   = select(miss, isect.nY, V(n.y));
+    isect.mat  = select(miss, isect.mat, V(matId));
+}
+
+template <typename V>
+inline void prismIntersect(const TRayPacket<V>&    ray,
+                           glm::vec2               center,
+                           float                   radius,
+                           float                   matId,
+                           TIntersectionPacket<V>& isect)
+{
+    lineIntersect(ray,
+                  center + glm::vec2(0.0f, 1.0f) * radius,
+                  center + glm::vec2(0.866f, -0.5f) * radius,
+                  matId,
+                  isect);
+    lineIntersect(ray,
+                  center + glm::vec2(0.866f, -0.5f) * radius,
+                  center + glm::vec2(-0.866f, -0.5f) * radius,
+                  matId,
+                  isect);
+    lineIntersect(ray,
+                  center + glm::vec2(-0.866f, -0.5f) * radius,
+                  center + glm::vec2(0.0f, 1.0f) * radius,
+                  matId,
+                  isect);
+}
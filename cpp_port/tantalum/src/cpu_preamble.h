@@ -0,0 +1,7 @@
+#pragma once
+
+/* CPU counterpart of shaders/preamble.glsl. The cpu_*.h headers mirror the
+   shader library one file at a time so the two can be diffed side by side */
+
+constexpr float PI      = 3.1415926536f;
+constexpr float PI_HALF = 1.5707963268f;
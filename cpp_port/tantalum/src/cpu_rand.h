@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/* Mirror of rand() in shaders/rand.glsl: four Schrage-style generators whose
+   states are stored as integer valued floats. Seeded with integers, the
+   states stay below 2^23 and every step is exact in float, which
+   tests/rand_test.cpp checks along with cpu_rand_packet.h. Both sums are
+   written out in the same order.
+
+   The GPU only gives the same sequence where it rounds division correctly:
+   GLSL allows 2.5 ULP for x/y, which can move floor(state/q) when state is
+   a multiple of q. Nothing checks the GPU side */
+inline float rand(glm::vec4& state)
+{
+    const glm::vec4 q(1225.0f, 1585.0f, 2457.0f, 2098.0f);
+    const glm::vec4 r(1112.0f, 367.0f, 92.0f, 265.0f);
+    const glm::vec4 a(3423.0f, 2646.0f, 1707.0f, 1999.0f);
+    const glm::vec4 m(4194287.0f, 4194277.0f, 4194191.0f, 4194167.0f);
+
+    glm::vec4 beta = glm::floor(state / q);
+    glm::vec4 p    = a * (state - beta * q) - beta * r;
+    beta           = (1.0f - glm::sign(p)) * 0.5f * m;
+    state          = p + beta;
+    glm::vec4 u    = state / m;
+    return glm::fract((u.x - u.y) + (u.z - u.w));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "cpu_simd.h"
+
+/* rand() of cpu_rand.h for V::SIZE rays at once. state[t] holds generator t
+   of every ray, as laid out in TCpuRayState::rng. All intermediates are
+   integers below 2^24, so float lanes carry them exactly and no 32 bit
+   integer multiply is needed; the result is the scalar one bit for bit */
+template <typename V>
+inline V rand(V (&state)[4])
+{
+    static constexpr float q[4] = {1225.0f, 1585.0f, 2457.0f, 2098.0f};
+    static constexpr float r[4] = {1112.0f, 367.0f, 92.0f, 265.0f};
+    static constexpr float a[4] = {3423.0f, 2646.0f, 1707.0f, 1999.0f};
+    static constexpr float m[4] = {
+        4194287.0f, 4194277.0f, 4194191.0f, 4194167.0f};
+
+    V u[4];
+    for (int t = 0; t < 4; t++)
+    {
+        V beta = floor(state[t] / V(q[t]));
+        V p    = V(a[t]) * (state[t] - beta * V(q[t])) - beta * V(r[t]);
+        V sign = select(p > V(0.0f), V(1.0f), V(0.0f)) -
+                 select(p < V(0.0f), V(1.0f), V(0.0f));
+        beta     = (V(1.0f) - sign) * V(0.5f) * V(m[t]);
+        state[t] = p + beta;
+        u[t]     = state[t] / V(m[t]);
+    }
+
+    V sum = (u[0] - u[1]) + (u[2] - u[3]);
+    return sum - floor(sum);
+}
@@ -0,0 +1,68 @@
+#include "cpu_ray_state.h"
+
+#include <cmath>
+
+#include "cpu_preamble.h"
+
+TCpuRayState::TCpuRayState(int size, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    this->size        = size;
+    this->count       = size * size;
+    this->paddedCount = (this->count + LANE_PADDING - 1) / LANE_PADDING *
+                        LANE_PADDING;
+
+    for (auto* array : {&this->posX,
+                        &this->posY,
+                        &this->dirX,
+                        &this->dirY,
+                        &this->rng[0],
+                        &this->rng[1],
+                        &this->rng[2],
+                        &this->rng[3],
+                        &this->r,
+                        &this->g,
+                        &this->b,
+                        &this->lambda,
+                        &this->heroR,
+                        &this->heroG,
+                        &this->heroB,
+                        &this->heroShared})
+    {
+        array->assign(this->paddedCount, 0.0f);
+    }
+    this->depth.assign(this->paddedCount, 0);
+
+    /* Same draws in the same order as TRayState, including the integer
+       generator seeds, see cpu_rand.h */
+    for (int i = 0; i < this->count; i++)
+    {
+        float theta   = dist(rng) * PI * 2.0f;
+        this->dirX[i] = cos(theta);
+        this->dirY[i] = sin(theta);
+
+        for (int t = 0; t < 4; t++)
+        {
+            this->rng[t][i] = 1.0f + std::floor(dist(rng) * 4194165.0f);
+        }
+    }
+
+    /* Padding lanes get a valid generator state so SIMD kernels running past
+       the end never feed zeros into the Schrage recurrence */
+    for (int i = this->count; i < this->paddedCount; i++)
+    {
+        for (int t = 0; t < 4; t++)
+        {
+            this->rng[t][i] = 1.0f;
+        }
+        this->dirX[i] = 1.0f;
+    }
+}
+
+TCpuRayStates::TCpuRayStates(int size, std::default_random_engine& rng)
+{
+    this->currentState = 0;
+    this->states.emplace_back(size, rng);
+    this->states.emplace_back(size, rng);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <random>
+#include <vector>
+
+/* std::allocator with a stronger alignment guarantee, so every array of the
+   ray store starts on a cache line and can be streamed with aligned loads */
+template <typename T, size_t Alignment>
+class TAlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef TAlignedAllocator<U, Alignment> other;
+    };
+
+    TAlignedAllocator() = default;
+
+    template <typename U>
+    TAlignedAllocator(const TAlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const TAlignedAllocator<U, Alignment>&) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const TAlignedAllocator<U, Alignment>&) const
+    {
+        return false;
+    }
+};
+
+template <typename T>
+using TAlignedVector = std::vector<T, TAlignedAllocator<T, 64>>;
+
+/* Structure-of-arrays version of TRayState. Holds the same per-ray values as
+   the PosData/RngData/RgbData/HeroData textures, but with one 64 byte aligned
+   array per channel. The array length is rounded up to a multiple of
+   LANE_PADDING so kernels can run whole vectors past the last ray */
+class TCpuRayState
+{
+public:
+    static constexpr int LANE_PADDING = 64 / sizeof(float);
+
+    TCpuRayState(int size, std::default_random_engine& rng);
+
+    int size;
+    int count;
+    int paddedCount;
+
+    TAlignedVector<float> posX;
+    TAlignedVector<float> posY;
+    TAlignedVector<float> dirX;
+    TAlignedVector<float> dirY;
+    TAlignedVector<float> rng[4];
+    TAlignedVector<float> r;
+    TAlignedVector<float> g;
+    TAlignedVector<float> b;
+    TAlignedVector<float> lambda;
+    TAlignedVector<float> heroR;
+    TAlignedVector<float> heroG;
+    TAlignedVector<float> heroB;
+    TAlignedVector<float> heroShared;
+
+    /* Bounces since emission; only the CPU engine tracks it */
+    TAlignedVector<int> depth;
+};
+
+/* The two ray states TRenderer ping-pongs between. Passes read current()
+   and write next(); swap() corresponds to TRenderer flipping currentState */
+class TCpuRayStates
+{
+public:
+    TCpuRayStates(int size, std::default_random_engine& rng);
+
+    TCpuRayState& current()
+    {
+        return this->states[this->currentState];
+    }
+
+    TCpuRayState& next()
+    {
+        return this->states[1 - this->currentState];
+    }
+
+    void swap()
+    {
+        this->currentState = 1 - this->currentState;
+    }
+
+    int                       currentState;
+    std::vector<TCpuRayState> states;
+};
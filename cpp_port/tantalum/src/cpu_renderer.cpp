@@ -0,0 +1,881 @@
+#include "cpu_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <thread>
+
+#include "cpu_bsdf_packet.h"
+#include "cpu_intersect.h"
+#include "cpu_preamble.h"
+#include "cpu_rand.h"
+#include "cpu_rand_packet.h"
+#include "cpu_scenes.h"
+#include "cpu_splat.h"
+
+using glm::vec2;
+using glm::vec3;
+using glm::vec4;
+
+/* texture2D() on the RGBA GL_LINEAR/GL_CLAMP_TO_EDGE spectrum table */
+static vec3 textureLinear(TSpan<const float> table, float u)
+{
+    int   size = int(table.size() / 4);
+    float x    = u * size - 0.5f;
+    float x0   = std::floor(x);
+    float f    = x - x0;
+    int   i0   = std::min(std::max(int(x0), 0), size - 1);
+    int   i1   = std::min(std::max(int(x0) + 1, 0), size - 1);
+
+    vec3 a(table[i0 * 4 + 0], table[i0 * 4 + 1], table[i0 * 4 + 2]);
+    vec3 b(table[i1 * 4 + 0], table[i1 * 4 + 1], table[i1 * 4 + 2]);
+    return a + (b - a) * f;
+}
+
+TCpuRenderer::TCpuRenderer(int                            width,
+                           int                            height,
+                           const std::vector<TSceneInfo>& scenes,
+                           int                            numThreads)
+{
+    for (const auto& scene : scenes) this->scenes.emplace_back(scene);
+
+    this->maxSampleCount = 100000;
+    this->currentScene   = 0;
+    this->needsReset     = true;
+    this->maxPathLength  = 12;
+
+    this->reduceDirtyTilesOnly = true;
+    this->wavefront            = false;
+    this->regenerate           = false;
+    this->heroWavelengths      = false;
+    this->spectral             = false;
+    this->spectralOutput       = ESpectralOutput::SPECTRAL_RGB;
+
+    this->numThreads = numThreads > 0
+                           ? numThreads
+                           : std::max(1u, std::thread::hardware_concurrency());
+    this->scheduler = std::make_unique<TCpuScheduler>(this->numThreads);
+
+    this->raySize = 512;
+    this->resetActiveBlock();
+    this->rayCount = this->raySize * this->raySize;
+
+    this->rayStates =
+        std::make_unique<TCpuRayStates>(this->raySize, this->rng);
+
+    this->width  = 0;
+    this->height = 0;
+    this->changeResolution(width, height);
+    this->setEmitterPos({width / 2, height / 2}, {width / 2, height / 2});
+    this->computeEmissionSpectrum();
+}
+
+void TCpuRenderer::resetActiveBlock()
+{
+    /* No frame time to stay under, so always trace whole waves */
+    this->activeBlock = this->raySize;
+}
+
+void TCpuRenderer::setEmissionSpectrumType(ESpectrumType type)
+{
+    this->emitter.emissionSpectrumType = type;
+    this->computeEmissionSpectrum();
+}
+
+void TCpuRenderer::setEmitterTemperature(float temperature)
+{
+    this->emitter.emitterTemperature = temperature;
+    if (this->emitter.emissionSpectrumType ==
+        ESpectrumType::SPECTRUM_INCANDESCENT)
+        this->computeEmissionSpectrum();
+}
+
+void TCpuRenderer::setEmitterGas(int gasId)
+{
+    this->emitter.emitterGas = gasId;
+    if (this->emitter.emissionSpectrumType ==
+        ESpectrumType::SPECTRUM_GAS_DISCHARGE)
+        this->computeEmissionSpectrum();
+}
+
+void TCpuRenderer::computeEmissionSpectrum()
+{
+    this->emitter.computeEmissionSpectrum();
+    this->reset();
+}
+
+void TCpuRenderer::setMaxPathLength(int length)
+{
+    this->maxPathLength = length;
+    this->reset();
+}
+
+void TCpuRenderer::setMaxSampleCount(int count)
+{
+    this->maxSampleCount = count;
+}
+
+void TCpuRenderer::changeResolution(int width, int height)
+{
+    if (this->width && this->height)
+    {
+        auto& emitterPos = this->emitter.emitterPos;
+        emitterPos[0] = (emitterPos[0] + 0.5) * width / this->width - 0.5;
+        emitterPos[1] = (emitterPos[1] + 0.5) * height / this->height - 0.5;
+    }
+
+    this->width  = width;
+    this->height = height;
+    this->aspect = float(this->width) / float(this->height);
+
+    this->allocateBuffers();
+
+    this->resetActiveBlock();
+    this->needsReset = true;
+    this->reset();
+}
+
+void TCpuRenderer::setSpectral(bool spectral)
+{
+    this->spectral = spectral;
+    this->allocateBuffers();
+
+    this->needsReset = true;
+    this->reset();
+}
+
+void TCpuRenderer::setSpectralOutput(ESpectralOutput output)
+{
+    this->spectralOutput = output;
+}
+
+void TCpuRenderer::allocateBuffers()
+{
+    int planes = this->spectral ? SPECTRAL_PLANES : 1;
+
+    this->screenBuffer.assign(this->width * this->height * 4 * planes, 0.0f);
+    this->waveBuffers.resize(this->spectral ? 1
+                                            : this->scheduler->numWorkers());
+    for (auto& buffer : this->waveBuffers)
+        buffer.resize(this->width, this->height, planes);
+}
+
+void TCpuRenderer::changeScene(int idx)
+{
+    this->resetActiveBlock();
+    this->currentScene = idx;
+    this->reset();
+}
+
+void TCpuRenderer::reset()
+{
+    if (!this->needsReset) return;
+    this->needsReset    = false;
+    this->wavesTraced   = 0;
+    this->raysTraced    = 0;
+    this->samplesTraced  = 0;
+    this->pathsCompleted = 0;
+    this->pathLength     = 0;
+
+    std::fill(this->screenBuffer.begin(), this->screenBuffer.end(), 0.0f);
+    for (auto& buffer : this->waveBuffers) buffer.clear();
+}
+
+void TCpuRenderer::setSpreadType(ESpreadType type)
+{
+    this->resetActiveBlock();
+    this->emitter.spreadType = type;
+    this->emitter.computeSpread();
+    this->reset();
+}
+
+void TCpuRenderer::setNormalizedEmitterPos(const glm::vec2& posA,
+                                           const glm::vec2& posB)
+{
+    this->setEmitterPos({posA[0] * this->width, posA[1] * this->height},
+                        {posB[0] * this->width, posB[1] * this->height});
+}
+
+void TCpuRenderer::setEmitterPos(const glm::vec2& posA, const glm::vec2& posB)
+{
+    this->emitter.setEmitterPos(posA, posB);
+    this->reset();
+}
+
+int64_t TCpuRenderer::totalRaysTraced() const
+{
+    return this->raysTraced;
+}
+
+int64_t TCpuRenderer::maxRayCount() const
+{
+    return this->maxPathLength * this->maxSampleCount;
+}
+
+int64_t TCpuRenderer::totalSamplesTraced() const
+{
+    return this->samplesTraced;
+}
+
+float TCpuRenderer::progress() const
+{
+    return std::min(
+        float(this->totalRaysTraced()) / float(this->maxRayCount()), 1.0f);
+}
+
+bool TCpuRenderer::finished() const
+{
+    if (this->regenerate && this->pathsCompleted < this->samplesTraced)
+        return false;
+    return this->totalSamplesTraced() >= this->maxSampleCount;
+}
+
+float TCpuRenderer::exposure() const
+{
+    /* Only paths that have ended are in the image */
+    int64_t paths =
+        this->regenerate ? this->pathsCompleted : this->samplesTraced;
+    return this->width /
+           float(std::max(paths, int64_t(this->raySize) * this->activeBlock));
+}
+
+void TCpuRenderer::composite(std::vector<unsigned char>& pixels) const
+{
+    float exposure = this->exposure();
+
+    /* compose-spectral-frag.glsl: the bins weighted by their response */
+    std::vector<float> rgb(this->screenBuffer.begin(),
+                           this->screenBuffer.begin() +
+                               this->width * this->height * 4);
+    if (this->spectral)
+    {
+        std::vector<float> response =
+            this->emitter.spectralBinResponse(this->spectralOutput);
+        int planeSize = this->width * this->height * 4;
+        for (int i = 0; i < planeSize; i += 4)
+        {
+            vec3 color(0.0f);
+            for (int bin = 0; bin < SPECTRAL_BINS; bin++)
+            {
+                float value =
+                    this->screenBuffer[(bin / 4) * planeSize + i + bin % 4];
+                color += value * vec3(response[bin * 4 + 0],
+                                      response[bin * 4 + 1],
+                                      response[bin * 4 + 2]);
+            }
+            rgb[i + 0] = color.x;
+            rgb[i + 1] = color.y;
+            rgb[i + 2] = color.z;
+        }
+    }
+
+    pixels.resize(this->width * this->height * 4);
+    for (int y = 0; y < this->height; y++)
+    {
+        const float*   src = &rgb[y * this->width * 4];
+        unsigned char* dst = &pixels[(this->height - 1 - y) * this->width * 4];
+        for (int x = 0; x < this->width; x++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                float v = std::pow(std::max(src[x * 4 + c] * exposure, 0.0f),
+                                   1.0f / 2.2f);
+                dst[x * 4 + c] =
+                    (unsigned char)(std::min(v, 1.0f) * 255.0f + 0.5f);
+            }
+            dst[x * 4 + 3] = 255;
+        }
+    }
+}
+
+void TCpuRenderer::emitRay(TCpuRayState&           dst,
+                           int                     i,
+                           const TEmitterUniforms& uniforms,
+                           const float             (&rands)[4])
+{
+    const auto& aliasTable = this->emitter.aliasTable;
+    const auto& spectrum   = this->emitter.spectrumTable;
+
+    /* sampleWavelength() of init-frag.glsl */
+    auto sampleWavelength = [&](float u, float jitter, float& lambda) {
+        u                  = u * SPECTRUM_SAMPLES;
+        int          bin   = std::min(int(u), SPECTRUM_SAMPLES - 1);
+        const float* alias = &aliasTable[bin * 4];
+        bool         keep  = u - float(bin) < alias[0];
+        if (!keep) bin = int(alias[1]);
+
+        float spectrumOffset = (float(bin) + jitter) * (1.0f / 256.0f);
+        lambda = 360.0f + (750.0f - 360.0f) * spectrumOffset;
+
+        /* Spectral mode splits the radiance over rgb in proportion to the
+           color of lambda, so albedos still filter it; the splat sums it
+           back up into the bin of lambda */
+        vec3 color = textureLinear(spectrum, spectrumOffset);
+        if (this->spectral)
+        {
+            color = glm::abs(color);
+            color /= std::max(color.x + color.y + color.z, 1e-6f);
+        }
+        return uniforms.power * (keep ? alias[2] : alias[3]) * color;
+    };
+
+    float theta = uniforms.angularSpread.x +
+                  (rands[0] - 0.5f) * uniforms.angularSpread.y;
+    vec2 dir = vec2(std::cos(theta), std::sin(theta));
+    vec2 pos = uniforms.pos + (rands[1] - 0.5f) * uniforms.spatialSpread *
+                                  vec2(-uniforms.dir.y, uniforms.dir.x);
+
+    float lambda;
+    vec3  rgb        = sampleWavelength(rands[2], rands[3], lambda);
+    vec3  hero       = vec3(0.0f);
+    float heroShared = 0.0f;
+    if (this->heroWavelengths && !this->spectral)
+    {
+        float unused;
+        hero       = rgb;
+        heroShared = 1.0f;
+        for (float k : {0.25f, 0.50f, 0.75f})
+        {
+            float u = rands[2] + k;
+            rgb += sampleWavelength(u - std::floor(u), rands[3], unused);
+        }
+        rgb *= 0.25f;
+    }
+
+    dst.posX[i]       = pos.x;
+    dst.posY[i]       = pos.y;
+    dst.dirX[i]       = dir.x;
+    dst.dirY[i]       = dir.y;
+    dst.r[i]          = rgb.x;
+    dst.g[i]          = rgb.y;
+    dst.b[i]          = rgb.z;
+    dst.lambda[i]     = lambda;
+    dst.heroR[i]      = hero.x;
+    dst.heroG[i]      = hero.y;
+    dst.heroB[i]      = hero.z;
+    dst.heroShared[i] = heroShared;
+    dst.depth[i]      = 0;
+}
+
+void TCpuRenderer::initRays(const TCpuRayState&     src,
+                            TCpuRayState&           dst,
+                            int                     begin,
+                            int                     end,
+                            const TEmitterUniforms& uniforms)
+{
+    /* Chunks start on a multiple of RAY_CHUNK_SIZE and end on one or at the
+       last ray, after which only padding follows, so whole packets never
+       touch the rays of another chunk */
+    constexpr int SIZE = vfloat::SIZE;
+    alignas(64) float rands[4][SIZE];
+
+    for (int i = begin; i < end; i += SIZE)
+    {
+        vfloat state[4];
+        for (int t = 0; t < 4; t++)
+        {
+            state[t] = vfloat::load(&src.rng[t][i]);
+        }
+        for (int k = 0; k < 4; k++)
+        {
+            rand(state).store(rands[k]);
+        }
+        for (int t = 0; t < 4; t++)
+        {
+            state[t].store(&dst.rng[t][i]);
+        }
+
+        for (int lane = 0; lane < std::min(SIZE, end - i); lane++)
+        {
+            const float laneRands[4] = {
+                rands[0][lane], rands[1][lane], rands[2][lane], rands[3][lane]};
+            this->emitRay(dst, i + lane, uniforms, laneRands);
+        }
+    }
+}
+
+int TCpuRenderer::regenerateRays(TCpuRayState&           state,
+                                 int                     begin,
+                                 int                     end,
+                                 const TEmitterUniforms& uniforms,
+                                 bool                    emit,
+                                 int64_t&                completed)
+{
+    int emitted = 0;
+    for (int i = begin; i < end; i++)
+    {
+        if (state.depth[i] >= RETIRED_DEPTH) continue;
+
+        bool black = state.r[i] == 0.0f && state.g[i] == 0.0f &&
+                     state.b[i] == 0.0f;
+        if (!black && state.depth[i] < this->maxPathLength) continue;
+
+        completed++;
+        if (!emit)
+        {
+            /* Black for the rest of the drain, even past a dispersive hit */
+            state.r[i]          = 0.0f;
+            state.g[i]          = 0.0f;
+            state.b[i]          = 0.0f;
+            state.heroShared[i] = 0.0f;
+            state.depth[i]      = RETIRED_DEPTH;
+            continue;
+        }
+
+        vec4 rng(state.rng[0][i], state.rng[1][i], state.rng[2][i],
+                 state.rng[3][i]);
+        const float rands[4] = {rand(rng), rand(rng), rand(rng), rand(rng)};
+        state.rng[0][i] = rng.x;
+        state.rng[1][i] = rng.y;
+        state.rng[2][i] = rng.z;
+        state.rng[3][i] = rng.w;
+
+        this->emitRay(state, i, uniforms, rands);
+        emitted++;
+    }
+    return emitted;
+}
+
+/* Second half of trace-frag.glsl: samples the BSDF at the hit point of ray
+   i and writes the continued ray */
+static void shadeRay(const TCpuScene&    scene,
+                     const TCpuRayState& src,
+                     TCpuRayState&       dst,
+                     int                 i,
+                     const Ray&          ray,
+                     const Intersection& isect)
+{
+    vec4  state(src.rng[0][i], src.rng[1][i], src.rng[2][i], src.rng[3][i]);
+    vec3  rgb(src.r[i], src.g[i], src.b[i]);
+    float lambda = src.lambda[i];
+    vec3  hero(src.heroR[i], src.heroG[i], src.heroB[i]);
+    float heroShared = src.heroShared[i];
+    vec4  posDir(src.posX[i], src.posY[i], src.dirX[i], src.dirY[i]);
+
+    vec2 t       = vec2(-isect.n.y, isect.n.x);
+    vec2 wiLocal = -vec2(glm::dot(t, ray.dir), glm::dot(isect.n, ray.dir));
+
+    if (heroShared != 0.0f && scene.dispersive(isect))
+    {
+        rgb        = hero;
+        heroShared = 0.0f;
+    }
+
+    vec3 throughput(1.0f);
+    vec2 woLocal = scene.sample(state, isect, lambda, wiLocal, throughput);
+    rgb *= throughput;
+    hero *= throughput;
+
+    if (isect.tMax == 1e30f)
+    {
+        rgb  = vec3(0.0f);
+        hero = vec3(0.0f);
+    }
+    else
+    {
+        vec2 pos = ray.pos + ray.dir * isect.tMax;
+        vec2 dir = woLocal.y * isect.n + woLocal.x * t;
+        posDir   = vec4(pos.x, pos.y, dir.x, dir.y);
+    }
+
+    dst.posX[i]       = posDir.x;
+    dst.posY[i]       = posDir.y;
+    dst.dirX[i]       = posDir.z;
+    dst.dirY[i]       = posDir.w;
+    dst.rng[0][i]     = state.x;
+    dst.rng[1][i]     = state.y;
+    dst.rng[2][i]     = state.z;
+    dst.rng[3][i]     = state.w;
+    dst.r[i]          = rgb.x;
+    dst.g[i]          = rgb.y;
+    dst.b[i]          = rgb.z;
+    dst.lambda[i]     = lambda;
+    dst.heroR[i]      = hero.x;
+    dst.heroG[i]      = hero.y;
+    dst.heroB[i]      = hero.z;
+    dst.heroShared[i] = heroShared;
+    dst.depth[i]      = src.depth[i] + 1;
+}
+
+/* shadeRay() on the rays block + order[n], n < count <= vfloat::SIZE, which
+   all hit material matId. Lanes past count repeat the last ray and are not
+   written back */
+static void shadeRayPacket(const TCpuScene&    scene,
+                           const TCpuRayState& src,
+                           TCpuRayState&       dst,
+                           int                 block,
+                           const uint16_t*     order,
+                           int                 count,
+                           const float*        tMax,
+                           const float*        nX,
+                           const float*        nY,
+                           int                 matId)
+{
+    constexpr int SIZE = vfloat::SIZE;
+
+    int index[SIZE];
+    for (int lane = 0; lane < SIZE; lane++)
+    {
+        index[lane] = order[std::min(lane, count - 1)];
+    }
+    auto gather = [&](const float* array) {
+        alignas(64) float lanes[SIZE];
+        for (int lane = 0; lane < SIZE; lane++)
+        {
+            lanes[lane] = array[index[lane]];
+        }
+        return vfloat::load(lanes);
+    };
+
+    vfloat posX = gather(&src.posX[block]);
+    vfloat posY = gather(&src.posY[block]);
+    vfloat dirX = gather(&src.dirX[block]);
+    vfloat dirY = gather(&src.dirY[block]);
+    vfloat state[4];
+    for (int t = 0; t < 4; t++)
+    {
+        state[t] = gather(&src.rng[t][block]);
+    }
+    vfloat rgb[3]  = {gather(&src.r[block]),
+                      gather(&src.g[block]),
+                      gather(&src.b[block])};
+    vfloat hero[3] = {gather(&src.heroR[block]),
+                      gather(&src.heroG[block]),
+                      gather(&src.heroB[block])};
+    vfloat lambda     = gather(&src.lambda[block]);
+    vfloat heroShared = gather(&src.heroShared[block]);
+    vfloat hitT       = gather(tMax);
+    vfloat hitNX      = gather(nX);
+    vfloat hitNY      = gather(nY);
+
+    RayPacket ray = unpackRayPacket(posX, posY, dirX, dirY);
+    vfloat    tX  = -hitNY;
+    vfloat    tY  = hitNX;
+    vfloat    wiX = -(tX * ray.dirX + tY * ray.dirY);
+    vfloat    wiY = -(hitNX * ray.dirX + hitNY * ray.dirY);
+
+    if (scene.dispersive(matId))
+    {
+        auto shared = heroShared != vfloat(0.0f);
+        for (int c = 0; c < 3; c++)
+        {
+            rgb[c] = select(shared, hero[c], rgb[c]);
+        }
+        heroShared = select(shared, vfloat(0.0f), heroShared);
+    }
+
+    int          offset   = scene.iorTableOffsets[matId];
+    const float* iorTable = offset < 0 ? nullptr : &scene.iorTables[offset];
+    vfloat       throughput[3] = {vfloat(1.0f), vfloat(1.0f), vfloat(1.0f)};
+    auto         wo            = sampleMaterial(scene.materials[matId],
+                                     iorTable,
+                                     state,
+                                     hitNX,
+                                     lambda,
+                                     wiX,
+                                     wiY,
+                                     throughput);
+
+    auto miss = hitT == vfloat(1e30f);
+    for (int c = 0; c < 3; c++)
+    {
+        rgb[c]  = select(miss, vfloat(0.0f), rgb[c] * throughput[c]);
+        hero[c] = select(miss, vfloat(0.0f), hero[c] * throughput[c]);
+    }
+    posX = select(miss, posX, ray.posX + ray.dirX * hitT);
+    posY = select(miss, posY, ray.posY + ray.dirY * hitT);
+    dirX = select(miss, dirX, wo.y * hitNX + wo.x * tX);
+    dirY = select(miss, dirY, wo.y * hitNY + wo.x * tY);
+
+    auto scatter = [&](vfloat value, TAlignedVector<float>& array) {
+        alignas(64) float lanes[SIZE];
+        value.store(lanes);
+        for (int lane = 0; lane < count; lane++)
+        {
+            array[block + index[lane]] = lanes[lane];
+        }
+    };
+    scatter(posX, dst.posX);
+    scatter(posY, dst.posY);
+    scatter(dirX, dst.dirX);
+    scatter(dirY, dst.dirY);
+    for (int t = 0; t < 4; t++)
+    {
+        scatter(state[t], dst.rng[t]);
+    }
+    scatter(rgb[0], dst.r);
+    scatter(rgb[1], dst.g);
+    scatter(rgb[2], dst.b);
+    scatter(lambda, dst.lambda);
+    scatter(hero[0], dst.heroR);
+    scatter(hero[1], dst.heroG);
+    scatter(hero[2], dst.heroB);
+    scatter(heroShared, dst.heroShared);
+    for (int lane = 0; lane < count; lane++)
+    {
+        int i        = block + index[lane];
+        dst.depth[i] = src.depth[i] + 1;
+    }
+}
+
+/* First half of trace-frag.glsl for count rays from begin, into per-ray
+   hit arrays */
+static void intersectRays(const TCpuScene&    scene,
+                          const TCpuRayState& src,
+                          int                 begin,
+                          int                 count,
+                          float*              tMax,
+                          float*              nX,
+                          float*              nY,
+                          float*              mat)
+{
+    /* begin is a multiple of RAY_CHUNK_SIZE, and the ray and hit arrays are
+       padded, so the last packet may run past count */
+    for (int k = 0; k < count; k += vfloat::SIZE)
+    {
+        int       i      = begin + k;
+        RayPacket packet = unpackRayPacket(vfloat::load(&src.posX[i]),
+                                           vfloat::load(&src.posY[i]),
+                                           vfloat::load(&src.dirX[i]),
+                                           vfloat::load(&src.dirY[i]));
+        IntersectionPacket isects;
+        isects.tMin = vfloat(1e-4f);
+        isects.tMax = vfloat(1e30f);
+        isects.nX   = vfloat(0.0f);
+        isects.nY   = vfloat(0.0f);
+        isects.mat  = vfloat(0.0f);
+        scene.intersectPacket(packet, isects);
+
+        isects.tMax.store(&tMax[k]);
+        isects.nX.store(&nX[k]);
+        isects.nY.store(&nY[k]);
+        isects.mat.store(&mat[k]);
+    }
+}
+
+void TCpuRenderer::traceRays(const TCpuRayState& src,
+                             TCpuRayState&       dst,
+                             int                 begin,
+                             int                 end)
+{
+    const TCpuScene& scene = this->scenes[this->currentScene];
+
+    alignas(64) float tMax[RAY_CHUNK_SIZE], nX[RAY_CHUNK_SIZE];
+    alignas(64) float nY[RAY_CHUNK_SIZE], mat[RAY_CHUNK_SIZE];
+    uint16_t          order[RAY_CHUNK_SIZE];
+
+    for (int block = begin; block < end; block += RAY_CHUNK_SIZE)
+    {
+        int count = std::min(RAY_CHUNK_SIZE, end - block);
+
+        intersectRays(scene, src, block, count, tMax, nX, nY, mat);
+
+        /* Wavefront mode: counting sort of the block by material, then
+           each run of one material is shaded in packets */
+        if (this->wavefront)
+        {
+            auto binOf = [&](int k) {
+                return std::min(std::max(int(mat[k]), 0), MATERIAL_BINS - 1);
+            };
+
+            int binStart[MATERIAL_BINS + 1] = {};
+            for (int k = 0; k < count; k++)
+            {
+                binStart[binOf(k) + 1]++;
+            }
+            for (int bin = 0; bin < MATERIAL_BINS; bin++)
+            {
+                binStart[bin + 1] += binStart[bin];
+            }
+            for (int k = 0; k < count; k++)
+            {
+                order[binStart[binOf(k)]++] = uint16_t(k);
+            }
+
+            /* binStart[bin] now ends the run of bin */
+            int first = 0;
+            for (int bin = 0; bin < MATERIAL_BINS; bin++)
+            {
+                for (int n = first; n < binStart[bin]; n += vfloat::SIZE)
+                {
+                    shadeRayPacket(scene,
+                                   src,
+                                   dst,
+                                   block,
+                                   &order[n],
+                                   std::min(vfloat::SIZE, binStart[bin] - n),
+                                   tMax,
+                                   nX,
+                                   nY,
+                                   bin);
+                }
+                first = binStart[bin];
+            }
+        }
+        else
+        {
+            for (int k = 0; k < count; k++)
+            {
+                int i   = block + k;
+                Ray ray = unpackRay(
+                    vec4(src.posX[i], src.posY[i], src.dirX[i], src.dirY[i]));
+                Intersection isect;
+                isect.tMin = 1e-4f;
+                isect.tMax = tMax[k];
+                isect.n    = vec2(nX[k], nY[k]);
+                isect.mat  = mat[k];
+
+                shadeRay(scene, src, dst, i, ray, isect);
+            }
+        }
+    }
+}
+
+void TCpuRenderer::splatRays(const TCpuRayState& a,
+                             const TCpuRayState& b,
+                             int                 begin,
+                             int                 end,
+                             TCpuFramebuffer&    waveBuffer)
+{
+    splatSegments(a, b, begin, end, this->aspect, waveBuffer);
+}
+
+void TCpuRenderer::splatSpectralRays(const TCpuRayState& a,
+                                     const TCpuRayState& b,
+                                     int                 numRays,
+                                     int                 band)
+{
+    auto& waveBuffer = this->waveBuffers[0];
+    int   rowBegin   = band * TCpuFramebuffer::TILE_SIZE;
+    int   rowEnd =
+        std::min(rowBegin + TCpuFramebuffer::TILE_SIZE, waveBuffer.height);
+    splatSpectralSegments(
+        a, b, 0, numRays, this->aspect, rowBegin, rowEnd, waveBuffer);
+}
+
+void TCpuRenderer::accumulateWaveBuffers()
+{
+    auto& buffers  = this->waveBuffers;
+    int   count    = int(buffers.size());
+    int   numTiles = buffers[0].tileCount();
+    bool  allTiles = !this->reduceDirtyTilesOnly;
+
+    /* Pairwise tree: in the round of a given stride, buffer i absorbs buffer
+       i + stride for every i that is a multiple of twice the stride. Each
+       (pair, tile) is one task, so no two workers ever write the same
+       pixels */
+    for (int stride = 1; stride < count; stride *= 2)
+    {
+        int  pairs     = (count - stride - 1) / (2 * stride) + 1;
+        auto mergeTile = [&](int, int begin, int end) {
+            for (int task = begin; task < end; task++)
+            {
+                int   tile = task % numTiles;
+                auto& dst  = buffers[(task / numTiles) * 2 * stride];
+                auto& src  = buffers[(task / numTiles) * 2 * stride + stride];
+                if (allTiles || src.tileDirty(tile)) dst.mergeTile(src, tile);
+            }
+        };
+        this->scheduler->run(pairs * numTiles, TILE_CHUNK_SIZE, mergeTile);
+    }
+
+    auto resolveTile = [&](int, int begin, int end) {
+        for (int tile = begin; tile < end; tile++)
+        {
+            if (allTiles || buffers[0].tileDirty(tile))
+                buffers[0].resolveTile(this->screenBuffer.data(), tile);
+        }
+    };
+    this->scheduler->run(numTiles, TILE_CHUNK_SIZE, resolveTile);
+}
+
+void TCpuRenderer::render()
+{
+    this->needsReset = true;
+
+    auto& rayStates = *this->rayStates;
+
+    int  numRays  = this->raySize * this->activeBlock;
+    auto uniforms = this->emitter.uniforms(this->width, this->height);
+
+    /* With regeneration only the very first bounce starts a wave; after
+       that dead rays are re-emitted by the trace pass itself */
+    bool startWave = this->regenerate ? this->raysTraced == 0
+                                      : this->pathLength == 0;
+    if (startWave)
+    {
+        this->scheduler->run(
+            numRays, RAY_CHUNK_SIZE, [&](int, int begin, int end) {
+                this->initRays(rayStates.current(),
+                               rayStates.next(),
+                               begin,
+                               end,
+                               uniforms);
+            });
+
+        rayStates.swap();
+
+        if (this->regenerate) this->samplesTraced += numRays;
+    }
+
+    /* Past maxSampleCount emitted rays, regeneration drains instead */
+    bool                 emit = this->samplesTraced < this->maxSampleCount;
+    std::vector<int64_t> emitted(this->scheduler->numWorkers(), 0);
+    std::vector<int64_t> completed(this->scheduler->numWorkers(), 0);
+    this->scheduler->run(
+        numRays, RAY_CHUNK_SIZE, [&](int worker, int begin, int end) {
+            if (this->regenerate)
+                emitted[worker] += this->regenerateRays(rayStates.current(),
+                                                        begin,
+                                                        end,
+                                                        uniforms,
+                                                        emit,
+                                                        completed[worker]);
+            this->traceRays(rayStates.current(), rayStates.next(), begin, end);
+        });
+    for (int64_t count : emitted) this->samplesTraced += count;
+    for (int64_t count : completed) this->pathsCompleted += count;
+
+    if (this->spectral)
+    {
+        this->scheduler->run(
+            this->waveBuffers[0].tilesY, 1, [&](int, int begin, int end) {
+                for (int band = begin; band < end; band++)
+                    this->splatSpectralRays(
+                        rayStates.current(), rayStates.next(), numRays, band);
+            });
+    }
+    else
+    {
+        this->scheduler->run(
+            numRays, RAY_CHUNK_SIZE, [&](int worker, int begin, int end) {
+                this->splatRays(rayStates.current(),
+                                rayStates.next(),
+                                begin,
+                                end,
+                                this->waveBuffers[worker]);
+            });
+    }
+
+    this->raysTraced += numRays;
+    this->pathLength += 1;
+
+    /* In regeneration mode a "wave" is just maxPathLength bounces, which
+       paces the reductions into screenBuffer like normal mode. The end of
+       the drain flushes whatever the last bounces splatted */
+    bool drained = this->regenerate && this->finished();
+    if (this->pathLength == this->maxPathLength || this->wavesTraced == 0 ||
+        drained)
+    {
+        this->accumulateWaveBuffers();
+
+        if (this->pathLength == this->maxPathLength)
+        {
+            if (!this->regenerate) this->samplesTraced += numRays;
+            this->wavesTraced += 1;
+            this->pathLength = 0;
+        }
+    }
+
+    rayStates.swap();
+}
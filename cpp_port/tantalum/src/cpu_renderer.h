@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "cpu_framebuffer.h"
+#include "cpu_ray_state.h"
+#include "cpu_scenes.h"
+#include "cpu_scheduler.h"
+#include "emitter.h"
+#include "scene_info.h"
+
+/* Headless counterpart of TRenderer. Runs the work of init-frag.glsl,
+   trace-frag.glsl and the ray-vert.glsl line splat on all cores and
+   accumulates into screenBuffer, which is laid out like the RGBA32F texture
+   of the same name (bottom row first, alpha unused; SPECTRAL_PLANES images
+   stacked in spectral mode) */
+class TCpuRenderer
+{
+public:
+    static constexpr int SPECTRUM_SAMPLES = TEmitter::SPECTRUM_SAMPLES;
+
+    /* Rays per scheduler chunk; 128 rays of both ray states take 17KB (16
+       float arrays and depth each), so a chunk stays in L1. Must be a
+       multiple of TCpuRayState::LANE_PADDING */
+    static constexpr int RAY_CHUNK_SIZE = 128;
+    /* Wavefront mode bins rays by isect.mat in [0, MATERIAL_BINS) */
+    static constexpr int MATERIAL_BINS = 16;
+    /* Framebuffer tiles per scheduler chunk of the wave buffer reduction */
+    static constexpr int TILE_CHUNK_SIZE = 4;
+    /* Depth of a ray whose path has ended once regeneration stopped */
+    static constexpr int RETIRED_DEPTH = 1 << 24;
+
+    TCpuRenderer(int                            width,
+                 int                            height,
+                 const std::vector<TSceneInfo>& scenes,
+                 int                            numThreads = 0);
+
+    void resetActiveBlock();
+
+    void setEmissionSpectrumType(ESpectrumType type);
+
+    void setEmitterTemperature(float temperature);
+
+    void setEmitterGas(int gasId);
+
+    void computeEmissionSpectrum();
+
+    void setMaxPathLength(int length);
+
+    void setMaxSampleCount(int count);
+
+    void changeResolution(int width, int height);
+
+    /* Accumulate SPECTRAL_BINS spectral bins per pixel instead of RGB, and
+       convert them in composite() */
+    void setSpectral(bool spectral);
+
+    /* Only changes what composite() converts the bins to, so it needs no
+       reset */
+    void setSpectralOutput(ESpectralOutput output);
+
+    void changeScene(int idx);
+
+    void reset();
+
+    void setSpreadType(ESpreadType type);
+
+    void setNormalizedEmitterPos(const glm::vec2& posA, const glm::vec2& posB);
+
+    void setEmitterPos(const glm::vec2& posA, const glm::vec2& posB);
+
+    int64_t totalRaysTraced() const;
+
+    int64_t maxRayCount() const;
+
+    int64_t totalSamplesTraced() const;
+
+    float progress() const;
+
+    bool finished() const;
+
+    /* Scale from screenBuffer to the image, one over the paths in it */
+    float exposure() const;
+
+    /* Tonemapped RGBA8 image, top row first, as compose-frag.glsl shows it */
+    void composite(std::vector<unsigned char>& pixels) const;
+
+    /* One bounce of activeBlock rows of rays, see TRenderer::render */
+    void render();
+
+    TEmitter               emitter;
+    std::vector<TCpuScene> scenes;
+    int                    currentScene;
+    bool     needsReset;
+
+    int64_t maxSampleCount;
+    int     maxPathLength;
+    int     raySize;
+    int     rayCount;
+    int64_t wavesTraced;
+    int64_t raysTraced;
+    int64_t samplesTraced;
+    int64_t pathsCompleted;
+
+    std::unique_ptr<TCpuRayStates> rayStates;
+
+    int pathLength;
+    int activeBlock;
+
+    int   width;
+    int   height;
+    float aspect;
+
+    std::vector<float> screenBuffer;
+
+    /* One wave buffer per scheduler worker, so splats never contend. They
+       are summed into screenBuffer where TRenderer composites waveBuffer.
+       Spectral mode keeps a single one, whose bands of tile rows are
+       splatted by different workers, so its memory does not grow with the
+       thread count */
+    int                            numThreads;
+    std::unique_ptr<TCpuScheduler> scheduler;
+    std::vector<TCpuFramebuffer>   waveBuffers;
+
+    /* Reduce only the tiles that were splatted into since the last wave */
+    bool reduceDirtyTilesOnly;
+
+    /* Split the trace pass into an intersect and a shade stage and sort the
+       rays of each chunk by material in between, so each run of one
+       material is shaded in packets (cpu_bsdf_packet.h). The result is the
+       same bit for bit. TRenderer has no counterpart */
+    bool wavefront;
+
+    /* Re-emit rays inside the trace pass as soon as they turn black or
+       reach maxPathLength, instead of carrying them to the end of the wave.
+       samplesTraced then counts emitted rays and pathsCompleted the paths
+       that have ended. Once maxSampleCount rays are emitted, the rays in
+       flight are traced to their end without new ones, and finished()
+       waits for them. TRenderer has no counterpart and always traces whole
+       waves */
+    bool regenerate;
+
+    /* Emit rays carrying four wavelengths until their path disperses, like
+       TRenderer with heroWavelengths set */
+    bool heroWavelengths;
+
+    bool            spectral;
+    ESpectralOutput spectralOutput;
+
+protected:
+    /* Sizes screenBuffer and the wave buffers for width, height and the
+       accumulation mode */
+    void allocateBuffers();
+
+    /* init-frag.glsl for ray i, given its four rand() results */
+    void emitRay(TCpuRayState&           dst,
+                 int                     i,
+                 const TEmitterUniforms& uniforms,
+                 const float             (&rands)[4]);
+
+    void initRays(const TCpuRayState&     src,
+                  TCpuRayState&           dst,
+                  int                     begin,
+                  int                     end,
+                  const TEmitterUniforms& uniforms);
+
+    /* Re-emits the dead rays of [begin, end) in place, or without emit
+       retires them for good. Adds the paths that ended to completed and
+       returns how many rays were emitted */
+    int regenerateRays(TCpuRayState&           state,
+                       int                     begin,
+                       int                     end,
+                       const TEmitterUniforms& uniforms,
+                       bool                    emit,
+                       int64_t&                completed);
+
+    void traceRays(const TCpuRayState& src,
+                   TCpuRayState&       dst,
+                   int                 begin,
+                   int                 end);
+
+    void splatRays(const TCpuRayState& a,
+                   const TCpuRayState& b,
+                   int                 begin,
+                   int                 end,
+                   TCpuFramebuffer&    waveBuffer);
+
+    /* Splats every ray into the TILE_SIZE pixel rows of band of the shared
+       spectral wave buffer */
+    void splatSpectralRays(const TCpuRayState& a,
+                           const TCpuRayState& b,
+                           int                 numRays,
+                           int                 band);
+
+    void accumulateWaveBuffers();
+
+    std::default_random_engine rng;
+};
@@ -0,0 +1,511 @@
+#include "cpu_scenes.h"
+
+#include "cpu_bsdf.h"
+#include "cpu_intersect.h"
+#include "cpu_static_scene.h"
+#include "scene_compiler.h"
+#include "scene_data.h"
+
+using glm::ivec2;
+using glm::vec2;
+using glm::vec3;
+using glm::vec4;
+
+TCpuScene::TCpuScene(const TSceneInfo& scene)
+{
+    this->primitives = scene.primitives;
+    for (int i = 0; i < scene.materialCount(); i++)
+    {
+        this->materials.push_back(scene.material(float(i)));
+    }
+    for (const auto& material : this->materials)
+    {
+        if (material.type != EMaterialType::DIELECTRIC &&
+            material.type != EMaterialType::ROUGH_DIELECTRIC)
+        {
+            this->iorTableOffsets.push_back(-1);
+            continue;
+        }
+        int offset = int(this->iorTables.size());
+        this->iorTableOffsets.push_back(offset);
+        this->iorTables.resize(offset + IOR_SAMPLES);
+        writeIorTexels(material, &this->iorTables[offset]);
+    }
+    for (const auto& polyline : scene.polylines)
+    {
+        this->polylines.emplace_back(polyline);
+    }
+
+    switch (scene.accelerator)
+    {
+        case EAcceleratorType::LINEAR:
+            break;
+        case EAcceleratorType::BVH:
+            this->bvh = std::make_shared<const TSceneBvh>(scene);
+            break;
+        case EAcceleratorType::GRID:
+            this->grid = std::make_shared<const TSceneGrid>(scene);
+            break;
+        case EAcceleratorType::QUADTREE:
+            this->quadtree = std::make_shared<const TSceneQuadtree>(scene);
+            break;
+    }
+
+    if (canCompileSceneCpp(scene))
+    {
+        this->specialized = findStaticScene(sceneFingerprint(scene));
+    }
+}
+
+/* Clips the ray to [lower, upper] and [tMin, tMax] */
+static bool clipRay(vec2                lower,
+                    vec2                upper,
+                    const Ray&          ray,
+                    const Intersection& isect,
+                    float&              tEnter,
+                    float&              tExit)
+{
+    vec2 t1  = (lower - ray.pos) * ray.invDir;
+    vec2 t2  = (upper - ray.pos) * ray.invDir;
+    vec2 tLo = glm::min(t1, t2), tHi = glm::max(t1, t2);
+    tEnter   = glm::max(glm::max(tLo.x, tLo.y), isect.tMin);
+    tExit    = glm::min(glm::min(tHi.x, tHi.y), isect.tMax);
+    return tEnter <= tExit;
+}
+
+/* Amanatides-Woo walk over the cells of a uniform grid that the ray
+   crosses, calling visit(x, y) for each. Every cell lists all primitives
+   overlapping it, so once a hit is closer than the far side of the current
+   cell no later cell can hold a closer one */
+template <typename TVisit>
+static void walkCells(vec2          lower,
+                      vec2          upper,
+                      vec2          cellSize,
+                      ivec2         resolution,
+                      const Ray&    ray,
+                      Intersection& isect,
+                      TVisit        visit)
+{
+    float tEnter, tExit;
+    if (!clipRay(lower, upper, ray, isect, tEnter, tExit)) return;
+
+    vec2 size = vec2(float(resolution.x), float(resolution.y));
+    vec2 far  = glm::max(ray.dirSign, vec2(0.0f));
+    vec2 cell = glm::clamp(
+        glm::floor((ray.pos + ray.dir * tEnter - lower) / cellSize),
+        vec2(0.0f),
+        size - vec2(1.0f));
+    while (true)
+    {
+        visit(int(cell.x), int(cell.y));
+
+        vec2 tNext = (lower + (cell + far) * cellSize - ray.pos) * ray.invDir;
+        if (isect.tMax <= glm::min(tNext.x, tNext.y)) break;
+
+        if (tNext.x < tNext.y)
+            cell.x += ray.dirSign.x;
+        else
+            cell.y += ray.dirSign.y;
+        if (cell.x < 0.0f || cell.y < 0.0f || cell.x >= size.x ||
+            cell.y >= size.y)
+            break;
+    }
+}
+
+/* Calls intersect(ray, isect) with the Ray and Intersection of each lane,
+   for structures every ray takes its own path through */
+template <typename TIntersect>
+static void intersectLanes(const RayPacket&    ray,
+                           IntersectionPacket& isect,
+                           TIntersect          intersect)
+{
+    constexpr int SIZE = vfloat::SIZE;
+    alignas(64) float posX[SIZE], posY[SIZE], dirX[SIZE], dirY[SIZE];
+    alignas(64) float invDirX[SIZE], invDirY[SIZE];
+    alignas(64) float dirSignX[SIZE], dirSignY[SIZE];
+    alignas(64) float tMin[SIZE], tMax[SIZE], nX[SIZE], nY[SIZE], mat[SIZE];
+    ray.posX.store(posX);
+    ray.posY.store(posY);
+    ray.dirX.store(dirX);
+    ray.dirY.store(dirY);
+    ray.invDirX.store(invDirX);
+    ray.invDirY.store(invDirY);
+    ray.dirSignX.store(dirSignX);
+    ray.dirSignY.store(dirSignY);
+    isect.tMin.store(tMin);
+    isect.tMax.store(tMax);
+    isect.nX.store(nX);
+    isect.nY.store(nY);
+    isect.mat.store(mat);
+
+    for (int k = 0; k < SIZE; k++)
+    {
+        Ray lane = {vec2(posX[k], posY[k]),
+                    vec2(dirX[k], dirY[k]),
+                    vec2(invDirX[k], invDirY[k]),
+                    vec2(dirSignX[k], dirSignY[k])};
+        Intersection hit = {tMin[k], tMax[k], vec2(nX[k], nY[k]), mat[k]};
+        intersect(lane, hit);
+        tMax[k] = hit.tMax;
+        nX[k]   = hit.n.x;
+        nY[k]   = hit.n.y;
+        mat[k]  = hit.mat;
+    }
+
+    isect.tMax = vfloat::load(tMax);
+    isect.nX   = vfloat::load(nX);
+    isect.nY   = vfloat::load(nY);
+    isect.mat  = vfloat::load(mat);
+}
+
+/* polylineIntersect of polyline-intersect.glsl */
+static void intersectPolyline(const TPolylineGrid& polyline,
+                              float                matId,
+                              const Ray&           ray,
+                              Intersection&        isect)
+{
+    auto visit = [&](int x, int y) {
+        int c = y * polyline.resolution.x + x;
+        for (int k = polyline.cells[c]; k < polyline.cells[c + 1]; k++)
+        {
+            vec2 a = polyline.decode(x, y, polyline.ends[2 * k]);
+            vec2 b = polyline.decode(x, y, polyline.ends[2 * k + 1]);
+            lineIntersect(ray, a, b, matId, isect);
+        }
+    };
+    walkCells(polyline.lower,
+              polyline.upper,
+              polyline.cellSize,
+              polyline.resolution,
+              ray,
+              isect,
+              visit);
+}
+
+static void intersectPolyline(const TPolylineGrid& polyline,
+                              float                matId,
+                              const RayPacket&     ray,
+                              IntersectionPacket&  isect)
+{
+    intersectLanes(ray, isect, [&](const Ray& lane, Intersection& hit) {
+        intersectPolyline(polyline, matId, lane, hit);
+    });
+}
+
+template <typename TRay, typename TIntersection>
+static void intersectPrimitive(const TCpuScene&       scene,
+                               const TScenePrimitive& p,
+                               const TRay&            ray,
+                               TIntersection&         isect)
+{
+    switch (p.type)
+    {
+        case EPrimitiveType::BBOX:
+            intersectShape<EPrimitiveType::BBOX>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::SPHERE:
+            intersectShape<EPrimitiveType::SPHERE>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::LINE:
+            intersectShape<EPrimitiveType::LINE>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::PRISM:
+            intersectShape<EPrimitiveType::PRISM>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::BICONVEX_LENS:
+            intersectShape<EPrimitiveType::BICONVEX_LENS>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::BICONCAVE_LENS:
+            intersectShape<EPrimitiveType::BICONCAVE_LENS>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::MENISCUS_LENS:
+            intersectShape<EPrimitiveType::MENISCUS_LENS>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::PLANO_CONVEX_LENS:
+            intersectShape<EPrimitiveType::PLANO_CONVEX_LENS>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::PLANO_CONCAVE_LENS:
+            intersectShape<EPrimitiveType::PLANO_CONCAVE_LENS>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::QUADRATIC_BEZIER:
+            intersectShape<EPrimitiveType::QUADRATIC_BEZIER>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::CUBIC_BEZIER:
+            intersectShape<EPrimitiveType::CUBIC_BEZIER>(
+                ray, p.pos, p.size, p.params, p.matId, isect);
+            break;
+        case EPrimitiveType::POLYLINE:
+            intersectPolyline(
+                scene.polylines[int(p.params[0])], p.matId, ray, isect);
+            break;
+    }
+}
+
+template <typename TRay, typename TIntersection>
+static void intersectPrimitives(const TCpuScene&                    scene,
+                                const std::vector<TScenePrimitive>& primitives,
+                                const TRay&                         ray,
+                                TIntersection&                      isect)
+{
+    for (const auto& p : primitives) intersectPrimitive(scene, p, ray, isect);
+}
+
+/* Slab test of a node against [tMin, tMax], as in bvh-intersect.glsl */
+static bool nodeIntersect(const TBvhNode&     node,
+                          const Ray&          ray,
+                          const Intersection& isect)
+{
+    vec2 t1  = (node.lower - ray.pos) * ray.invDir;
+    vec2 t2  = (node.upper - ray.pos) * ray.invDir;
+    vec2 tLo = glm::min(t1, t2), tHi = glm::max(t1, t2);
+    return glm::max(glm::max(tLo.x, tLo.y), isect.tMin) <=
+           glm::min(glm::min(tHi.x, tHi.y), isect.tMax);
+}
+
+static bool nodeIntersect(const TBvhNode&           node,
+                          const RayPacket&          ray,
+                          const IntersectionPacket& isect)
+{
+    vfloat tx1 = (vfloat(node.lower.x) - ray.posX) * ray.invDirX;
+    vfloat tx2 = (vfloat(node.upper.x) - ray.posX) * ray.invDirX;
+    vfloat ty1 = (vfloat(node.lower.y) - ray.posY) * ray.invDirY;
+    vfloat ty2 = (vfloat(node.upper.y) - ray.posY) * ray.invDirY;
+    vfloat tNear = max(max(min(tx1, tx2), min(ty1, ty2)), isect.tMin);
+    vfloat tFar  = min(min(max(tx1, tx2), max(ty1, ty2)), isect.tMax);
+    return any(tNear <= tFar);
+}
+
+/* Whether the left child, with the lower centroids, is the nearer one */
+static bool leftFirst(const Ray& ray, int axis)
+{
+    return ray.dir[axis] >= 0.0f;
+}
+
+static bool leftFirst(const RayPacket& ray, int axis)
+{
+    auto positive = (axis == 0 ? ray.dirX : ray.dirY) >= vfloat(0.0f);
+    int  count    = 0;
+    for (int mask = movemask(positive); mask; mask &= mask - 1) count++;
+    return 2 * count >= vfloat::SIZE;
+}
+
+template <typename TRay, typename TIntersection>
+static void intersectBvh(const TCpuScene& scene,
+                         const TSceneBvh& bvh,
+                         const TRay&      ray,
+                         TIntersection&   isect)
+{
+    intersectPrimitives(scene, bvh.rooms, ray, isect);
+    if (bvh.nodes.empty()) return;
+
+    int stack[TSceneBvh::STACK_SIZE];
+    int size      = 0;
+    stack[size++] = 0;
+    while (size > 0)
+    {
+        const TBvhNode& node = bvh.nodes[stack[--size]];
+        if (!nodeIntersect(node, ray, isect)) continue;
+
+        if (node.count > 0)
+        {
+            for (int k = 0; k < node.count; k++)
+            {
+                intersectPrimitive(
+                    scene, bvh.primitives[node.first + k], ray, isect);
+            }
+        }
+        else
+        {
+            bool left     = leftFirst(ray, node.axis);
+            stack[size++] = node.first + (left ? 1 : 0);
+            stack[size++] = node.first + (left ? 0 : 1);
+        }
+    }
+}
+
+/* Walk over the cells of the scene grid, as in grid-intersect.glsl */
+static void traverseCells(const TCpuScene&  scene,
+                          const TSceneGrid& grid,
+                          const Ray&        ray,
+                          Intersection&     isect)
+{
+    auto visit = [&](int x, int y) {
+        int c = y * grid.resolution.x + x;
+        for (int k = grid.cells[c]; k < grid.cells[c + 1]; k++)
+        {
+            intersectPrimitive(
+                scene, grid.primitives[grid.indices[k]], ray, isect);
+        }
+    };
+    walkCells(grid.lower,
+              grid.upper,
+              grid.cellSize,
+              grid.resolution,
+              ray,
+              isect,
+              visit);
+}
+
+/* Stackless walk over the leaves the ray crosses, as in
+   quadtree-intersect.glsl: every step descends from the root to the leaf
+   the ray is in at distance t, then moves t to the far side of that leaf.
+   A ray right on a split goes to the side it is heading to, comparing t to
+   the same distances the leaves compute for their sides */
+static void traverseCells(const TCpuScene&      scene,
+                          const TSceneQuadtree& quadtree,
+                          const Ray&            ray,
+                          Intersection&         isect)
+{
+    const auto& root = quadtree.nodes[0];
+    float       t, tExit;
+    if (!clipRay(root.lower, root.upper, ray, isect, t, tExit)) return;
+
+    while (true)
+    {
+        const TQuadtreeNode* node = &root;
+        while (node->count < 0)
+        {
+            vec2 mid   = 0.5f * (node->lower + node->upper);
+            vec2 tMid  = (mid - ray.pos) * ray.invDir;
+            bool right = ray.dirSign.x > 0.0f ? t >= tMid.x : t < tMid.x;
+            bool top   = ray.dirSign.y > 0.0f ? t >= tMid.y : t < tMid.y;
+            int  child = (right ? 1 : 0) + (top ? 2 : 0);
+            node       = &quadtree.nodes[node->first + child];
+        }
+
+        for (int k = node->first; k < node->first + node->count; k++)
+        {
+            intersectPrimitive(
+                scene, quadtree.primitives[quadtree.indices[k]], ray, isect);
+        }
+
+        vec2  side;
+        side.x       = ray.dirSign.x > 0.0f ? node->upper.x : node->lower.x;
+        side.y       = ray.dirSign.y > 0.0f ? node->upper.y : node->lower.y;
+        vec2  tSide  = (side - ray.pos) * ray.invDir;
+        float tLeave = glm::min(tSide.x, tSide.y);
+        if (isect.tMax <= tLeave || tLeave >= tExit) break;
+        t = tLeave;
+    }
+}
+
+template <typename TAccelerator>
+static void intersectCells(const TCpuScene&    scene,
+                           const TAccelerator& accelerator,
+                           const Ray&          ray,
+                           Intersection&       isect)
+{
+    intersectPrimitives(scene, accelerator.rooms, ray, isect);
+    if (accelerator.primitives.empty()) return;
+    traverseCells(scene, accelerator, ray, isect);
+}
+
+/* Every ray takes its own path through the grid and quadtree cells, so
+   packets walk them one lane at a time after intersecting the rooms */
+template <typename TAccelerator>
+static void intersectCells(const TCpuScene&    scene,
+                           const TAccelerator& accelerator,
+                           const RayPacket&    ray,
+                           IntersectionPacket& isect)
+{
+    intersectPrimitives(scene, accelerator.rooms, ray, isect);
+    if (accelerator.primitives.empty()) return;
+    intersectLanes(ray, isect, [&](const Ray& lane, Intersection& hit) {
+        traverseCells(scene, accelerator, lane, hit);
+    });
+}
+
+void TCpuScene::intersect(const Ray& ray, Intersection& isect) const
+{
+    if (this->specialized)
+        this->specialized->intersect(ray, isect);
+    else if (this->bvh)
+        intersectBvh(*this, *this->bvh, ray, isect);
+    else if (this->grid)
+        intersectCells(*this, *this->grid, ray, isect);
+    else if (this->quadtree)
+        intersectCells(*this, *this->quadtree, ray, isect);
+    else
+        intersectPrimitives(*this, this->primitives, ray, isect);
+}
+
+void TCpuScene::intersectPacket(const RayPacket&    ray,
+                                IntersectionPacket& isect) const
+{
+    if (this->specialized)
+        this->specialized->intersectPacket(ray, isect);
+    else if (this->bvh)
+        intersectBvh(*this, *this->bvh, ray, isect);
+    else if (this->grid)
+        intersectCells(*this, *this->grid, ray, isect);
+    else if (this->quadtree)
+        intersectCells(*this, *this->quadtree, ray, isect);
+    else
+        intersectPrimitives(*this, this->primitives, ray, isect);
+}
+
+vec2 TCpuScene::sample(vec4&               state,
+                       const Intersection& isect,
+                       float               lambda,
+                       vec2                wiLocal,
+                       vec3&               throughput) const
+{
+    if (this->specialized)
+    {
+        return this->specialized->sample(
+            state, isect, lambda, wiLocal, throughput);
+    }
+
+    int                   id = int(isect.mat);
+    const TSceneMaterial* m  = &this->materials[id];
+
+    float ior = 0.0f;
+    if (m->type == EMaterialType::DIELECTRIC ||
+        m->type == EMaterialType::ROUGH_DIELECTRIC)
+    {
+        ior = tableIor(&this->iorTables[this->iorTableOffsets[id]], lambda);
+    }
+
+    switch (m->type)
+    {
+        case EMaterialType::MIRROR:
+            return sampleMirror(wiLocal);
+        case EMaterialType::ROUGH_MIRROR:
+            return sampleRoughMirror(state, wiLocal, throughput, m->roughness);
+        case EMaterialType::DIELECTRIC:
+            return sampleDielectric(state, wiLocal, ior);
+        case EMaterialType::ROUGH_DIELECTRIC:
+            return sampleRoughDielectric(state, wiLocal, m->roughness, ior);
+        default:
+            if (m->faceAlbedo && isect.n.x == -1.0f)
+                throughput *= m->leftAlbedo;
+            else if (m->faceAlbedo && isect.n.x == 1.0f)
+                throughput *= m->rightAlbedo;
+            else
+                throughput *= m->albedo;
+            return sampleDiffuse(state, wiLocal);
+    }
+}
+
+bool TCpuScene::dispersive(const Intersection& isect) const
+{
+    return this->dispersive(int(isect.mat));
+}
+
+bool TCpuScene::dispersive(int matId) const
+{
+    const TSceneMaterial& m = this->materials[matId];
+    return (m.type == EMaterialType::DIELECTRIC ||
+            m.type == EMaterialType::ROUGH_DIELECTRIC) &&
+           m.sellmeierC != glm::vec3(0.0f);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "cpu_intersect.h"
+#include "cpu_intersect_packet.h"
+#include "scene_bvh.h"
+#include "scene_grid.h"
+#include "scene_info.h"
+#include "scene_polyline.h"
+
+struct TStaticSceneEntry;
+
+/* intersect()/sample() of a scene file, evaluated from its primitive and
+   material lists. Each call makes the same calls with the same arguments as
+   the trace program makes from the SceneData of the scene; intersectPacket is
+   intersect() over vfloat::SIZE rays. Scenes with an accelerator traverse
+   it like the GLSL does; packets descend into a BVH node while any of
+   their rays overlaps it, and walk grid and quadtree cells ray by ray.
+   Built-in scenes without accelerator or polylines run the TStaticScene
+   generated for them instead, if their file is unchanged */
+class TCpuScene
+{
+public:
+    explicit TCpuScene(const TSceneInfo& scene);
+
+    void intersect(const Ray& ray, Intersection& isect) const;
+
+    void intersectPacket(const RayPacket& ray, IntersectionPacket& isect) const;
+
+    glm::vec2 sample(glm::vec4&          state,
+                     const Intersection& isect,
+                     float               lambda,
+                     glm::vec2           wiLocal,
+                     glm::vec3&          throughput) const;
+
+    /* dispersive() of material-data.glsl */
+    bool dispersive(const Intersection& isect) const;
+
+    bool dispersive(int matId) const;
+
+    std::vector<TScenePrimitive> primitives;
+    /* The material table of material-data.glsl, indexed by id */
+    std::vector<TSceneMaterial> materials;
+    /* The IorData texels of the dielectrics, IOR_SAMPLES each */
+    std::vector<float> iorTables;
+    /* Start of the texels of each material id in iorTables, -1 unless the
+       material is a dielectric */
+    std::vector<int> iorTableOffsets;
+
+    /* The one of scene.accelerator, all null for EAcceleratorType::LINEAR */
+    std::shared_ptr<const TSceneBvh>      bvh;
+    std::shared_ptr<const TSceneGrid>     grid;
+    std::shared_ptr<const TSceneQuadtree> quadtree;
+
+    /* One per scene.polylines, indexed by params[0] of their primitives */
+    std::vector<TPolylineGrid> polylines;
+
+    /* Set by the constructor when findStaticScene knows the scene; clear it
+       to evaluate the lists above */
+    const TStaticSceneEntry* specialized = nullptr;
+};
@@ -0,0 +1,148 @@
+#include "cpu_scheduler.h"
+
+#include <algorithm>
+
+TCpuScheduler::TCpuScheduler(int numThreads)
+{
+    this->workerCount = std::max(numThreads, 1);
+    this->ranges      = std::make_unique<TWorkerRange[]>(this->workerCount);
+    this->generation  = 0;
+    this->running     = 0;
+    this->quit        = false;
+    this->task        = nullptr;
+    this->count       = 0;
+    this->chunkSize   = 1;
+
+    for (int w = 0; w < this->workerCount; w++)
+    {
+        this->ranges[w].range.store(0);
+    }
+    for (int w = 1; w < this->workerCount; w++)
+    {
+        this->threads.emplace_back(&TCpuScheduler::workerLoop, this, w);
+    }
+}
+
+TCpuScheduler::~TCpuScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->quit = true;
+    }
+    this->wakeCondition.notify_all();
+
+    for (auto& thread : this->threads) thread.join();
+}
+
+void TCpuScheduler::run(int count, int chunkSize, const TTask& task)
+{
+    int chunks = (count + chunkSize - 1) / chunkSize;
+
+    /* Workers are parked, so the ranges can be set without contention */
+    for (int w = 0; w < this->workerCount; w++)
+    {
+        this->ranges[w].range.store(
+            packRange(uint32_t(int64_t(chunks) * w / this->workerCount),
+                      uint32_t(int64_t(chunks) * (w + 1) / this->workerCount)),
+            std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task      = &task;
+        this->count     = count;
+        this->chunkSize = chunkSize;
+        this->running   = this->workerCount - 1;
+        this->generation++;
+    }
+    this->wakeCondition.notify_all();
+
+    this->work(0);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [this] { return this->running == 0; });
+}
+
+void TCpuScheduler::workerLoop(int worker)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wakeCondition.wait(lock, [&] {
+                return this->quit || this->generation != seen;
+            });
+            if (this->quit) return;
+            seen = this->generation;
+        }
+
+        this->work(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (--this->running == 0) this->doneCondition.notify_one();
+        }
+    }
+}
+
+void TCpuScheduler::work(int worker)
+{
+    uint32_t chunk;
+    do
+    {
+        while (this->popChunk(worker, chunk))
+        {
+            int begin = int(chunk) * this->chunkSize;
+            int end   = std::min(begin + this->chunkSize, this->count);
+            (*this->task)(worker, begin, end);
+        }
+    } while (this->stealChunks(worker));
+}
+
+bool TCpuScheduler::popChunk(int worker, uint32_t& chunk)
+{
+    auto&    range = this->ranges[worker].range;
+    uint64_t r     = range.load(std::memory_order_acquire);
+    while (rangeBegin(r) < rangeEnd(r))
+    {
+        if (range.compare_exchange_weak(
+                r,
+                packRange(rangeBegin(r) + 1, rangeEnd(r)),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire))
+        {
+            chunk = rangeBegin(r);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TCpuScheduler::stealChunks(int worker)
+{
+    for (int k = 1; k < this->workerCount; k++)
+    {
+        int      victim = (worker + k) % this->workerCount;
+        auto&    range  = this->ranges[victim].range;
+        uint64_t r      = range.load(std::memory_order_acquire);
+        while (rangeBegin(r) < rangeEnd(r))
+        {
+            /* Take the back half, rounded up so a single chunk moves too */
+            uint32_t begin = rangeBegin(r);
+            uint32_t end   = rangeEnd(r);
+            uint32_t mid   = end - (end - begin + 1) / 2;
+            if (range.compare_exchange_weak(r,
+                                            packRange(begin, mid),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+            {
+                /* Our own range is empty, so nobody else writes it now */
+                this->ranges[worker].range.store(packRange(mid, end),
+                                                 std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
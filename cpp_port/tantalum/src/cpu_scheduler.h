@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Persistent worker threads that run one parallel loop at a time.
+
+   run() splits [0, count) into chunks and hands every worker a contiguous
+   range of them. A range is a single 64 bit atomic holding {begin, end}
+   chunk indices: the owner takes chunks off the front, and a worker that
+   runs dry steals the back half of another worker's range, both with one
+   compare-and-swap and without locks. The calling thread takes part as
+   worker 0 */
+class TCpuScheduler
+{
+public:
+    typedef std::function<void(int worker, int begin, int end)> TTask;
+
+    explicit TCpuScheduler(int numThreads);
+
+    ~TCpuScheduler();
+
+    TCpuScheduler(const TCpuScheduler&) = delete;
+    TCpuScheduler& operator=(const TCpuScheduler&) = delete;
+
+    int numWorkers() const
+    {
+        return this->workerCount;
+    }
+
+    /* Calls task(worker, begin, end) for every chunk of [0, count) and
+       returns when all are done. Chunks start on multiples of chunkSize and
+       end on the next one or at count */
+    void run(int count, int chunkSize, const TTask& task);
+
+private:
+    struct alignas(64) TWorkerRange
+    {
+        std::atomic<uint64_t> range;
+    };
+
+    static uint64_t packRange(uint32_t begin, uint32_t end)
+    {
+        return (uint64_t(begin) << 32) | end;
+    }
+
+    static uint32_t rangeBegin(uint64_t range)
+    {
+        return uint32_t(range >> 32);
+    }
+
+    static uint32_t rangeEnd(uint64_t range)
+    {
+        return uint32_t(range);
+    }
+
+    void workerLoop(int worker);
+
+    void work(int worker);
+
+    bool popChunk(int worker, uint32_t& chunk);
+
+    bool stealChunks(int worker);
+
+    int                             workerCount;
+    std::unique_ptr<TWorkerRange[]> ranges;
+    std::vector<std::thread>        threads;
+
+    std::mutex              mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    uint64_t                generation;
+    int                     running;
+    bool                    quit;
+
+    const TTask* task;
+    int          count;
+    int          chunkSize;
+};
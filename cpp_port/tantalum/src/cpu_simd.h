@@ -0,0 +1,417 @@
+#pragma once
+
+#include <immintrin.h>
+
+/* Thin wrappers over SSE and AVX2 registers, so the packet kernels can be
+   written once as templates over the lane type. Comparisons return all-ones
+   lane masks which select() consumes.
+
+   min() and max() take their operands in the order glm::min/glm::max test
+   them, which keeps packet results bit-identical to the scalar mirrors for
+   signed zeros and NaNs as well */
+
+struct vbool4
+{
+    __m128 m;
+
+    vbool4() = default;
+    vbool4(__m128 m) : m(m)
+    {
+    }
+};
+
+inline vbool4 operator&(vbool4 a, vbool4 b)
+{
+    return _mm_and_ps(a.m, b.m);
+}
+
+inline vbool4 operator|(vbool4 a, vbool4 b)
+{
+    return _mm_or_ps(a.m, b.m);
+}
+
+inline vbool4 operator~(vbool4 a)
+{
+    return _mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+}
+
+/* a & ~b */
+inline vbool4 andNot(vbool4 a, vbool4 b)
+{
+    return _mm_andnot_ps(b.m, a.m);
+}
+
+inline int movemask(vbool4 a)
+{
+    return _mm_movemask_ps(a.m);
+}
+
+inline bool any(vbool4 a)
+{
+    return movemask(a) != 0;
+}
+
+inline bool none(vbool4 a)
+{
+    return movemask(a) == 0;
+}
+
+struct vfloat4
+{
+    static constexpr int SIZE = 4;
+    typedef vbool4 Mask;
+
+    __m128 v;
+
+    vfloat4() = default;
+    vfloat4(__m128 v) : v(v)
+    {
+    }
+    vfloat4(float f) : v(_mm_set1_ps(f))
+    {
+    }
+
+    /* {0, 1, 2, 3} */
+    static vfloat4 laneIndices()
+    {
+        return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    }
+
+    /* p must be 16 byte aligned */
+    static vfloat4 load(const float* p)
+    {
+        return _mm_load_ps(p);
+    }
+
+    void store(float* p) const
+    {
+        _mm_store_ps(p, this->v);
+    }
+};
+
+inline vfloat4 operator+(vfloat4 a, vfloat4 b)
+{
+    return _mm_add_ps(a.v, b.v);
+}
+
+inline vfloat4 operator-(vfloat4 a, vfloat4 b)
+{
+    return _mm_sub_ps(a.v, b.v);
+}
+
+inline vfloat4 operator*(vfloat4 a, vfloat4 b)
+{
+    return _mm_mul_ps(a.v, b.v);
+}
+
+inline vfloat4 operator/(vfloat4 a, vfloat4 b)
+{
+    return _mm_div_ps(a.v, b.v);
+}
+
+/* Sign flip, exactly like scalar negation */
+inline vfloat4 operator-(vfloat4 a)
+{
+    return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f));
+}
+
+inline vbool4 operator<(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmplt_ps(a.v, b.v);
+}
+
+inline vbool4 operator<=(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmple_ps(a.v, b.v);
+}
+
+inline vbool4 operator>(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmpgt_ps(a.v, b.v);
+}
+
+inline vbool4 operator>=(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmpge_ps(a.v, b.v);
+}
+
+inline vbool4 operator==(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmpeq_ps(a.v, b.v);
+}
+
+inline vbool4 operator!=(vfloat4 a, vfloat4 b)
+{
+    return _mm_cmpneq_ps(a.v, b.v);
+}
+
+/* mask ? a : b, per lane */
+inline vfloat4 select(vbool4 mask, vfloat4 a, vfloat4 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask.m, a.v), _mm_andnot_ps(mask.m, b.v));
+}
+
+/* (b < a) ? b : a, like glm::min(a, b) */
+inline vfloat4 min(vfloat4 a, vfloat4 b)
+{
+    return _mm_min_ps(b.v, a.v);
+}
+
+/* (a < b) ? b : a, like glm::max(a, b) */
+inline vfloat4 max(vfloat4 a, vfloat4 b)
+{
+    return _mm_max_ps(b.v, a.v);
+}
+
+inline vfloat4 sqrt(vfloat4 a)
+{
+    return _mm_sqrt_ps(a.v);
+}
+
+inline vfloat4 abs(vfloat4 a)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);
+}
+
+/* SSE2 has no roundps; truncate and step down where that rounded up. The
+   sign of a is kept so -0 stays -0, and values too large to have a
+   fraction pass through unchanged */
+inline vfloat4 floor(vfloat4 a)
+{
+    __m128 t    = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    __m128 up   = _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f));
+    __m128 sign = _mm_and_ps(a.v, _mm_set1_ps(-0.0f));
+    t           = _mm_or_ps(_mm_sub_ps(t, up), sign);
+    return select(abs(a) < vfloat4(8388608.0f), vfloat4(t), a);
+}
+
+inline vfloat4 ceil(vfloat4 a)
+{
+    return -floor(-a);
+}
+
+/* 2^n for integral n in [-126, 127] */
+inline vfloat4 exp2i(vfloat4 n)
+{
+    __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127));
+    return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+}
+
+#if defined(__AVX2__)
+
+struct vbool8
+{
+    __m256 m;
+
+    vbool8() = default;
+    vbool8(__m256 m) : m(m)
+    {
+    }
+};
+
+inline vbool8 operator&(vbool8 a, vbool8 b)
+{
+    return _mm256_and_ps(a.m, b.m);
+}
+
+inline vbool8 operator|(vbool8 a, vbool8 b)
+{
+    return _mm256_or_ps(a.m, b.m);
+}
+
+inline vbool8 operator~(vbool8 a)
+{
+    return _mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+}
+
+/* a & ~b */
+inline vbool8 andNot(vbool8 a, vbool8 b)
+{
+    return _mm256_andnot_ps(b.m, a.m);
+}
+
+inline int movemask(vbool8 a)
+{
+    return _mm256_movemask_ps(a.m);
+}
+
+inline bool any(vbool8 a)
+{
+    return movemask(a) != 0;
+}
+
+inline bool none(vbool8 a)
+{
+    return movemask(a) == 0;
+}
+
+struct vfloat8
+{
+    static constexpr int SIZE = 8;
+    typedef vbool8 Mask;
+
+    __m256 v;
+
+    vfloat8() = default;
+    vfloat8(__m256 v) : v(v)
+    {
+    }
+    vfloat8(float f) : v(_mm256_set1_ps(f))
+    {
+    }
+
+    static vfloat8 laneIndices()
+    {
+        return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    }
+
+    /* p must be 32 byte aligned */
+    static vfloat8 load(const float* p)
+    {
+        return _mm256_load_ps(p);
+    }
+
+    void store(float* p) const
+    {
+        _mm256_store_ps(p, this->v);
+    }
+};
+
+inline vfloat8 operator+(vfloat8 a, vfloat8 b)
+{
+    return _mm256_add_ps(a.v, b.v);
+}
+
+inline vfloat8 operator-(vfloat8 a, vfloat8 b)
+{
+    return _mm256_sub_ps(a.v, b.v);
+}
+
+inline vfloat8 operator*(vfloat8 a, vfloat8 b)
+{
+    return _mm256_mul_ps(a.v, b.v);
+}
+
+inline vfloat8 operator/(vfloat8 a, vfloat8 b)
+{
+    return _mm256_div_ps(a.v, b.v);
+}
+
+inline vfloat8 operator-(vfloat8 a)
+{
+    return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f));
+}
+
+/* Ordered, non-signalling predicates, matching the scalar operators */
+inline vbool8 operator<(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline vbool8 operator<=(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ);
+}
+
+inline vbool8 operator>(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline vbool8 operator>=(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ);
+}
+
+inline vbool8 operator==(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ);
+}
+
+inline vbool8 operator!=(vfloat8 a, vfloat8 b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ);
+}
+
+inline vfloat8 select(vbool8 mask, vfloat8 a, vfloat8 b)
+{
+    return _mm256_blendv_ps(b.v, a.v, mask.m);
+}
+
+inline vfloat8 min(vfloat8 a, vfloat8 b)
+{
+    return _mm256_min_ps(b.v, a.v);
+}
+
+inline vfloat8 max(vfloat8 a, vfloat8 b)
+{
+    return _mm256_max_ps(b.v, a.v);
+}
+
+inline vfloat8 sqrt(vfloat8 a)
+{
+    return _mm256_sqrt_ps(a.v);
+}
+
+inline vfloat8 abs(vfloat8 a)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v);
+}
+
+inline vfloat8 floor(vfloat8 a)
+{
+    return _mm256_floor_ps(a.v);
+}
+
+inline vfloat8 ceil(vfloat8 a)
+{
+    return _mm256_ceil_ps(a.v);
+}
+
+inline vfloat8 exp2i(vfloat8 n)
+{
+    __m256i e =
+        _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+}
+
+#endif
+
+/* e^x within a few ulp, the range reduction and polynomial of Cephes
+   expf. x is clamped to [-87, 88], where neither e^x nor 2^n leave the
+   normal range */
+template <typename T>
+inline T expPacket(T x)
+{
+    x   = min(max(x, T(-87.0f)), T(88.0f));
+    T n = floor(x * T(1.44269504f) + T(0.5f));
+    T r = x - n * T(0.693359375f) + n * T(2.12194440e-4f);
+
+    T p = T(1.9875691500e-4f);
+    p   = p * r + T(1.3981999507e-3f);
+    p   = p * r + T(8.3334519073e-3f);
+    p   = p * r + T(4.1665795894e-2f);
+    p   = p * r + T(1.6666665459e-1f);
+    p   = p * r + T(5.0000001201e-1f);
+    p   = p * r * r + r + T(1.0f);
+    return p * exp2i(n);
+}
+
+inline vfloat4 exp(vfloat4 x)
+{
+    return expPacket(x);
+}
+
+#if defined(__AVX2__)
+inline vfloat8 exp(vfloat8 x)
+{
+    return expPacket(x);
+}
+#endif
+
+/* Widest packet the build targets; TANTALUM_AVX2 in CMakeLists.txt */
+#if defined(__AVX2__)
+typedef vfloat8 vfloat;
+#else
+typedef vfloat4 vfloat;
+#endif
@@ -0,0 +1,237 @@
+#include "cpu_splat.h"
+
+#include <algorithm>
+
+#include "cpu_simd.h"
+#include "emitter.h"
+
+/* Emits the fragments of one set-up segment, a packet of pixel columns
+   (rows) at a time, into the given plane. u is the major and v the minor
+   window axis; fragments with v outside [minorBegin, minorEnd) are
+   dropped */
+static void rasterizeSpan(TCpuFramebuffer& buffer,
+                          int              plane,
+                          bool             xMajor,
+                          int              first,
+                          int              last,
+                          float            u0,
+                          float            v0,
+                          float            slope,
+                          int              minorBegin,
+                          int              minorEnd,
+                          __m128           color)
+{
+    constexpr int SIZE = vfloat::SIZE;
+    constexpr int TILE = TCpuFramebuffer::TILE_SIZE;
+
+    int   majorStride = xMajor ? 1 : buffer.width;
+    int   minorStride = xMajor ? buffer.width : 1;
+    int   majorTile   = xMajor ? 1 : buffer.tilesX;
+    int   minorTile   = xMajor ? buffer.tilesX : 1;
+
+    float*   pixels = buffer.pixels.data() +
+                    size_t(plane) * buffer.width * buffer.height * 4;
+    uint8_t* dirty  = buffer.dirty.data();
+
+    alignas(64) float minor[SIZE];
+
+    for (int i = first; i < last; i += SIZE)
+    {
+        vfloat u = vfloat(float(i)) + vfloat::laneIndices();
+        vfloat v = floor(vfloat(v0) +
+                         ((u + vfloat(0.5f)) - vfloat(u0)) * vfloat(slope));
+        int inside = movemask((v >= vfloat(float(minorBegin))) &
+                              (v < vfloat(float(minorEnd))));
+        v.store(minor);
+
+        int count = std::min(SIZE, last - i);
+        for (int lane = 0; lane < count; lane++)
+        {
+            if (!((inside >> lane) & 1)) continue;
+
+            int    k     = i + lane;
+            int    j     = int(minor[lane]);
+            float* pixel = pixels + (k * majorStride + j * minorStride) * 4;
+            _mm_store_ps(pixel, _mm_add_ps(_mm_load_ps(pixel), color));
+
+            dirty[(k / TILE) * majorTile + (j / TILE) * minorTile] = 1;
+        }
+    }
+}
+
+static void splat(const TCpuRayState& a,
+                  const TCpuRayState& b,
+                  int                 begin,
+                  int                 end,
+                  float               aspect,
+                  bool                spectral,
+                  int                 rowBegin,
+                  int                 rowEnd,
+                  TCpuFramebuffer&    buffer)
+{
+    constexpr int SIZE = vfloat::SIZE;
+
+    bool partial = rowBegin > 0 || rowEnd < buffer.height;
+
+    vfloat halfWidth  = vfloat(0.5f * buffer.width);
+    vfloat halfHeight = vfloat(0.5f * buffer.height);
+    vfloat width      = vfloat(float(buffer.width));
+    vfloat height     = vfloat(float(buffer.height));
+
+    alignas(64) float u0[SIZE], v0[SIZE], slope[SIZE];
+    alignas(64) float first[SIZE], last[SIZE];
+    alignas(64) float red[SIZE], green[SIZE], blue[SIZE], lambda[SIZE];
+
+    for (int i = begin; i < end; i += SIZE)
+    {
+        vfloat posAX = vfloat::load(&a.posX[i]);
+        vfloat posAY = vfloat::load(&a.posY[i]);
+        vfloat posBX = vfloat::load(&b.posX[i]);
+        vfloat posBY = vfloat::load(&b.posY[i]);
+
+        /* ray-vert.glsl */
+        vfloat dirX = posBX - posAX;
+        vfloat dirY = posBY - posAY;
+        vfloat bias = min(max(sqrt(dirX * dirX + dirY * dirY) /
+                                  max(abs(dirX), abs(dirY)),
+                              vfloat(1.0f)),
+                          vfloat(1.414214f));
+
+        vfloat colorR = vfloat::load(&a.r[i]) * bias;
+        vfloat colorG = vfloat::load(&a.g[i]) * bias;
+        vfloat colorB = vfloat::load(&a.b[i]) * bias;
+
+        /* gl_Position and the viewport transform */
+        vfloat x0 = halfWidth * (posAX / vfloat(aspect)) + halfWidth;
+        vfloat y0 = halfHeight * posAY + halfHeight;
+        vfloat x1 = halfWidth * (posBX / vfloat(aspect)) + halfWidth;
+        vfloat y1 = halfHeight * posBY + halfHeight;
+
+        /* Swap into the major axis frame and orient along +u */
+        auto   xMajor = abs(x1 - x0) >= abs(y1 - y0);
+        vfloat uA     = select(xMajor, x0, y0);
+        vfloat vA     = select(xMajor, y0, x0);
+        vfloat uB     = select(xMajor, x1, y1);
+        vfloat vB     = select(xMajor, y1, x1);
+
+        auto   flip = uB < uA;
+        vfloat uBeg = select(flip, uB, uA);
+        vfloat vBeg = select(flip, vB, vA);
+        vfloat uEnd = select(flip, uA, uB);
+        vfloat vEnd = select(flip, vA, vB);
+
+        /* Pixel centers in [uBeg, uEnd), clipped to the viewport. NaNs and
+           degenerate or black segments leave an empty span */
+        vfloat major     = select(xMajor, width, height);
+        vfloat spanFirst = max(ceil(uBeg - vfloat(0.5f)), vfloat(0.0f));
+        vfloat spanLast  = min(ceil(uEnd - vfloat(0.5f)), major);
+
+        auto black = (colorR == vfloat(0.0f)) & (colorG == vfloat(0.0f)) &
+                     (colorB == vfloat(0.0f));
+        auto empty = ~(spanLast > spanFirst) | (uEnd == uBeg) | black;
+
+        /* Segments a pixel or more clear of the rows are skipped here; the
+           rest are clipped exactly below */
+        empty = empty | (max(y0, y1) < vfloat(float(rowBegin - 1))) |
+                (min(y0, y1) > vfloat(float(rowEnd + 1)));
+
+        uBeg.store(u0);
+        vBeg.store(v0);
+        ((vEnd - vBeg) / (uEnd - uBeg)).store(slope);
+        spanFirst.store(first);
+        spanLast.store(last);
+        colorR.store(red);
+        colorG.store(green);
+        colorB.store(blue);
+        vfloat::load(&a.lambda[i]).store(lambda);
+
+        int majorMask = movemask(xMajor);
+        int emptyMask = movemask(empty);
+
+        int count = std::min(SIZE, end - i);
+        for (int lane = 0; lane < count; lane++)
+        {
+            if ((emptyMask >> lane) & 1) continue;
+
+            int    plane = 0;
+            __m128 color =
+                _mm_setr_ps(red[lane], green[lane], blue[lane], 0.0f);
+            if (spectral)
+            {
+                int bin = int((lambda[lane] - LAMBDA_MIN) /
+                              (LAMBDA_MAX - LAMBDA_MIN) * SPECTRAL_BINS);
+                bin     = std::min(std::max(bin, 0), SPECTRAL_BINS - 1);
+
+                alignas(16) float binColor[4] = {};
+                binColor[bin % 4] = red[lane] + green[lane] + blue[lane];
+                plane             = bin / 4;
+                color             = _mm_load_ps(binColor);
+            }
+
+            /* Rows are the minor axis of x major segments, whose columns
+               are narrowed to about where they cross the rows, and the
+               major axis of the others */
+            bool  xMajor     = (majorMask >> lane) & 1;
+            float spanBegin  = first[lane];
+            float spanEnd    = last[lane];
+            int   minorBegin = 0;
+            int   minorEnd   = buffer.width;
+            if (!xMajor)
+            {
+                spanBegin = std::max(spanBegin, float(rowBegin));
+                spanEnd   = std::min(spanEnd, float(rowEnd));
+            }
+            else
+            {
+                minorBegin = rowBegin;
+                minorEnd   = rowEnd;
+                if (partial && slope[lane] != 0.0f)
+                {
+                    float uA = u0[lane] - 0.5f +
+                               (float(rowBegin) - v0[lane]) / slope[lane];
+                    float uB = u0[lane] - 0.5f +
+                               (float(rowEnd) - v0[lane]) / slope[lane];
+                    float uMin = std::floor(std::min(uA, uB)) - 1.0f;
+                    float uMax = std::ceil(std::max(uA, uB)) + 1.0f;
+                    spanBegin  = std::max(spanBegin, uMin);
+                    spanEnd    = std::min(spanEnd, uMax);
+                }
+            }
+            if (!(spanEnd > spanBegin)) continue;
+
+            rasterizeSpan(buffer,
+                          plane,
+                          xMajor,
+                          int(spanBegin),
+                          int(spanEnd),
+                          u0[lane],
+                          v0[lane],
+                          slope[lane],
+                          minorBegin,
+                          minorEnd,
+                          color);
+        }
+    }
+}
+
+void splatSegments(const TCpuRayState& a,
+                   const TCpuRayState& b,
+                   int                 begin,
+                   int                 end,
+                   float               aspect,
+                   TCpuFramebuffer&    buffer)
+{
+    splat(a, b, begin, end, aspect, false, 0, buffer.height, buffer);
+}
+
+void splatSpectralSegments(const TCpuRayState& a,
+                           const TCpuRayState& b,
+                           int                 begin,
+                           int                 end,
+                           float               aspect,
+                           int                 rowBegin,
+                           int                 rowEnd,
+                           TCpuFramebuffer&    buffer)
+{
+    splat(a, b, begin, end, aspect, true, rowBegin, rowEnd, buffer);
+}
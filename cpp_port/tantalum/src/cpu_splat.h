@@ -0,0 +1,35 @@
+#pragma once
+
+#include "cpu_framebuffer.h"
+#include "cpu_ray_state.h"
+
+/* The ray pass of TRenderer: for every ray in [begin, end), draws the
+   GL_LINES segment from its position in a to its position in b with the
+   colour of a scaled by the biasCorrection of ray-vert.glsl, and adds it to
+   buffer.
+
+   Rays are mapped to window coordinates through gl_Position = (x / Aspect,
+   y) and the viewport transform. The segment is sampled like GL rasterizes
+   lines, with one fragment per pixel column (row) along the major axis at
+   the pixel centers the half-open segment covers, clipped exactly to the
+   viewport. begin must be a multiple of TCpuRayState::LANE_PADDING */
+void splatSegments(const TCpuRayState& a,
+                   const TCpuRayState& b,
+                   int                 begin,
+                   int                 end,
+                   float               aspect,
+                   TCpuFramebuffer&    buffer);
+
+/* splatSegments for spectral accumulation: buffer has SPECTRAL_PLANES planes
+   and each segment adds its summed colour to the spectral bin of the
+   wavelength of a, see ray-vert.glsl. Only the fragments in the pixel rows
+   [rowBegin, rowEnd) are drawn, so workers splatting disjoint rows can share
+   one buffer rather than keep one each */
+void splatSpectralSegments(const TCpuRayState& a,
+                           const TCpuRayState& b,
+                           int                 begin,
+                           int                 end,
+                           float               aspect,
+                           int                 rowBegin,
+                           int                 rowEnd,
+                           TCpuFramebuffer&    buffer);
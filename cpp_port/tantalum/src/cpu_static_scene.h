@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <tuple>
+#include <type_traits>
+
+#include "cpu_bsdf.h"
+#include "cpu_csg_intersect.h"
+#include "cpu_csg_intersect_packet.h"
+#include "cpu_curve_intersect.h"
+#include "cpu_curve_intersect_packet.h"
+#include "cpu_intersect.h"
+#include "cpu_intersect_packet.h"
+#include "scene_info.h"
+
+/* The call of intersect() for a primitive of type TYPE, shared by the
+   primitive list of TCpuScene and the built-in scenes below. Polylines need
+   the grids of TCpuScene and are not handled here */
+template <EPrimitiveType TYPE, typename TRay, typename TIntersection>
+inline void intersectShape(const TRay&    ray,
+                           glm::vec2      pos,
+                           glm::vec2      size,
+                           const float*   params,
+                           float          matId,
+                           TIntersection& isect)
+{
+    static_assert(TYPE != EPrimitiveType::POLYLINE,
+                  "polylines are intersected through TCpuScene::polylines");
+
+    if constexpr (TYPE == EPrimitiveType::BBOX)
+        bboxIntersect(ray, pos, size, matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::SPHERE)
+        sphereIntersect(ray, pos, params[0], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::LINE)
+        lineIntersect(ray, pos, size, matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::PRISM)
+        prismIntersect(ray, pos, params[0], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::BICONVEX_LENS)
+        biconvexLensIntersect(
+            ray, pos, params[0], params[1], params[2], params[3], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::BICONCAVE_LENS)
+        biconcaveLensIntersect(
+            ray, pos, params[0], params[1], params[2], params[3], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::MENISCUS_LENS)
+        meniscusLensIntersect(
+            ray, pos, params[0], params[1], params[2], params[3], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::PLANO_CONVEX_LENS)
+        planoConvexLensIntersect(
+            ray, pos, params[0], params[1], params[2], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::PLANO_CONCAVE_LENS)
+        planoConcaveLensIntersect(
+            ray, pos, params[0], params[1], params[2], matId, isect);
+    else if constexpr (TYPE == EPrimitiveType::QUADRATIC_BEZIER)
+        quadraticBezierIntersect(ray,
+                                 pos,
+                                 size,
+                                 glm::vec2(params[0], params[1]),
+                                 matId,
+                                 isect);
+    else if constexpr (TYPE == EPrimitiveType::CUBIC_BEZIER)
+        cubicBezierIntersect(ray,
+                             pos,
+                             size,
+                             glm::vec2(params[0], params[1]),
+                             glm::vec2(params[2], params[3]),
+                             matId,
+                             isect);
+}
+
+/* A TScenePrimitive whose type is part of its C++ type. Plain floats so the
+   built-in scenes can be constexpr; the compiler then sees every parameter
+   of every call as a constant */
+template <EPrimitiveType TYPE>
+struct TStaticPrimitive
+{
+    float pos[2];
+    float size[2];
+    float params[4];
+    float matId;
+
+    template <typename TRay, typename TIntersection>
+    void intersect(const TRay& ray, TIntersection& isect) const
+    {
+        intersectShape<TYPE>(ray,
+                             glm::vec2(this->pos[0], this->pos[1]),
+                             glm::vec2(this->size[0], this->size[1]),
+                             this->params,
+                             this->matId,
+                             isect);
+    }
+};
+
+/* Stands in for the IOR table of materials that never refract */
+struct TNoIorTable
+{
+};
+
+/* A TSceneMaterial whose type is part of its C++ type, sampling like
+   TCpuScene::sample */
+template <EMaterialType TYPE>
+struct TStaticMaterial
+{
+    float id;
+    float albedo[3];
+    bool  faceAlbedo;
+    float leftAlbedo[3];
+    float rightAlbedo[3];
+    float roughness;
+    /* The IorData texels of the material; only dielectrics carry them */
+    std::conditional_t<TYPE == EMaterialType::DIELECTRIC ||
+                           TYPE == EMaterialType::ROUGH_DIELECTRIC,
+                       float[IOR_SAMPLES],
+                       TNoIorTable>
+        iorTable;
+
+    float ior(float lambda) const
+    {
+        return tableIor(this->iorTable, lambda);
+    }
+
+    glm::vec2 sample(glm::vec4&          state,
+                     const Intersection& isect,
+                     float               lambda,
+                     glm::vec2           wiLocal,
+                     glm::vec3&          throughput) const
+    {
+        if constexpr (TYPE == EMaterialType::MIRROR)
+            return sampleMirror(wiLocal);
+        else if constexpr (TYPE == EMaterialType::ROUGH_MIRROR)
+            return sampleRoughMirror(
+                state, wiLocal, throughput, this->roughness);
+        else if constexpr (TYPE == EMaterialType::DIELECTRIC)
+            return sampleDielectric(state, wiLocal, this->ior(lambda));
+        else if constexpr (TYPE == EMaterialType::ROUGH_DIELECTRIC)
+            return sampleRoughDielectric(
+                state, wiLocal, this->roughness, this->ior(lambda));
+        else
+        {
+            const float* albedo = this->albedo;
+            if (this->faceAlbedo && isect.n.x == -1.0f)
+                albedo = this->leftAlbedo;
+            else if (this->faceAlbedo && isect.n.x == 1.0f)
+                albedo = this->rightAlbedo;
+            throughput *= glm::vec3(albedo[0], albedo[1], albedo[2]);
+            return sampleDiffuse(state, wiLocal);
+        }
+    }
+};
+
+/* The first material of the list with the id of the hit, or the last one,
+   material 0, for every other id */
+template <typename TLast>
+inline glm::vec2 sampleStaticMaterials(glm::vec4&          state,
+                                       const Intersection& isect,
+                                       float               lambda,
+                                       glm::vec2           wiLocal,
+                                       glm::vec3&          throughput,
+                                       const TLast&        last)
+{
+    return last.sample(state, isect, lambda, wiLocal, throughput);
+}
+
+template <typename TFirst, typename TSecond, typename... TRest>
+inline glm::vec2 sampleStaticMaterials(glm::vec4&          state,
+                                       const Intersection& isect,
+                                       float               lambda,
+                                       glm::vec2           wiLocal,
+                                       glm::vec3&          throughput,
+                                       const TFirst&       first,
+                                       const TSecond&      second,
+                                       const TRest&... rest)
+{
+    if (isect.mat == first.id)
+        return first.sample(state, isect, lambda, wiLocal, throughput);
+    return sampleStaticMaterials(
+        state, isect, lambda, wiLocal, throughput, second, rest...);
+}
+
+/* intersect()/sample() of TScene, a struct with constexpr std::tuples of
+   TStaticPrimitives and TStaticMaterials (material 0 last). The fold over
+   the primitives and the chain over the materials unroll into straight-line
+   code, as in the hand-written GLSL scenes */
+template <typename TScene>
+struct TStaticScene
+{
+    template <typename TRay, typename TIntersection>
+    static void intersect(const TRay& ray, TIntersection& isect)
+    {
+        std::apply(
+            [&](const auto&... primitive) {
+                (primitive.intersect(ray, isect), ...);
+            },
+            TScene::primitives);
+    }
+
+    static glm::vec2 sample(glm::vec4&          state,
+                            const Intersection& isect,
+                            float               lambda,
+                            glm::vec2           wiLocal,
+                            glm::vec3&          throughput)
+    {
+        return std::apply(
+            [&](const auto&... material) {
+                return sampleStaticMaterials(
+                    state, isect, lambda, wiLocal, throughput, material...);
+            },
+            TScene::materials);
+    }
+};
+
+typedef void (*TStaticIntersectFn)(const Ray& ray, Intersection& isect);
+typedef void (*TStaticIntersectPacketFn)(const RayPacket&    ray,
+                                         IntersectionPacket& isect);
+typedef glm::vec2 (*TStaticSampleFn)(glm::vec4&          state,
+                                     const Intersection& isect,
+                                     float               lambda,
+                                     glm::vec2           wiLocal,
+                                     glm::vec3&          throughput);
+
+/* A built-in scene, found by the sceneFingerprint of its TSceneInfo */
+struct TStaticSceneEntry
+{
+    uint64_t                 fingerprint;
+    TStaticIntersectFn       intersect;
+    TStaticIntersectPacketFn intersectPacket;
+    TStaticSampleFn          sample;
+};
+
+template <typename TScene>
+constexpr TStaticSceneEntry staticSceneEntry(uint64_t fingerprint)
+{
+    return TStaticSceneEntry{
+        fingerprint,
+        &TStaticScene<TScene>::template intersect<Ray, Intersection>,
+        &TStaticScene<TScene>::template intersect<RayPacket,
+                                                  IntersectionPacket>,
+        &TStaticScene<TScene>::sample};
+}
+
+/* The built-in scene whose sceneFingerprint is fingerprint, or null.
+   tantalum_scenegen compiles the scenes of scenes.list without polylines at
+   build time, see cpu_builtin_scenes.cpp */
+const TStaticSceneEntry* findStaticScene(uint64_t fingerprint);
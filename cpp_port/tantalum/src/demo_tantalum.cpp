@@ -6,13 +6,23 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <random>
 #include <thread>
 
 #include "demo_tantalum.h"
+#include "emitter.h"
 #include "gl_utils.h"
 #include "imgui_impl_glfw.h"
+#include "scene_compiler.h"
+#include "scene_info.h"
 #include "tantalum_data.h"
 
 using namespace gl;
@@ -24,6 +34,7 @@ using std::endl;
 
 static const std::string              proj_dir     = PROJECT_DIR;
 static const std::string              shader_path  = proj_dir + "/shaders/";
+static const std::string              scene_path   = proj_dir + "/scenes/";
 static const std::vector<std::string> include_path = {shader_path};
 
 constexpr float                              M_PI = 3.14159265358979323846f;
@@ -34,18 +45,6 @@ float                                        randf()
     return dist(rng);
 }
 
-static TantalumData g_data;
-
-const std::vector<float>& wavelengthToRgbTable()
-{
-    return g_data.wavelength_to_rgb;
-}
-
-const std::vector<GasDischargeLines>& gasDischargeLines()
-{
-    return g_data.lines;
-}
-
 // --------------------------------
 
 static int glTypeSize(GLenum type)
@@ -115,6 +114,16 @@ public:
         this->glName->setParameter(GL_TEXTURE_MAG_FILTER, interpMode);
     }
 
+    /* Respecifies the texture at a new size, e.g. for the data of another
+       scene */
+    void resize(int width, int height, const void* texels)
+    {
+        this->width  = width;
+        this->height = height;
+        this->size   = glm::ivec2(width, height);
+        this->copy(texels);
+    }
+
     void copy(const void* texels)
     {
         this->glName->image2D(0,
@@ -185,49 +194,307 @@ public:
     std::unique_ptr<Framebuffer> glName;
 };
 
+/* Set when the driver compiles and links on threads of its own, see
+   enableParallelShaderCompile() */
+static bool parallel_shader_compile = false;
+
+/* Lets the driver compile on as many threads as it likes, if it supports
+   GL_KHR_parallel_shader_compile. Includes are then resolved before the
+   sources reach GL, so TShader can compile them with plain glCompileShader */
+static void enableParallelShaderCompile()
+{
+    Shader::hintIncludeImplementation(Shader::IncludeImplementation::Fallback);
+    if (hasExtension(GLextension::GL_KHR_parallel_shader_compile))
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallel_shader_compile = true;
+    }
+}
+
+/* Directory of the program binaries of earlier runs; empty if the driver
+   offers no binary formats, or there is nowhere to keep them */
+static std::string program_cache_dir;
+
+/* Binaries beyond this many bytes are evicted, least recently used first,
+   so edited shaders do not pile up dead binaries */
+static constexpr uintmax_t PROGRAM_CACHE_BYTES = 64 << 20;
+
+/* Binaries only load on the driver that wrote them, so each driver gets a
+   directory of its own, named after this key */
+static uint64_t driverKey()
+{
+    uint64_t hash = FNV1A_OFFSET;
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        auto text = reinterpret_cast<const char*>(glGetString(name));
+        if (text) hash = fnv1a(text, std::strlen(text) + 1, hash);
+    }
+    return hash;
+}
+
+/* Removes the directories of other drivers, which after an update can never
+   load again, then the least recently used binaries over the size cap */
+static void pruneProgramBinaryCache(const std::filesystem::path& root,
+                                    const std::filesystem::path& dir)
+{
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    for (auto& entry : fs::directory_iterator(root, error))
+    {
+        if (entry.path() != dir) fs::remove_all(entry.path(), error);
+    }
+
+    struct TEntry
+    {
+        fs::path           path;
+        fs::file_time_type used;
+        uintmax_t          size;
+    };
+    std::vector<TEntry> entries;
+    uintmax_t           total = 0;
+    for (auto& entry : fs::directory_iterator(dir, error))
+    {
+        if (entry.path().extension() != ".bin") continue;
+        TEntry item{entry.path(),
+                    fs::last_write_time(entry.path(), error),
+                    fs::file_size(entry.path(), error)};
+        if (error) continue;
+        total += item.size;
+        entries.push_back(item);
+    }
+
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const TEntry& a, const TEntry& b) { return a.used < b.used; });
+    for (auto& entry : entries)
+    {
+        if (total <= PROGRAM_CACHE_BYTES) break;
+        if (fs::remove(entry.path, error)) total -= entry.size;
+    }
+}
+
+static void enableProgramBinaryCache()
+{
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats == 0) return;
+
+    std::error_code error;
+    auto            root = std::filesystem::temp_directory_path(error);
+    if (error) return;
+    root /= "tantalum-programs";
+
+    char name[32];
+    std::snprintf(
+        name, sizeof(name), "%016llx", (unsigned long long)driverKey());
+    auto dir = root / name;
+    std::filesystem::create_directories(dir, error);
+    if (error) return;
+
+    pruneProgramBinaryCache(root, dir);
+    program_cache_dir = dir.string();
+}
+
+static uint64_t programBinaryKey(const std::string& vert,
+                                 const std::string& frag)
+{
+    uint64_t hash = FNV1A_OFFSET;
+    hash = fnv1a(vert.c_str(), vert.size() + 1, hash);
+    hash = fnv1a(frag.c_str(), frag.size() + 1, hash);
+    return hash;
+}
+
+static std::string programBinaryPath(uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return program_cache_dir + "/" + name;
+}
+
+/* Links program from the cached binary of key. False if there is none, or
+   the driver rejects it, e.g. after an update that kept its version */
+static bool loadProgramBinary(GLuint program, uint64_t key)
+{
+    std::ifstream file(programBinaryPath(key), std::ios::binary);
+    uint32_t      format = 0;
+    if (!file.read(reinterpret_cast<char*>(&format), sizeof(format)))
+        return false;
+    std::vector<char> binary((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+
+    glProgramBinary(
+        program, GLenum(format), binary.data(), GLsizei(binary.size()));
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) return false;
+
+    /* The write time doubles as the last use of the binary for pruning */
+    std::error_code error;
+    std::filesystem::last_write_time(
+        programBinaryPath(key),
+        std::filesystem::file_time_type::clock::now(),
+        error);
+    return true;
+}
+
+/* Written to a temporary of its own first, so that concurrent runs saving
+   the same key neither mix their writes nor ever load half a binary. The
+   temporary is removed whenever the binary does not make it into place */
+static void saveProgramBinary(GLuint program, uint64_t key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum            format  = GLenum(0);
+    GLsizei           written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    /* Random, and the clock in case random_device is deterministic */
+    std::random_device device;
+    auto               ticks = std::chrono::steady_clock::now();
+    char               suffix[32];
+    std::snprintf(suffix,
+                  sizeof(suffix),
+                  ".%08x%08x.tmp",
+                  unsigned(device()),
+                  unsigned(ticks.time_since_epoch().count()));
+
+    std::string     path      = programBinaryPath(key);
+    std::string     temporary = path + suffix;
+    std::error_code error;
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        uint32_t      header = uint32_t(format);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        file.close();
+        if (!file)
+        {
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+}
+
+/* The program is compiled and linked by the constructor, but only waited
+   for on the first bind() unless waitNow is set. Everything after the
+   glLinkProgram goes straight to GL: globjects would query the link status
+   of the program, and relink it, as soon as it is touched */
 class TShader : public globjects::Instantiator<TShader>
 {
 public:
     TShader(const std::string& vert,
             const std::string& frag,
-            ShaderOrigin       origin = ShaderOrigin::FromFile)
+            ShaderOrigin       origin  = ShaderOrigin::FromFile,
+            bool               waitNow = true)
+        : TShader(vert, origin, frag, origin, waitNow)
     {
-        this->vertex = ManagedShader::create(vert, origin, GL_VERTEX_SHADER);
+    }
 
-        this->fragment =
-            ManagedShader::create(frag, origin, GL_FRAGMENT_SHADER);
+    TShader(const std::string& vert,
+            ShaderOrigin       vertOrigin,
+            const std::string& frag,
+            ShaderOrigin       fragOrigin,
+            bool               waitNow = true)
+    {
+        this->vertex =
+            ManagedShader::create(vert, vertOrigin, GL_VERTEX_SHADER, false);
+
+        this->fragment = ManagedShader::create(
+            frag, fragOrigin, GL_FRAGMENT_SHADER, false);
 
         this->program = Program::create();
 
-        this->program->attach(this->vertex->get(), this->fragment->get());
-        this->program->link();
+        /* A binary from an earlier run skips compiling altogether; any
+           other program is kept for the next one once linked */
+        if (!program_cache_dir.empty())
+        {
+            std::string vert = this->vertex->uploadedSource();
+            std::string frag = this->fragment->uploadedSource();
+            this->binaryKey  = programBinaryKey(vert, frag);
+            if (loadProgramBinary(this->program->id(), this->binaryKey))
+            {
+                this->linked = true;
+                return;
+            }
+            this->saveBinary = true;
+            glProgramParameteri(
+                this->program->id(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+        }
+
+        this->vertex->startCompile();
+        this->fragment->startCompile();
+        glAttachShader(this->program->id(), this->vertex->get()->id());
+        glAttachShader(this->program->id(), this->fragment->get()->id());
+        glLinkProgram(this->program->id());
+
+        if (waitNow) this->finish();
+    }
+
+    /* Whether finish() would return without waiting. Without the extension
+       every status query waits, so the answer is always yes */
+    bool ready()
+    {
+        if (this->linked || !parallel_shader_compile) return true;
+
+        GLint done = 0;
+        glGetProgramiv(this->program->id(), GL_COMPLETION_STATUS_KHR, &done);
+        return done != 0;
+    }
 
-        if (!this->program->isLinked())
+    void finish()
+    {
+        if (this->linked) return;
+
+        GLint status = 0;
+        glGetProgramiv(this->program->id(), GL_LINK_STATUS, &status);
+        if (!status)
         {
+            this->vertex->checkCompile();
+            this->fragment->checkCompile();
+
             auto info = this->program->infoLog();
             cout << "info : " << info << endl;
             throw std::runtime_error("cannot link program");
         }
+        this->linked = true;
+
+        if (this->saveBinary)
+            saveProgramBinary(this->program->id(), this->binaryKey);
     }
 
     void bind()
     {
-        this->program->use();
+        this->finish();
+        glUseProgram(this->program->id());
+    }
+
+    int attributeIndex(const std::string& name)
+    {
+        return glGetAttribLocation(this->program->id(), name.c_str());
     }
 
     int uniformIndex(const std::string& name)
     {
         if (this->uniforms.find(name) == this->uniforms.end())
-            this->uniforms[name] = program->getUniformLocation(name);
+            this->uniforms[name] =
+                glGetUniformLocation(this->program->id(), name.c_str());
         return this->uniforms[name];
     }
 
+    /* The setters apply to the bound program */
     void uniformTexture(const std::string& name, TTexture* texture)
     {
         int id = this->uniformIndex(name);
         if (id != -1)
         {
-            this->program->setUniform(id, texture->boundUnit);
+            glUniform1i(id, texture->boundUnit);
         }
     }
 
@@ -236,7 +503,7 @@ public:
         int id = this->uniformIndex(name);
         if (id != -1)
         {
-            this->program->setUniform(id, f);
+            glUniform1f(id, f);
         }
     }
 
@@ -245,7 +512,7 @@ public:
         int id = this->uniformIndex(name);
         if (id != -1)
         {
-            this->program->setUniform(id, glm::vec2(f1, f2));
+            glUniform2f(id, f1, f2);
         }
     }
 
@@ -253,6 +520,9 @@ public:
     std::unique_ptr<ManagedShader> fragment;
     std::unique_ptr<Program>       program;
     std::map<std::string, int>     uniforms;
+    bool                           linked     = false;
+    bool                           saveBinary = false;
+    uint64_t                       binaryKey  = 0;
 };
 
 class TVertexBuffer : public globjects::Instantiator<TVertexBuffer>
@@ -311,7 +581,7 @@ public:
         for (int i = 0; i < this->attributes.size(); i++)
         {
             this->attributes[i].index =
-                shader->program->getAttributeLocation(this->attributes[i].name);
+                shader->attributeIndex(this->attributes[i].name);
             if (this->attributes[i].index >= 0)
             {
                 auto attr    = this->attributes[i];
@@ -343,9 +613,6 @@ public:
     std::unique_ptr<VertexArray> vao;
 };
 
-constexpr float LAMBDA_MIN = 360.0f;
-constexpr float LAMBDA_MAX = 750.0f;
-
 class TRayState : public globjects::Instantiator<TRayState>
 {
 public:
@@ -365,9 +632,12 @@ public:
             posData[i * 4 + 2] = cos(theta);
             posData[i * 4 + 3] = sin(theta);
 
+            /* Integer seeds in [1, m), drawn like TCpuRayState's. A
+               fractional seed keeps its generator off the integers for
+               good, and rand.glsl inexact; see cpu_rand.h for the rest */
             for (int t = 0; t < 4; t++)
             {
-                rngData[i * 4 + t] = randf() * 4194167.0f;
+                rngData[i * 4 + t] = 1.0f + floor(randf() * 4194165.0f);
             }
             for (int t = 0; t < 4; t++)
             {
@@ -381,6 +651,8 @@ public:
             TTexture::create(size, size, 4, true, false, true, rngData.data());
         this->rgbTex =
             TTexture::create(size, size, 4, true, false, true, rgbData.data());
+        this->heroTex =
+            TTexture::create(size, size, 4, true, false, true, rgbData.data());
     }
 
     void bind(TShader* shader)
@@ -388,10 +660,12 @@ public:
         this->posTex->bind(0);
         this->rngTex->bind(1);
         this->rgbTex->bind(2);
+        this->heroTex->bind(6);
 
         shader->uniformTexture("PosData", this->posTex.get());
         shader->uniformTexture("RngData", this->rngTex.get());
         shader->uniformTexture("RgbData", this->rgbTex.get());
+        shader->uniformTexture("HeroData", this->heroTex.get());
     }
 
     void attach(TRenderTarget* fbo)
@@ -399,6 +673,7 @@ public:
         fbo->attachTexture(this->posTex.get(), 0);
         fbo->attachTexture(this->rngTex.get(), 1);
         fbo->attachTexture(this->rgbTex.get(), 2);
+        fbo->attachTexture(this->heroTex.get(), 3);
     }
 
     void detach(TRenderTarget* fbo)
@@ -406,86 +681,144 @@ public:
         fbo->detachTexture(0);
         fbo->detachTexture(1);
         fbo->detachTexture(2);
+        fbo->detachTexture(3);
     }
 
     int                       size;
     std::unique_ptr<TTexture> posTex;
     std::unique_ptr<TTexture> rngTex;
     std::unique_ptr<TTexture> rgbTex;
+    /* Hero wavelength mode: the color of the hero wavelength alone, and 1 in
+       alpha while rgbTex still carries all four, see init-frag.glsl */
+    std::unique_ptr<TTexture> heroTex;
 };
 
-enum class ESpectrumType
+/* Texels of one scene texture and their size */
+struct TTexels
 {
-    SPECTRUM_WHITE         = 0,
-    SPECTRUM_INCANDESCENT  = 1,
-    SPECTRUM_GAS_DISCHARGE = 2,
+    std::vector<float> texels;
+    int                width  = 0;
+    int                height = 0;
 };
 
-enum class ESpreadType
+/* Everything the trace program reads of one scene. Scenes differ only in
+   this data, so changing scenes uploads it and never changes programs */
+struct TSceneTexels
 {
-    SPREAD_POINT = 0,
-    SPREAD_CONE  = 1,
-    SPREAD_BEAM  = 2,
-    SPREAD_LASER = 3,
-    SPREAD_AREA  = 4,
+    TTexels sceneData;
+    TTexels polylineData;
+    TTexels materialData;
+    TTexels iorData;
+    int     listFirst;
+    int     listCount;
+    float   accelerator;
 };
 
 class TRenderer : public globjects::Instantiator<TRenderer>
 {
 public:
-    static constexpr int SPECTRUM_SAMPLES = 256;
-    static constexpr int ICDF_SAMPLES     = 1024;
+    static constexpr int SPECTRUM_SAMPLES = TEmitter::SPECTRUM_SAMPLES;
 
-    TRenderer(int width, int height, const std::vector<std::string>& scenes)
+    TRenderer(int width, int height, const std::vector<TSceneInfo>& scenes)
     {
         this->quadVbo = createQuadVbo();
 
-        this->maxSampleCount       = 100000;
-        this->spreadType           = ESpreadType::SPREAD_POINT;
-        this->emissionSpectrumType = ESpectrumType::SPECTRUM_WHITE;
-        this->emitterTemperature   = 5000.0;
-        this->emitterGas           = 0;
-        this->currentScene         = 0;
-        this->needsReset           = true;
+        this->maxSampleCount = 100000;
+        this->currentScene   = 0;
+        this->needsReset     = true;
 
+        /* Every frame needs these; they compile alongside each other and
+           the trace program, and are waited for when first bound */
         this->compositeProgram =
             TShader::create(shader_path + "/compose-vert.glsl",
                             shader_path + "/compose-frag.glsl",
-                            ShaderOrigin::FromFile);
+                            ShaderOrigin::FromFile,
+                            false);
         this->passProgram = TShader::create(shader_path + "/compose-vert.glsl",
                                             shader_path + "/pass-frag.glsl",
-                                            ShaderOrigin::FromFile);
+                                            ShaderOrigin::FromFile,
+                                            false);
         this->initProgram = TShader::create(shader_path + "/init-vert.glsl",
                                             shader_path + "/init-frag.glsl",
-                                            ShaderOrigin::FromFile);
+                                            ShaderOrigin::FromFile,
+                                            false);
         this->rayProgram  = TShader::create(shader_path + "/ray-vert.glsl",
                                            shader_path + "ray-frag.glsl",
-                                           ShaderOrigin::FromFile);
-        this->tracePrograms.clear();
-        for (int i = 0; i < scenes.size(); i++)
+                                           ShaderOrigin::FromFile,
+                                           false);
+        this->compositeSpectralProgram =
+            TShader::create(shader_path + "/compose-vert.glsl",
+                            shader_path + "/compose-spectral-frag.glsl",
+                            ShaderOrigin::FromFile,
+                            false);
+        /* One program for every scene, which reads the scene from the
+           textures below */
+        this->traceProgram = TShader::create(shader_path + "/trace-vert.glsl",
+                                             shader_path + "/trace-frag.glsl",
+                                             ShaderOrigin::FromFile,
+                                             false);
+
+        this->sceneTexels.clear();
+        for (const auto& scene : scenes)
         {
-            this->tracePrograms.emplace_back(
-                TShader::create(shader_path + "/trace-vert.glsl",
-                                shader_path + scenes[i],
-                                ShaderOrigin::FromFile));
-        }
+            TSceneTexels data;
+            data.accelerator = float(int(scene.accelerator));
+
+            auto& sceneData  = data.sceneData;
+            sceneData.texels = compileSceneTexels(scene,
+                                                  sceneData.width,
+                                                  sceneData.height,
+                                                  data.listFirst,
+                                                  data.listCount);
+
+            /* Scenes without polylines get a texel nothing reads */
+            auto& polylineData  = data.polylineData;
+            polylineData.texels = compileScenePolylineTexels(
+                scene, polylineData.width, polylineData.height);
+            if (polylineData.texels.empty())
+            {
+                polylineData.texels.assign(4, 0.0f);
+                polylineData.width = polylineData.height = 1;
+            }
 
-        this->maxPathLength = 12;
+            auto& materialData  = data.materialData;
+            materialData.texels = compileSceneMaterialTexels(
+                scene, materialData.width, materialData.height);
 
-        this->spectrumTable = wavelengthToRgbTable();
-        this->spectrum      = TTexture::create(this->spectrumTable.size() / 4,
+            auto& iorData  = data.iorData;
+            iorData.texels = compileSceneIorTexels(
+                scene, iorData.width, iorData.height);
+
+            this->sceneTexels.push_back(std::move(data));
+        }
+
+        /* Filled by uploadScene(); the IOR tables are filtered along
+           lambda */
+        this->sceneData = TTexture::create(1, 1, 4, true, false, true, nullptr);
+        this->polylineData =
+            TTexture::create(1, 1, 4, true, false, true, nullptr);
+        this->materialData =
+            TTexture::create(1, 1, 4, true, false, true, nullptr);
+        this->iorData = TTexture::create(1, 1, 1, true, true, true, nullptr);
+        this->uploadScene(this->currentScene);
+
+        this->maxPathLength   = 12;
+        this->heroWavelengths = false;
+        this->spectral        = false;
+
+        auto& spectrumTable = this->emitter.spectrumTable;
+        this->spectrum      = TTexture::create(spectrumTable.size() / 4,
                                           1,
                                           4,
                                           true,
                                           true,
                                           true,
-                                          this->spectrumTable.data());
-        this->emission      = TTexture::create(
-            SPECTRUM_SAMPLES, 1, 1, true, false, true, nullptr);
-        this->emissionIcdf =
-            TTexture::create(ICDF_SAMPLES, 1, 1, true, false, true, nullptr);
-        this->emissionPdf = TTexture::create(
-            SPECTRUM_SAMPLES, 1, 1, true, false, true, nullptr);
+                                          spectrumTable.data());
+        this->emissionAlias = TTexture::create(
+            SPECTRUM_SAMPLES, 1, 4, true, false, true, nullptr);
+        this->binResponse   = TTexture::create(
+            SPECTRAL_BINS, 1, 4, true, false, true, nullptr);
+        this->setSpectralOutput(ESpectralOutput::SPECTRAL_RGB);
 
         this->raySize = 512;
         this->resetActiveBlock();
@@ -530,193 +863,126 @@ public:
 
     void setEmissionSpectrumType(ESpectrumType type)
     {
-        this->emissionSpectrumType = type;
+        this->emitter.emissionSpectrumType = type;
         this->computeEmissionSpectrum();
     }
 
     void setEmitterTemperature(float temperature)
     {
-        this->emitterTemperature = temperature;
-        if (this->emissionSpectrumType == ESpectrumType::SPECTRUM_INCANDESCENT)
+        this->emitter.emitterTemperature = temperature;
+        if (this->emitter.emissionSpectrumType ==
+            ESpectrumType::SPECTRUM_INCANDESCENT)
             this->computeEmissionSpectrum();
     }
 
     void setEmitterGas(int gasId)
     {
-        this->emitterGas = gasId;
-        if (this->emissionSpectrumType == ESpectrumType::SPECTRUM_GAS_DISCHARGE)
+        this->emitter.emitterGas = gasId;
+        if (this->emitter.emissionSpectrumType ==
+            ESpectrumType::SPECTRUM_GAS_DISCHARGE)
             this->computeEmissionSpectrum();
     }
 
+    /* Recently used spectra come from the cache of the emitter, so this is
+       one texture upload per change */
     void computeEmissionSpectrum()
     {
-        this->emissionSpectrum.resize(SPECTRUM_SAMPLES);
-
-        switch (this->emissionSpectrumType)
-        {
-            case ESpectrumType::SPECTRUM_WHITE:
-            {
-                for (int i = 0; i < SPECTRUM_SAMPLES; i++)
-                {
-                    this->emissionSpectrum[i] = 1.0f;
-                }
-            }
-            break;
-            case ESpectrumType::SPECTRUM_INCANDESCENT:
-            {
-                float h  = 6.626070040e-34;
-                float c  = 299792458.0;
-                float kB = 1.3806488e-23;
-                float T  = this->emitterTemperature;
-
-                for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
-                {
-                    float l = (LAMBDA_MIN + (LAMBDA_MAX - LAMBDA_MIN) *
-                                                (i + 0.5) / SPECTRUM_SAMPLES) *
-                              1e-9;
-                    float power =
-                        1e-12 * (2.0 * h * c * c) /
-                        (l * l * l * l * l * (exp(h * c / (l * kB * T)) - 1.0));
-
-                    this->emissionSpectrum[i] = power;
-                }
-            }
-            break;
-            case ESpectrumType::SPECTRUM_GAS_DISCHARGE:
-            {
-                auto& wavelengths =
-                    gasDischargeLines()[this->emitterGas].wavelengths;
-                auto& strengths =
-                    gasDischargeLines()[this->emitterGas].strengths;
-
-                for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
-                    this->emissionSpectrum[i] = 0.0;
-
-                for (int i = 0; i < wavelengths.size(); ++i)
-                {
-                    int idx =
-                        floor((wavelengths[i] - LAMBDA_MIN) /
-                              (LAMBDA_MAX - LAMBDA_MIN) * SPECTRUM_SAMPLES);
-                    if (idx < 0 || idx >= SPECTRUM_SAMPLES) continue;
-
-                    this->emissionSpectrum[idx] += strengths[i];
-                }
-            }
-            break;
-            default:
-                throw std::runtime_error("unknown type");
-                break;
-        }
-
-        this->computeSpectrumIcdf();
+        this->emitter.computeEmissionSpectrum();
 
-        this->emission->bind(0);
-        this->emission->copy(this->emissionSpectrum.data());
+        this->emissionAlias->bind(0);
+        this->emissionAlias->copy(this->emitter.aliasTable.data());
         this->reset();
     }
 
-    void computeSpectrumIcdf()
+    std::vector<float>& getEmissionSpectrum()
     {
-        if (this->cdf.empty())
-        {
-            this->cdf.resize(SPECTRUM_SAMPLES + 1);
-            this->pdf.resize(SPECTRUM_SAMPLES);
-            this->icdf.resize(ICDF_SAMPLES);
-        }
+        return this->emitter.emissionSpectrum;
+    }
 
-        float sum = 0.0;
-        for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
-            sum += this->emissionSpectrum[i];
+    void setMaxPathLength(int length)
+    {
+        this->maxPathLength = length;
+        this->reset();
+    }
 
-        /* Mix in 10% of a uniform sample distribution to stay on the safe side.
-           Especially gas emission spectra with lots of emission lines
-           tend to have small peaks that fall through the cracks otherwise */
-        float safetyPadding = 0.1;
-        float normalization = SPECTRUM_SAMPLES / sum;
+    void setMaxSampleCount(int count)
+    {
+        this->maxSampleCount = count;
+    }
 
-        /* Precompute cdf and pdf (unnormalized for now) */
-        this->cdf[0] = 0.0;
-        for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
-        {
-            this->emissionSpectrum[i] *= normalization;
-
-            /* Also take into account the observer response when distributing
-               samples.
-               Otherwise tends to prioritize peaks just barely outside the
-               visible spectrum */
-            float observerResponse =
-                (1.0 / 3.0) * (abs(this->spectrumTable[i * 4]) +
-                               abs(this->spectrumTable[i * 4 + 1]) +
-                               abs(this->spectrumTable[i * 4 + 2]));
-
-            this->pdf[i] = observerResponse *
-                           (this->emissionSpectrum[i] + safetyPadding) /
-                           (1.0 + safetyPadding);
-            this->cdf[i + 1] = this->pdf[i] + this->cdf[i];
-        }
+    void setHeroWavelengths(bool enabled)
+    {
+        this->heroWavelengths = enabled;
+        this->reset();
+    }
 
-        /* All done! Time to normalize */
-        float cdfSum = this->cdf[SPECTRUM_SAMPLES];
-        for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
-        {
-            this->pdf[i] *= SPECTRUM_SAMPLES / cdfSum;
-            this->cdf[i + 1] /= cdfSum;
-        }
-        /* Make sure we don't fall into any floating point pits */
-        this->cdf[SPECTRUM_SAMPLES] = 1.0;
-
-        /* Precompute an inverted mapping of the cdf. This is biased!
-           Unfortunately we can't really afford to do runtime bisection
-           on the GPU, so this will have to do. For our purposes a small
-           amount of bias is tolerable anyway. */
-        int cdfIdx = 0;
-        for (int i = 0; i < ICDF_SAMPLES; ++i)
-        {
-            float target = std::min(float(i + 1) / ICDF_SAMPLES, 1.0f);
-            while (this->cdf[cdfIdx] < target) cdfIdx++;
-            this->icdf[i] = (cdfIdx - 1.0) / SPECTRUM_SAMPLES;
-        }
+    void setSpectral(bool enabled)
+    {
+        this->spectral = enabled;
+        this->createFrameBuffers();
 
-        this->emissionIcdf->bind(0);
-        this->emissionIcdf->copy(this->icdf.data());
-        this->emissionPdf->bind(0);
-        this->emissionPdf->copy(this->pdf.data());
+        this->needsReset = true;
+        this->reset();
     }
 
-    std::vector<float>& getEmissionSpectrum()
+    /* Only the final conversion of the bins changes, so the accumulated
+       frame is kept */
+    void setSpectralOutput(ESpectralOutput output)
     {
-        return this->emissionSpectrum;
+        auto response = this->emitter.spectralBinResponse(output);
+        this->binResponse->bind(0);
+        this->binResponse->copy(response.data());
     }
 
-    void setMaxPathLength(int length)
+    int framePlanes()
     {
-        this->maxPathLength = length;
-        this->reset();
+        return this->spectral ? SPECTRAL_PLANES : 1;
     }
 
-    void setMaxSampleCount(int count)
+    /* Spectral accumulation stacks the SPECTRAL_PLANES images of the bins
+       vertically in both buffers. Both stay full float: the wave buffer
+       blends thousands of splats into a pixel near an emitter, and half
+       float sums stop taking small ones past 2048. The stack is
+       SPECTRAL_PLANES times the window height; where that exceeds
+       GL_MAX_TEXTURE_SIZE, the renderer says so and accumulates RGB
+       instead */
+    void createFrameBuffers()
     {
-        this->maxSampleCount = count;
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (this->spectral && this->height * SPECTRAL_PLANES > maxSize)
+        {
+            cerr << "spectral accumulation needs " << this->width << " x "
+                 << this->height * SPECTRAL_PLANES
+                 << " textures, larger than GL_MAX_TEXTURE_SIZE " << maxSize
+                 << "; accumulating RGB instead" << endl;
+            this->spectral = false;
+        }
+
+        int frameHeight = this->height * this->framePlanes();
+
+        this->screenBuffer = TTexture::create(
+            this->width, frameHeight, 4, true, false, true, nullptr);
+        this->waveBuffer = TTexture::create(
+            this->width, frameHeight, 4, true, false, true, nullptr);
     }
 
     void changeResolution(int width, int height)
     {
         if (this->width && this->height)
         {
-            this->emitterPos[0] =
-                (this->emitterPos[0] + 0.5) * width / this->width - 0.5;
-            this->emitterPos[1] =
-                (this->emitterPos[1] + 0.5) * height / this->height - 0.5;
+            auto& emitterPos = this->emitter.emitterPos;
+            emitterPos[0] =
+                (emitterPos[0] + 0.5) * width / this->width - 0.5;
+            emitterPos[1] =
+                (emitterPos[1] + 0.5) * height / this->height - 0.5;
         }
 
         this->width  = width;
         this->height = height;
         this->aspect = float(this->width) / float(this->height);
 
-        this->screenBuffer = TTexture::create(
-            this->width, this->height, 4, true, false, true, nullptr);
-        this->waveBuffer = TTexture::create(
-            this->width, this->height, 4, true, false, true, nullptr);
+        this->createFrameBuffers();
 
         this->resetActiveBlock();
         this->reset();
@@ -726,9 +992,35 @@ public:
     {
         this->resetActiveBlock();
         this->currentScene = idx;
+        this->uploadScene(idx);
         this->reset();
     }
 
+    /* Loads the textures the trace program reads with those of scene */
+    void uploadScene(int scene)
+    {
+        const auto& data = this->sceneTexels[scene];
+
+        auto upload = [](TTexture* texture, const TTexels& texels) {
+            texture->resize(texels.width, texels.height, texels.texels.data());
+        };
+        upload(this->sceneData.get(), data.sceneData);
+        upload(this->polylineData.get(), data.polylineData);
+        upload(this->materialData.get(), data.materialData);
+        upload(this->iorData.get(), data.iorData);
+    }
+
+    /* Whether the programs of the next frame are linked, so that render()
+       will not wait for the driver */
+    bool programsReady()
+    {
+        return this->traceProgram->ready() &&
+               this->initProgram->ready() && this->rayProgram->ready() &&
+               this->passProgram->ready() &&
+               (this->spectral ? this->compositeSpectralProgram->ready()
+                               : this->compositeProgram->ready());
+    }
+
     void reset()
     {
         if (!this->needsReset) return;
@@ -749,8 +1041,8 @@ public:
     void setSpreadType(ESpreadType type)
     {
         this->resetActiveBlock();
-        this->spreadType = type;
-        this->computeSpread();
+        this->emitter.spreadType = type;
+        this->emitter.computeSpread();
         this->reset();
     }
 
@@ -762,50 +1054,10 @@ public:
 
     void setEmitterPos(const glm::vec2& posA, const glm::vec2& posB)
     {
-        this->emitterPos =
-            this->spreadType == ESpreadType::SPREAD_POINT ? posB : posA;
-        this->emitterAngle = this->spreadType == ESpreadType::SPREAD_POINT
-                                 ? 0.0
-                                 : atan2(posB[1] - posA[1], posB[0] - posA[0]);
-        this->computeSpread();
+        this->emitter.setEmitterPos(posA, posB);
         this->reset();
     }
 
-    void computeSpread()
-    {
-        switch (this->spreadType)
-        {
-            case ESpreadType::SPREAD_POINT:
-                this->emitterPower  = 0.1;
-                this->spatialSpread = 0.0;
-                this->angularSpread = {0.0, M_PI * 2.0};
-                break;
-            case ESpreadType::SPREAD_CONE:
-                this->emitterPower  = 0.03;
-                this->spatialSpread = 0.0;
-                this->angularSpread = {this->emitterAngle, M_PI * 0.3};
-                break;
-            case ESpreadType::SPREAD_BEAM:
-                this->emitterPower  = 0.03;
-                this->spatialSpread = 0.4;
-                this->angularSpread = {this->emitterAngle, 0.0};
-                break;
-            case ESpreadType::SPREAD_LASER:
-                this->emitterPower  = 0.05;
-                this->spatialSpread = 0.0;
-                this->angularSpread = {this->emitterAngle, 0.0};
-                break;
-            case ESpreadType::SPREAD_AREA:
-                this->emitterPower  = 0.1;
-                this->spatialSpread = 0.4;
-                this->angularSpread = {this->emitterAngle, M_PI};
-                break;
-            default:
-                throw std::runtime_error("unknown spread type");
-                break;
-        }
-    }
-
     std::unique_ptr<TVertexBuffer> createQuadVbo()
     {
         auto vbo = TVertexBuffer::create();
@@ -848,19 +1100,37 @@ public:
 
     void composite()
     {
+        float exposure =
+            this->width / float(std::max(this->samplesTraced,
+                                         this->raySize * this->activeBlock));
+
+        if (this->spectral)
+        {
+            auto program = this->compositeSpectralProgram.get();
+            this->screenBuffer->bind(0);
+            this->binResponse->bind(1);
+            program->bind();
+            program->uniformTexture("Frame", this->screenBuffer.get());
+            program->uniformTexture("BinResponse", this->binResponse.get());
+            program->uniformF("Exposure", exposure);
+            this->quadVbo->draw(program, GL_TRIANGLE_FAN);
+            return;
+        }
+
         this->screenBuffer->bind(0);
         this->compositeProgram->bind();
         this->compositeProgram->uniformTexture("Frame",
                                                this->screenBuffer.get());
-        this->compositeProgram->uniformF(
-            "Exposure",
-            this->width / float(std::max(this->samplesTraced,
-                                         this->raySize * this->activeBlock)));
+        this->compositeProgram->uniformF("Exposure", exposure);
         this->quadVbo->draw(this->compositeProgram.get(), GL_TRIANGLE_FAN);
     }
 
     void render(float timestamp)
     {
+        /* Rather than block in the first bind(), keep drawing the GUI until
+           the driver is done compiling */
+        if (!this->programsReady()) return;
+
         this->needsReset = true;
         this->elapsedTimes.push_back(timestamp);
 
@@ -872,7 +1142,7 @@ public:
         glViewport(0, 0, this->raySize, this->raySize);
         glScissor(0, 0, this->raySize, this->activeBlock);
         glEnable(GL_SCISSOR_TEST);
-        this->fbo->drawBuffers(3);
+        this->fbo->drawBuffers(4);
         this->rayStates[next]->attach(this->fbo.get());
         this->quadVbo->bind();
 
@@ -881,28 +1151,27 @@ public:
             this->initProgram->bind();
             this->rayStates[current]->rngTex->bind(0);
             this->spectrum->bind(1);
-            this->emission->bind(2);
-            this->emissionIcdf->bind(3);
-            this->emissionPdf->bind(4);
+            this->emissionAlias->bind(2);
             this->initProgram->uniformTexture(
                 "RngData", this->rayStates[current]->rngTex.get());
             this->initProgram->uniformTexture("Spectrum", this->spectrum.get());
-            this->initProgram->uniformTexture("Emission", this->emission.get());
-            this->initProgram->uniformTexture("ICDF", this->emissionIcdf.get());
-            this->initProgram->uniformTexture("PDF", this->emissionPdf.get());
+            this->initProgram->uniformTexture("SpectrumAlias",
+                                              this->emissionAlias.get());
+            auto emitter = this->emitter.uniforms(this->width, this->height);
             this->initProgram->uniform2F(
-                "EmitterPos",
-                ((this->emitterPos[0] / this->width) * 2.0 - 1.0) *
-                    this->aspect,
-                1.0 - (this->emitterPos[1] / this->height) * 2.0);
-            this->initProgram->uniform2F("EmitterDir",
-                                         cos(this->angularSpread[0]),
-                                         -sin(this->angularSpread[0]));
-            this->initProgram->uniformF("EmitterPower", this->emitterPower);
-            this->initProgram->uniformF("SpatialSpread", this->spatialSpread);
+                "EmitterPos", emitter.pos.x, emitter.pos.y);
+            this->initProgram->uniform2F(
+                "EmitterDir", emitter.dir.x, emitter.dir.y);
+            this->initProgram->uniformF("EmitterPower", emitter.power);
+            this->initProgram->uniformF("SpatialSpread", emitter.spatialSpread);
             this->initProgram->uniform2F("AngularSpread",
-                                         -this->angularSpread[0],
-                                         this->angularSpread[1]);
+                                         emitter.angularSpread.x,
+                                         emitter.angularSpread.y);
+            this->initProgram->uniformF(
+                "HeroWavelengths",
+                this->heroWavelengths && !this->spectral ? 1.0f : 0.0f);
+            this->initProgram->uniformF("Spectral",
+                                        this->spectral ? 1.0f : 0.0f);
             this->quadVbo->draw(this->initProgram.get(), GL_TRIANGLE_FAN);
 
             current = 1 - current;
@@ -910,15 +1179,37 @@ public:
             this->rayStates[next]->attach(this->fbo.get());
         }
 
-        auto traceProgram = this->tracePrograms[this->currentScene].get();
+        const auto& scene = this->sceneTexels[this->currentScene];
+
+        auto traceProgram = this->traceProgram.get();
         traceProgram->bind();
         this->rayStates[current]->bind(traceProgram);
+        this->sceneData->bind(3);
+        traceProgram->uniformTexture("SceneData", this->sceneData.get());
+        traceProgram->uniform2F(
+            "SceneDataSize", this->sceneData->width, this->sceneData->height);
+        traceProgram->uniform2F("SceneList", scene.listFirst, scene.listCount);
+        traceProgram->uniformF("SceneAccelerator", scene.accelerator);
+        this->polylineData->bind(4);
+        traceProgram->uniformTexture("PolylineData", this->polylineData.get());
+        traceProgram->uniform2F("PolylineDataSize",
+                                this->polylineData->width,
+                                this->polylineData->height);
+        this->materialData->bind(5);
+        traceProgram->uniformTexture("MaterialData", this->materialData.get());
+        traceProgram->uniform2F("MaterialDataSize",
+                                this->materialData->width,
+                                this->materialData->height);
+        this->iorData->bind(7);
+        traceProgram->uniformTexture("IorData", this->iorData.get());
+        traceProgram->uniform2F(
+            "IorDataSize", this->iorData->width, this->iorData->height);
         this->quadVbo->draw(traceProgram, GL_TRIANGLE_FAN);
 
         this->rayStates[next]->detach(this->fbo.get());
 
         glDisable(GL_SCISSOR_TEST);
-        glViewport(0, 0, this->width, this->height);
+        glViewport(0, 0, this->width, this->height * this->framePlanes());
 
         this->fbo->drawBuffers(1);
         this->fbo->attachTexture(this->waveBuffer.get(), 0);
@@ -939,6 +1230,8 @@ public:
         this->rayProgram->uniformTexture(
             "RgbData", this->rayStates[current]->rgbTex.get());
         this->rayProgram->uniformF("Aspect", this->aspect);
+        this->rayProgram->uniformF("SpectralPlanes", this->framePlanes());
+        this->rayProgram->uniformF("FrameHeight", this->height);
         this->rayVbo->bind();
         this->rayVbo->draw(this->rayProgram.get(),
                            GL_LINES,
@@ -990,6 +1283,7 @@ public:
         }
 
         glDisable(GL_BLEND);
+        glViewport(0, 0, this->width, this->height);
 
         this->fbo->unbind();
 
@@ -999,29 +1293,27 @@ public:
     }
 
     std::unique_ptr<TVertexBuffer> quadVbo;
-    ESpreadType                    spreadType;
-    ESpectrumType                  emissionSpectrumType;
-    float                          emitterTemperature;
-    int                            emitterGas;
+    TEmitter                       emitter;
     int                            currentScene;
     bool                           needsReset;
 
-    std::unique_ptr<TShader>              compositeProgram;
-    std::unique_ptr<TShader>              passProgram;
-    std::unique_ptr<TShader>              initProgram;
-    std::unique_ptr<TShader>              rayProgram;
-    std::vector<std::unique_ptr<TShader>> tracePrograms;
+    std::unique_ptr<TShader> compositeProgram;
+    std::unique_ptr<TShader> passProgram;
+    std::unique_ptr<TShader> initProgram;
+    std::unique_ptr<TShader> rayProgram;
+    std::unique_ptr<TShader> compositeSpectralProgram;
+    std::unique_ptr<TShader> traceProgram;
+    /* Per scene, uploaded to the textures below by uploadScene() */
+    std::vector<TSceneTexels> sceneTexels;
+    std::unique_ptr<TTexture> sceneData;
+    std::unique_ptr<TTexture> polylineData;
+    std::unique_ptr<TTexture> materialData;
+    std::unique_ptr<TTexture> iorData;
 
-    std::vector<float>        spectrumTable;
     std::unique_ptr<TTexture> spectrum;
-    std::unique_ptr<TTexture> emission;
-    std::unique_ptr<TTexture> emissionIcdf;
-    std::unique_ptr<TTexture> emissionPdf;
-    std::vector<float>        emissionSpectrum;
-
-    std::vector<float> cdf;
-    std::vector<float> pdf;
-    std::vector<float> icdf;
+    std::unique_ptr<TTexture> emissionAlias;
+    /* SPECTRAL_BINS texels, the color of each bin in spectral mode */
+    std::unique_ptr<TTexture> binResponse;
 
     int maxSampleCount;
     int maxPathLength;
@@ -1036,11 +1328,11 @@ public:
 
     int                pathLength;
     std::vector<float> elapsedTimes;
-    glm::vec2          emitterPos;
-    float              emitterAngle;
-    float              emitterPower;
-    float              spatialSpread;
-    glm::vec2          angularSpread;
+
+    /* Trace four wavelengths per ray until a path disperses */
+    bool heroWavelengths;
+    /* Accumulate spectral bins and convert them in composite() */
+    bool spectral;
 
     std::unique_ptr<TVertexBuffer> rayVbo;
     std::unique_ptr<TRenderTarget> fbo;
@@ -1075,16 +1367,6 @@ public:
 //    std::unique_ptr<globjects::Texture> m_texture;
 //};
 
-class TSceneInfo
-{
-public:
-    std::string shader;
-    std::string name;
-    glm::vec2   posA;
-    glm::vec2   posB;
-    ESpreadType spread;
-};
-
 class Tantalum : public globjects::Instantiator<Tantalum>
 {
 public:
@@ -1109,13 +1391,10 @@ public:
         // scene
         static int scene = 0;
         ImGui::Text("Scene:");
-        ImGui::RadioButton(scene_infos[0].name.c_str(), &scene, 0);
-        ImGui::RadioButton(scene_infos[5].name.c_str(), &scene, 5);
-        ImGui::RadioButton(scene_infos[6].name.c_str(), &scene, 6);
-        ImGui::RadioButton(scene_infos[3].name.c_str(), &scene, 3);
-        ImGui::RadioButton(scene_infos[4].name.c_str(), &scene, 4);
-        ImGui::RadioButton(scene_infos[2].name.c_str(), &scene, 2);
-        ImGui::RadioButton(scene_infos[1].name.c_str(), &scene, 1);
+        for (int i = 0; i < int(scene_infos.size()); i++)
+        {
+            ImGui::RadioButton(scene_infos[i].name.c_str(), &scene, i);
+        }
         if (scene != scene_idx)
         {
             this->selectScene(scene);
@@ -1134,6 +1413,46 @@ public:
             this->setSpreadType((ESpreadType)spread);
         }
 
+        // emission spectrum
+        static int spectrum = 0;
+        ImGui::Text("Emission:");
+        ImGui::RadioButton("White", &spectrum, 0);
+        ImGui::RadioButton("Incandescent", &spectrum, 1);
+        ImGui::RadioButton("Gas discharge", &spectrum, 2);
+        if ((ESpectrumType)spectrum !=
+            this->renderer->emitter.emissionSpectrumType)
+        {
+            this->renderer->setEmissionSpectrumType((ESpectrumType)spectrum);
+        }
+        if (spectrum == 1)
+        {
+            /* Whole kelvins, so dragging back over a temperature finds its
+               tables in the spectrum cache */
+            static float temperature = 5000.0f;
+            if (ImGui::SliderFloat(
+                    "Temperature", &temperature, 1000.0f, 10000.0f, "%.0f K"))
+            {
+                temperature = std::round(temperature);
+                this->renderer->setEmitterTemperature(temperature);
+            }
+        }
+        if (spectrum == 2)
+        {
+            static int gas     = 0;
+            auto       gasName = [](void*, int idx, const char** name) {
+                *name = gasDischargeLines()[idx].name;
+                return true;
+            };
+            if (ImGui::Combo("Gas",
+                             &gas,
+                             gasName,
+                             nullptr,
+                             int(gasDischargeLines().size())))
+            {
+                this->renderer->setEmitterGas(gas);
+            }
+        }
+
         static int length = max_path_length;
         ImGui::Text("Light Path Length:");
         ImGui::SliderInt(" ", &max_path_length, 1, 20);
@@ -1146,6 +1465,25 @@ public:
         static bool inf = true;
         ImGui::Checkbox("Inf", &inf);
 
+        static bool hero = false;
+        if (ImGui::Checkbox("Hero wavelengths", &hero))
+            this->renderer->setHeroWavelengths(hero);
+
+        /* The renderer turns spectral bins off where its textures would be
+           too large */
+        bool spectral = this->renderer->spectral;
+        if (ImGui::Checkbox("Spectral bins", &spectral))
+            this->renderer->setSpectral(spectral);
+        if (this->renderer->spectral)
+        {
+            static int output = 0;
+            ImGui::Text("Spectral output:");
+            bool changed = ImGui::RadioButton("RGB", &output, 0);
+            changed |= ImGui::RadioButton("XYZ", &output, 1);
+            if (changed)
+                this->renderer->setSpectralOutput((ESpectralOutput)output);
+        }
+
         if (ImGui::Button("Reset")) this->renderer->reset();
 
         ImGui::End();
@@ -1221,6 +1559,9 @@ public:
 protected:
     void initialize(int width, int height)
     {
+        enableParallelShaderCompile();
+        enableProgramBinaryCache();
+
         // headers (these must be loaded)
         bsdf = NamedShaderSource::create(
             "/bsdf.glsl", shader_path + "/bsdf.glsl", ShaderOrigin::FromFile);
@@ -1230,6 +1571,41 @@ protected:
                                       shader_path + "/csg-intersect.glsl",
                                       ShaderOrigin::FromFile);
 
+        bvh_intersect =
+            NamedShaderSource::create("/bvh-intersect.glsl",
+                                      shader_path + "/bvh-intersect.glsl",
+                                      ShaderOrigin::FromFile);
+
+        curve_intersect =
+            NamedShaderSource::create("/curve-intersect.glsl",
+                                      shader_path + "/curve-intersect.glsl",
+                                      ShaderOrigin::FromFile);
+
+        grid_intersect =
+            NamedShaderSource::create("/grid-intersect.glsl",
+                                      shader_path + "/grid-intersect.glsl",
+                                      ShaderOrigin::FromFile);
+
+        quadtree_intersect =
+            NamedShaderSource::create("/quadtree-intersect.glsl",
+                                      shader_path + "/quadtree-intersect.glsl",
+                                      ShaderOrigin::FromFile);
+
+        polyline_intersect =
+            NamedShaderSource::create("/polyline-intersect.glsl",
+                                      shader_path + "/polyline-intersect.glsl",
+                                      ShaderOrigin::FromFile);
+
+        material_data =
+            NamedShaderSource::create("/material-data.glsl",
+                                      shader_path + "/material-data.glsl",
+                                      ShaderOrigin::FromFile);
+
+        scene_data =
+            NamedShaderSource::create("/scene-data.glsl",
+                                      shader_path + "/scene-data.glsl",
+                                      ShaderOrigin::FromFile);
+
         intersect = NamedShaderSource::create("/intersect.glsl",
                                               shader_path + "/intersect.glsl",
                                               ShaderOrigin::FromFile);
@@ -1252,19 +1628,11 @@ protected:
 
         test_float_texture_support();
 
-        std::vector<std::string> scenes = {
-            "/scene1.glsl",
-            "/scene2.glsl",
-            "/scene3.glsl",
-            "/scene4.glsl",
-            "/scene5.glsl",
-            "/scene6.glsl",
-            "/scene7.glsl",
-        };
+        scene_infos = builtinSceneInfos(scene_path);
 
         this->resolution = glm::ivec2(width, height);
-        this->renderer =
-            TRenderer::create(this->resolution.x, this->resolution.y, scenes);
+        this->renderer   = TRenderer::create(
+            this->resolution.x, this->resolution.y, scene_infos);
 
         this->setMaxSampleCount(700);
 
@@ -1275,46 +1643,6 @@ protected:
         this->renderer->changeScene(scene_idx);
 
         this->renderer->setNormalizedEmitterPos({0.5f, 0.5f}, {0.5f, 0.5f});
-
-        auto map = [](float a, float b) {
-            return glm::vec2(a * 0.5 / 1.78 + 0.5, -b * 0.5 + 0.5);
-        };
-
-        scene_infos = {{"scene1",
-                        "Lenses",
-                        {0.5, 0.5},
-                        {0.5, 0.5},
-                        ESpreadType::SPREAD_POINT},
-                       {"scene2",
-                        "Rough Mirror Spheres",
-                        {0.25, 0.125},
-                        {0.5, 0.66},
-                        ESpreadType::SPREAD_LASER},
-                       {"scene3",
-                        "Cornell Box",
-                        {0.5, 0.101},
-                        {0.5, 0.2},
-                        ESpreadType::SPREAD_AREA},
-                       {"scene4",
-                        "Prism",
-                        {0.1, 0.65},
-                        {0.4, 0.4},
-                        ESpreadType::SPREAD_LASER},
-                       {"scene5",
-                        "Cardioid",
-                        {0.2, 0.5},
-                        {0.2, 0.5},
-                        ESpreadType::SPREAD_POINT},
-                       {"scene6",
-                        "Spheres",
-                        map(-1.59, 0.65),
-                        map(0.65, -0.75),
-                        ESpreadType::SPREAD_BEAM},
-                       {"scene7",
-                        "Playground",
-                        {0.3, 0.52},
-                        {0.3, 0.52},
-                        ESpreadType::SPREAD_POINT}};
     }
 
     void test_float_texture_support()
@@ -1322,11 +1650,13 @@ protected:
         //
         auto shader = TShader::create(shader_path + "/blend-test-vert.glsl",
                                       shader_path + "/blend-test-frag.glsl",
-                                      ShaderOrigin::FromFile);
+                                      ShaderOrigin::FromFile,
+                                      false);
         auto packShader =
             TShader::create(shader_path + "/blend-test-vert.glsl",
                             shader_path + "/blend-test-pack-frag.glsl",
-                            ShaderOrigin::FromFile);
+                            ShaderOrigin::FromFile,
+                            false);
         float tex_data[] = {-6.0, 10.0, 30.0, 2.0};
         auto  target = TTexture::create(1, 1, 4, true, false, false, tex_data);
         auto  fbo    = TRenderTarget::create();
@@ -1374,7 +1704,14 @@ protected:
 
 protected:
     std::unique_ptr<NamedShaderSource> bsdf;
+    std::unique_ptr<NamedShaderSource> bvh_intersect;
     std::unique_ptr<NamedShaderSource> csg_intersect;
+    std::unique_ptr<NamedShaderSource> curve_intersect;
+    std::unique_ptr<NamedShaderSource> grid_intersect;
+    std::unique_ptr<NamedShaderSource> material_data;
+    std::unique_ptr<NamedShaderSource> polyline_intersect;
+    std::unique_ptr<NamedShaderSource> quadtree_intersect;
+    std::unique_ptr<NamedShaderSource> scene_data;
     std::unique_ptr<NamedShaderSource> intersect;
     std::unique_ptr<NamedShaderSource> preamble;
     std::unique_ptr<NamedShaderSource> rand;
@@ -0,0 +1,318 @@
+#include "emitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "cpu_simd.h"
+#include "tantalum_data.h"
+
+static constexpr float PI = 3.14159265358979323846f;
+
+/* Planck's law at the SPECTRUM_SAMPLES bin centers, a packet of bins at a
+   time. Only the temperature changes from call to call, so the rest of
+   the law is folded into two constants per bin */
+static void blackbodySpectrum(float temperature, float* power)
+{
+    constexpr int SAMPLES = TEmitter::SPECTRUM_SAMPLES;
+
+    struct TPlanckTerms
+    {
+        /* power = scale / (e^(exponent / T) - 1) */
+        alignas(64) float scale[SAMPLES];
+        alignas(64) float exponent[SAMPLES];
+
+        TPlanckTerms()
+        {
+            double h  = 6.626070040e-34;
+            double c  = 299792458.0;
+            double kB = 1.3806488e-23;
+            for (int i = 0; i < SAMPLES; ++i)
+            {
+                double l = (LAMBDA_MIN + (LAMBDA_MAX - LAMBDA_MIN) * (i + 0.5) /
+                                             SAMPLES) *
+                           1e-9;
+                this->scale[i] = 1e-12 * (2.0 * h * c * c) / std::pow(l, 5.0);
+                this->exponent[i] = h * c / (l * kB);
+            }
+        }
+    };
+    static const TPlanckTerms terms;
+
+    vfloat invT = vfloat(1.0f / temperature);
+    for (int i = 0; i < SAMPLES; i += vfloat::SIZE)
+    {
+        vfloat x = vfloat::load(&terms.exponent[i]) * invT;
+        (vfloat::load(&terms.scale[i]) / (exp(x) - vfloat(1.0f)))
+            .store(&power[i]);
+    }
+}
+
+TEmitter::TEmitter()
+{
+    this->spreadType           = ESpreadType::SPREAD_POINT;
+    this->emissionSpectrumType = ESpectrumType::SPECTRUM_WHITE;
+    this->emitterTemperature   = 5000.0;
+    this->emitterGas           = 0;
+
+    this->spectrumTable = wavelengthToRgbTable();
+
+    this->emitterPos   = {0.0f, 0.0f};
+    this->emitterAngle = 0.0f;
+    this->computeSpread();
+}
+
+void TEmitter::setEmitterPos(const glm::vec2& posA, const glm::vec2& posB)
+{
+    this->emitterPos =
+        this->spreadType == ESpreadType::SPREAD_POINT ? posB : posA;
+    this->emitterAngle = this->spreadType == ESpreadType::SPREAD_POINT
+                             ? 0.0
+                             : atan2(posB[1] - posA[1], posB[0] - posA[0]);
+    this->computeSpread();
+}
+
+void TEmitter::computeSpread()
+{
+    switch (this->spreadType)
+    {
+        case ESpreadType::SPREAD_POINT:
+            this->emitterPower  = 0.1;
+            this->spatialSpread = 0.0;
+            this->angularSpread = {0.0, PI * 2.0};
+            break;
+        case ESpreadType::SPREAD_CONE:
+            this->emitterPower  = 0.03;
+            this->spatialSpread = 0.0;
+            this->angularSpread = {this->emitterAngle, PI * 0.3};
+            break;
+        case ESpreadType::SPREAD_BEAM:
+            this->emitterPower  = 0.03;
+            this->spatialSpread = 0.4;
+            this->angularSpread = {this->emitterAngle, 0.0};
+            break;
+        case ESpreadType::SPREAD_LASER:
+            this->emitterPower  = 0.05;
+            this->spatialSpread = 0.0;
+            this->angularSpread = {this->emitterAngle, 0.0};
+            break;
+        case ESpreadType::SPREAD_AREA:
+            this->emitterPower  = 0.1;
+            this->spatialSpread = 0.4;
+            this->angularSpread = {this->emitterAngle, PI};
+            break;
+        default:
+            throw std::runtime_error("unknown spread type");
+            break;
+    }
+}
+
+void TEmitter::computeEmissionSpectrum()
+{
+    ESpectrumType type        = this->emissionSpectrumType;
+    float         temperature = 0.0f;
+    int           gas         = -1;
+    if (type == ESpectrumType::SPECTRUM_INCANDESCENT)
+        temperature = this->emitterTemperature;
+    if (type == ESpectrumType::SPECTRUM_GAS_DISCHARGE) gas = this->emitterGas;
+
+    auto& cache = this->spectrumCache;
+    for (auto entry = cache.begin(); entry != cache.end(); ++entry)
+    {
+        if (entry->type != type || entry->temperature != temperature ||
+            entry->gas != gas)
+            continue;
+
+        cache.splice(cache.begin(), cache, entry);
+        this->emissionSpectrum = entry->emissionSpectrum;
+        this->pdf              = entry->pdf;
+        this->aliasTable       = entry->aliasTable;
+        return;
+    }
+
+    this->emissionSpectrum.resize(SPECTRUM_SAMPLES);
+
+    switch (this->emissionSpectrumType)
+    {
+        case ESpectrumType::SPECTRUM_WHITE:
+        {
+            for (int i = 0; i < SPECTRUM_SAMPLES; i++)
+            {
+                this->emissionSpectrum[i] = 1.0f;
+            }
+        }
+        break;
+        case ESpectrumType::SPECTRUM_INCANDESCENT:
+        {
+            alignas(64) float power[SPECTRUM_SAMPLES];
+            blackbodySpectrum(temperature, power);
+            std::copy(power,
+                      power + SPECTRUM_SAMPLES,
+                      this->emissionSpectrum.begin());
+        }
+        break;
+        case ESpectrumType::SPECTRUM_GAS_DISCHARGE:
+        {
+            auto& wavelengths = gasDischargeLines()[gas].wavelengths;
+            auto& strengths   = gasDischargeLines()[gas].strengths;
+
+            for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+                this->emissionSpectrum[i] = 0.0;
+
+            for (size_t i = 0; i < wavelengths.size(); ++i)
+            {
+                int idx = floor((wavelengths[i] - LAMBDA_MIN) /
+                                (LAMBDA_MAX - LAMBDA_MIN) * SPECTRUM_SAMPLES);
+                if (idx < 0 || idx >= SPECTRUM_SAMPLES) continue;
+
+                this->emissionSpectrum[idx] += strengths[i];
+            }
+        }
+        break;
+        default:
+            throw std::runtime_error("unknown type");
+            break;
+    }
+
+    this->computeSpectrumAliasTable();
+
+    cache.push_front({type,
+                      temperature,
+                      gas,
+                      this->emissionSpectrum,
+                      this->pdf,
+                      this->aliasTable});
+    if (int(cache.size()) > SPECTRUM_CACHE_SIZE) cache.pop_back();
+}
+
+void TEmitter::computeSpectrumAliasTable()
+{
+    if (this->pdf.empty())
+    {
+        this->pdf.resize(SPECTRUM_SAMPLES);
+        this->aliasTable.resize(SPECTRUM_SAMPLES * 4);
+    }
+
+    float sum = 0.0;
+    for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+        sum += this->emissionSpectrum[i];
+
+    float normalization = sum > 0.0f ? SPECTRUM_SAMPLES / sum : 0.0f;
+
+    /* Distribute samples by emission times observer response, so that peaks
+       just barely outside the visible spectrum are not prioritized. The
+       alias table samples every bin with exactly this probability, so no
+       padding is needed to catch narrow gas emission lines */
+    double pdfSum = 0.0;
+    for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+    {
+        this->emissionSpectrum[i] *= normalization;
+
+        float observerResponse =
+            (1.0 / 3.0) * (std::abs(this->spectrumTable[i * 4]) +
+                           std::abs(this->spectrumTable[i * 4 + 1]) +
+                           std::abs(this->spectrumTable[i * 4 + 2]));
+
+        this->pdf[i] = observerResponse * this->emissionSpectrum[i];
+        pdfSum += this->pdf[i];
+    }
+
+    /* Vose's alias method. Bin i is kept with probability scaled[i] and
+       otherwise replaced by alias[i], which donates its excess to it */
+    std::vector<double> scaled(SPECTRUM_SAMPLES);
+    std::vector<int>    alias(SPECTRUM_SAMPLES);
+    std::vector<int>    under, over;
+    for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+    {
+        /* When nothing visible is emitted, sample uniformly; every path
+           then carries zero */
+        scaled[i] = pdfSum > 0.0 ? this->pdf[i] * SPECTRUM_SAMPLES / pdfSum
+                                 : 1.0;
+        alias[i]  = i;
+        (scaled[i] < 1.0 ? under : over).push_back(i);
+    }
+    while (!under.empty() && !over.empty())
+    {
+        int u = under.back();
+        int o = over.back();
+        under.pop_back();
+        over.pop_back();
+
+        alias[u] = o;
+        scaled[o] -= 1.0 - scaled[u];
+        (scaled[o] < 1.0 ? under : over).push_back(o);
+    }
+    /* Whatever is left is 1 up to rounding */
+    for (int i : under) scaled[i] = 1.0;
+    for (int i : over) scaled[i] = 1.0;
+
+    /* pdf is the density over [0, 1] of the sampled spectrum offset, and the
+       table holds emission / pdf so init-frag.glsl divides nothing */
+    if (pdfSum > 0.0)
+    {
+        for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+            this->pdf[i] *= SPECTRUM_SAMPLES / pdfSum;
+    }
+    for (int i = 0; i < SPECTRUM_SAMPLES; ++i)
+    {
+        int   j       = alias[i];
+        float weightI = this->pdf[i] > 0.0f
+                            ? this->emissionSpectrum[i] / this->pdf[i]
+                            : 0.0f;
+        float weightJ = this->pdf[j] > 0.0f
+                            ? this->emissionSpectrum[j] / this->pdf[j]
+                            : 0.0f;
+
+        this->aliasTable[i * 4 + 0] = float(scaled[i]);
+        this->aliasTable[i * 4 + 1] = float(j);
+        this->aliasTable[i * 4 + 2] = weightI;
+        this->aliasTable[i * 4 + 3] = weightJ;
+    }
+}
+
+TEmitterUniforms TEmitter::uniforms(int width, int height) const
+{
+    float aspect = float(width) / float(height);
+
+    TEmitterUniforms result;
+    result.pos.x   = ((this->emitterPos[0] / width) * 2.0 - 1.0) * aspect;
+    result.pos.y   = 1.0 - (this->emitterPos[1] / height) * 2.0;
+    result.dir.x   = cos(this->angularSpread[0]);
+    result.dir.y   = -sin(this->angularSpread[0]);
+    result.power   = this->emitterPower;
+    result.spatialSpread   = this->spatialSpread;
+    result.angularSpread.x = -this->angularSpread[0];
+    result.angularSpread.y = this->angularSpread[1];
+    return result;
+}
+
+std::vector<float> TEmitter::spectralBinResponse(ESpectralOutput output) const
+{
+    /* Linear sRGB to CIE XYZ, D65 white */
+    static const float toXyz[3][3] = {{0.4124f, 0.3576f, 0.1805f},
+                                      {0.2126f, 0.7152f, 0.0722f},
+                                      {0.0193f, 0.1192f, 0.9505f}};
+
+    int                samples = int(this->spectrumTable.size() / 4);
+    std::vector<float> response(SPECTRAL_BINS * 4, 0.0f);
+    for (int i = 0; i < samples; ++i)
+    {
+        int    bin = (i * SPECTRAL_BINS) / samples;
+        float* dst = &response[bin * 4];
+        for (int c = 0; c < 3; ++c)
+            dst[c] += this->spectrumTable[i * 4 + c] * SPECTRAL_BINS / samples;
+    }
+
+    if (output == ESpectralOutput::SPECTRAL_XYZ)
+    {
+        for (int bin = 0; bin < SPECTRAL_BINS; ++bin)
+        {
+            float* dst = &response[bin * 4];
+            float  rgb[3] = {dst[0], dst[1], dst[2]};
+            for (int c = 0; c < 3; ++c)
+                dst[c] = toXyz[c][0] * rgb[0] + toXyz[c][1] * rgb[1] +
+                         toXyz[c][2] * rgb[2];
+        }
+    }
+    return response;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <list>
+#include <vector>
+
+#include "tantalum_data.h"
+
+constexpr float LAMBDA_MIN = 360.0f;
+constexpr float LAMBDA_MAX = 750.0f;
+
+enum class ESpectrumType
+{
+    SPECTRUM_WHITE         = 0,
+    SPECTRUM_INCANDESCENT  = 1,
+    SPECTRUM_GAS_DISCHARGE = 2,
+};
+
+/* What spectral accumulation converts its bins to when compositing */
+enum class ESpectralOutput
+{
+    SPECTRAL_RGB = 0,
+    SPECTRAL_XYZ = 1,
+};
+
+/* Spectral accumulation bins, four to an RGBA plane of the framebuffer:
+   bin b covers [b, b + 1)/SPECTRAL_BINS of [LAMBDA_MIN, LAMBDA_MAX] and is
+   channel b % 4 of plane b / 4 */
+constexpr int SPECTRAL_BINS   = 16;
+constexpr int SPECTRAL_PLANES = SPECTRAL_BINS / 4;
+
+enum class ESpreadType
+{
+    SPREAD_POINT = 0,
+    SPREAD_CONE  = 1,
+    SPREAD_BEAM  = 2,
+    SPREAD_LASER = 3,
+    SPREAD_AREA  = 4,
+};
+
+/* Emitter parameters in ray space, i.e. exactly what init-frag.glsl receives
+   through its uniforms */
+struct TEmitterUniforms
+{
+    glm::vec2 pos;
+    glm::vec2 dir;
+    float     power;
+    float     spatialSpread;
+    glm::vec2 angularSpread;
+};
+
+/* The tables computeEmissionSpectrum derives from one emission setting.
+   temperature is 0 unless type is SPECTRUM_INCANDESCENT and gas -1 unless
+   it is SPECTRUM_GAS_DISCHARGE, so settings that emit alike share an
+   entry */
+struct TSpectrumCacheEntry
+{
+    ESpectrumType      type;
+    float              temperature;
+    int                gas;
+    std::vector<float> emissionSpectrum;
+    std::vector<float> pdf;
+    std::vector<float> aliasTable;
+};
+
+/* Spectral and angular emission model. This holds no GL state so that the GL
+   renderer and the CPU tracer sample light from exactly the same tables */
+class TEmitter
+{
+public:
+    static constexpr int SPECTRUM_SAMPLES = 256;
+    /* Emission settings whose tables are kept, e.g. the temperatures a
+       slider was last dragged over */
+    static constexpr int SPECTRUM_CACHE_SIZE = 16;
+
+    TEmitter();
+
+    void setEmitterPos(const glm::vec2& posA, const glm::vec2& posB);
+
+    void computeSpread();
+
+    /* Fills emissionSpectrum, pdf and aliasTable for the current emission
+       setting, from spectrumCache when it was computed recently */
+    void computeEmissionSpectrum();
+
+    void computeSpectrumAliasTable();
+
+    TEmitterUniforms uniforms(int width, int height) const;
+
+    /* Color of unit radiance in each spectral bin, SPECTRAL_BINS RGBA
+       texels: the mean of spectrumTable over the bin, or its XYZ */
+    std::vector<float> spectralBinResponse(ESpectralOutput output) const;
+
+    ESpreadType   spreadType;
+    ESpectrumType emissionSpectrumType;
+    float         emitterTemperature;
+    int           emitterGas;
+
+    /* wavelengthToRgbTable(), one RGBA texel per spectrum sample */
+    TSpan<const float> spectrumTable;
+    std::vector<float> emissionSpectrum;
+
+    std::vector<float> pdf;
+    /* Alias table of pdf over the SPECTRUM_SAMPLES bins, one RGBA texel per
+       bin: (probability of keeping the bin, alias bin, emission / pdf of the
+       bin, emission / pdf of the alias) */
+    std::vector<float> aliasTable;
+
+    /* Most recently used first, at most SPECTRUM_CACHE_SIZE entries */
+    std::list<TSpectrumCacheEntry> spectrumCache;
+
+    glm::vec2 emitterPos;
+    float     emitterAngle;
+    float     emitterPower;
+    float     spatialSpread;
+    glm::vec2 angularSpread;
+};
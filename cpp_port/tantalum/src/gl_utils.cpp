@@ -1,5 +1,6 @@
 #include <lodepng.h>
 
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <iostream>
 #include <memory>
@@ -82,7 +83,8 @@ std::string NamedShaderSource::string() const
 
 ManagedShader::ManagedShader(const std::string& src,
                              ShaderOrigin       origin,
-                             gl32::GLenum       type)
+                             gl32::GLenum       type,
+                             bool               compileNow)
     : from_file(from_file)
 {
     switch (origin)
@@ -99,16 +101,10 @@ ManagedShader::ManagedShader(const std::string& src,
     }
 
     shader = globjects::Shader::create(type, source.get());
-    shader->compile();
-    if (!shader->isCompiled())
+    if (compileNow)
     {
-        cout << ">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>" << endl;
-        cout << source->string() << endl;
-        cout << "<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<" << endl;
-
-        auto info = shader->infoLog();
-        cout << "info : " << info << endl;
-        throw std::runtime_error("cannot compile shader");
+        startCompile();
+        checkCompile();
     }
 }
 
@@ -123,3 +119,36 @@ globjects::Shader* ManagedShader::get()
 {
     return shader.get();
 }
+
+void ManagedShader::startCompile()
+{
+    glCompileShader(shader->id());
+}
+
+void ManagedShader::checkCompile()
+{
+    GLint status = 0;
+    glGetShaderiv(shader->id(), GL_COMPILE_STATUS, &status);
+    if (!status)
+    {
+        cout << ">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>" << endl;
+        cout << source->string() << endl;
+        cout << "<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<" << endl;
+
+        auto info = shader->infoLog();
+        cout << "info : " << info << endl;
+        throw std::runtime_error("cannot compile shader");
+    }
+}
+
+std::string ManagedShader::uploadedSource()
+{
+    GLint length = 0;
+    glGetShaderiv(shader->id(), GL_SHADER_SOURCE_LENGTH, &length);
+
+    /* length counts the terminating null */
+    std::string text(std::max(length, 1), '\0');
+    glGetShaderSource(shader->id(), length, nullptr, &text[0]);
+    text.resize(std::max(length - 1, 0));
+    return text;
+}
@@ -40,14 +40,27 @@ struct NamedShaderSource : public globjects::Instantiator<NamedShaderSource>
 
 struct ManagedShader : public globjects::Instantiator<ManagedShader>
 {
+    /* Compiles the shader unless compileNow is false, throwing if that fails;
+       startCompile() and checkCompile() then do it in two steps */
     ManagedShader(const std::string& src,
                   ShaderOrigin       origin,
-                  gl32::GLenum       type);
+                  gl32::GLenum       type,
+                  bool               compileNow = true);
 
     ~ManagedShader();
 
     globjects::Shader* get();
 
+    /* Issues the compile without asking for its result, which is what lets
+       GL_KHR_parallel_shader_compile run it on a driver thread */
+    void startCompile();
+
+    /* Waits for the compile, and throws like the constructor if it failed */
+    void checkCompile();
+
+    /* The source as GL has it, with the includes expanded */
+    std::string uploadedSource();
+
     std::unique_ptr<globjects::Shader>               shader;
     std::unique_ptr<globjects::AbstractStringSource> source;
     bool                                             from_file;
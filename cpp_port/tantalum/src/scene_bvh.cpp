@@ -0,0 +1,209 @@
+#include "scene_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+using glm::vec2;
+
+static constexpr int   SAH_BINS       = 16;
+static constexpr float TRAVERSAL_COST = 1.0f;
+
+static float halfPerimeter(vec2 lower, vec2 upper)
+{
+    vec2 extent = glm::max(upper - lower, vec2(0.0f));
+    return extent.x + extent.y;
+}
+
+struct TBvhBuilder
+{
+    struct TItem
+    {
+        TScenePrimitive primitive;
+        vec2            lower;
+        vec2            upper;
+        vec2            centroid;
+    };
+
+    void build(int node, int begin, int end, int depth);
+
+    std::vector<TItem>     items;
+    std::vector<TBvhNode>& nodes;
+};
+
+void TBvhBuilder::build(int index, int begin, int end, int depth)
+{
+    vec2 lower = vec2(1e30f), upper = vec2(-1e30f);
+    vec2 cLower = vec2(1e30f), cUpper = vec2(-1e30f);
+    for (int i = begin; i < end; i++)
+    {
+        lower  = glm::min(lower, this->items[i].lower);
+        upper  = glm::max(upper, this->items[i].upper);
+        cLower = glm::min(cLower, this->items[i].centroid);
+        cUpper = glm::max(cUpper, this->items[i].centroid);
+    }
+
+    int count = end - begin;
+    this->nodes[index] = TBvhNode{lower, upper, begin, count, 0};
+
+    vec2 extent = cUpper - cLower;
+    if (count == 1 || depth >= TSceneBvh::MAX_DEPTH ||
+        (extent.x <= 0.0f && extent.y <= 0.0f))
+        return;
+
+    auto binOf = [&](const TItem& item, int axis) {
+        float scale = SAH_BINS / extent[axis];
+        int   bin   = int((item.centroid[axis] - cLower[axis]) * scale);
+        return std::min(bin, SAH_BINS - 1);
+    };
+
+    /* Binned SAH over both axes */
+    float bestCost = 1e30f;
+    int   bestAxis = 0, bestSplit = 0;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (extent[axis] <= 0.0f) continue;
+
+        int  binCount[SAH_BINS] = {};
+        vec2 binLower[SAH_BINS], binUpper[SAH_BINS];
+        std::fill(binLower, binLower + SAH_BINS, vec2(1e30f));
+        std::fill(binUpper, binUpper + SAH_BINS, vec2(-1e30f));
+
+        for (int i = begin; i < end; i++)
+        {
+            const auto& item = this->items[i];
+            int         bin  = binOf(item, axis);
+            binCount[bin]++;
+            binLower[bin] = glm::min(binLower[bin], item.lower);
+            binUpper[bin] = glm::max(binUpper[bin], item.upper);
+        }
+
+        float rightArea[SAH_BINS];
+        int   rightCount[SAH_BINS];
+        vec2  accLower = vec2(1e30f), accUpper = vec2(-1e30f);
+        int   accCount = 0;
+        for (int bin = SAH_BINS - 1; bin > 0; bin--)
+        {
+            accLower        = glm::min(accLower, binLower[bin]);
+            accUpper        = glm::max(accUpper, binUpper[bin]);
+            accCount       += binCount[bin];
+            rightArea[bin]  = halfPerimeter(accLower, accUpper);
+            rightCount[bin] = accCount;
+        }
+
+        accLower = vec2(1e30f), accUpper = vec2(-1e30f), accCount = 0;
+        for (int split = 1; split < SAH_BINS; split++)
+        {
+            accLower  = glm::min(accLower, binLower[split - 1]);
+            accUpper  = glm::max(accUpper, binUpper[split - 1]);
+            accCount += binCount[split - 1];
+            if (accCount == 0 || rightCount[split] == 0) continue;
+
+            float cost = halfPerimeter(accLower, accUpper) * accCount +
+                         rightArea[split] * rightCount[split];
+            if (cost < bestCost)
+            {
+                bestCost  = cost;
+                bestAxis  = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    /* Relative to intersecting every primitive of the node */
+    bool  found     = bestCost < 1e30f;
+    float splitCost = found ? TRAVERSAL_COST +
+                                  bestCost / halfPerimeter(lower, upper)
+                            : 1e30f;
+    if (splitCost >= float(count) && count <= TSceneBvh::MAX_LEAF_SIZE)
+        return;
+
+    int mid;
+    if (found)
+    {
+        auto split = std::partition(
+            this->items.begin() + begin,
+            this->items.begin() + end,
+            [&](const TItem& item) {
+                return binOf(item, bestAxis) < bestSplit;
+            });
+        mid = int(split - this->items.begin());
+    }
+    else
+    {
+        /* Every centroid landed in one bin; split at the median */
+        bestAxis = extent.x >= extent.y ? 0 : 1;
+        mid      = (begin + end) / 2;
+        std::nth_element(this->items.begin() + begin,
+                         this->items.begin() + mid,
+                         this->items.begin() + end,
+                         [&](const TItem& a, const TItem& b) {
+                             return a.centroid[bestAxis] <
+                                    b.centroid[bestAxis];
+                         });
+    }
+
+    int left = int(this->nodes.size());
+    this->nodes.resize(left + 2);
+    this->nodes[index].first = left;
+    this->nodes[index].count = 0;
+    this->nodes[index].axis  = bestAxis;
+
+    this->build(left, begin, mid, depth + 1);
+    this->build(left + 1, mid, end, depth + 1);
+}
+
+TSceneBvh::TSceneBvh(const TSceneInfo& scene)
+{
+    std::vector<TScenePrimitive> primitives;
+    splitRooms(scene, this->rooms, primitives);
+
+    TBvhBuilder builder{{}, this->nodes};
+    for (const auto& p : primitives)
+    {
+        TBvhBuilder::TItem item;
+        item.primitive = p;
+        primitiveBounds(p, item.lower, item.upper);
+        item.centroid = 0.5f * (item.lower + item.upper);
+        builder.items.push_back(item);
+    }
+    if (builder.items.empty()) return;
+
+    this->nodes.resize(1);
+    builder.build(0, 0, int(builder.items.size()), 0);
+
+    for (const auto& item : builder.items)
+    {
+        this->primitives.push_back(item.primitive);
+    }
+}
+
+std::vector<float> TSceneBvh::texels(int& width, int& height) const
+{
+    int numPrimitives = int(this->primitives.size());
+    int primitiveBase = 2 * int(this->nodes.size());
+    int count         = primitiveBase + PRIMITIVE_TEXELS * numPrimitives;
+
+    std::vector<float> texels = allocateTexels(count, width, height);
+    float*             out    = texels.data();
+    for (const auto& node : this->nodes)
+    {
+        int first = node.count > 0
+                        ? primitiveBase + PRIMITIVE_TEXELS * node.first
+                        : 2 * node.first;
+        float nodeTexels[8] = {node.lower.x,
+                               node.lower.y,
+                               node.upper.x,
+                               node.upper.y,
+                               float(first),
+                               float(node.count),
+                               float(node.axis),
+                               0.0f};
+        out = std::copy(nodeTexels, nodeTexels + 8, out);
+    }
+    for (const auto& p : this->primitives)
+    {
+        out = writePrimitiveTexels(p, out);
+    }
+    return texels;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <vector>
+
+#include "scene_data.h"
+#include "scene_info.h"
+
+/* A node covers [lower, upper]. Leaves hold count > 0 primitives from
+   first; inner nodes have count == 0 and their two children at first and
+   first + 1, the left one with the lower centroids along axis */
+struct TBvhNode
+{
+    glm::vec2 lower;
+    glm::vec2 upper;
+    int       first;
+    int       count;
+    int       axis;
+};
+
+/* SAH bounding volume hierarchy over the primitives of a scene, binned on
+   primitive centroids, with the perimeter taking the place of the surface
+   area. The rooms stay out of the tree, see splitRooms.
+
+   The GLSL traversal in shaders/bvh-intersect.glsl reads the tree from the
+   SceneData texture: two texels per node,
+     (lower, upper) (first texel, count, axis, 0)
+   where first is the texel of the left child or of the first primitive,
+   followed by the primitives in leaf order */
+class TSceneBvh
+{
+public:
+    static constexpr int MAX_LEAF_SIZE = 4;
+    /* Keeps the traversal stack, BVH_STACK_SIZE in bvh-intersect.glsl,
+       from overflowing */
+    static constexpr int MAX_DEPTH  = 30;
+    static constexpr int STACK_SIZE = 32;
+
+    explicit TSceneBvh(const TSceneInfo& scene);
+
+    std::vector<float> texels(int& width, int& height) const;
+
+    std::vector<TScenePrimitive> rooms;
+    std::vector<TScenePrimitive> primitives;
+    std::vector<TBvhNode>        nodes;
+};
@@ -0,0 +1,288 @@
+#include "scene_compiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#include "scene_bvh.h"
+#include "scene_data.h"
+#include "scene_grid.h"
+#include "scene_polyline.h"
+
+std::string glslFloat(float x)
+{
+    char text[32];
+    for (int digits = 6; digits <= 9; digits++)
+    {
+        std::snprintf(text, sizeof(text), "%.*g", digits, x);
+        if (std::strtof(text, nullptr) == x) break;
+    }
+
+    std::string literal = text;
+    if (literal.find_first_of(".en") == std::string::npos) literal += ".0";
+    return literal;
+}
+
+std::vector<float> compileSceneTexels(const TSceneInfo& scene,
+                                      int&              width,
+                                      int&              height,
+                                      int&              listFirst,
+                                      int&              listCount)
+{
+    std::vector<float>           texels;
+    std::vector<TScenePrimitive> listed, accelerated;
+    switch (scene.accelerator)
+    {
+        case EAcceleratorType::BVH:
+            texels = TSceneBvh(scene).texels(width, height);
+            break;
+        case EAcceleratorType::GRID:
+            texels = TSceneGrid(scene).texels(width, height);
+            break;
+        case EAcceleratorType::QUADTREE:
+            texels = TSceneQuadtree(scene).texels(width, height);
+            break;
+        default:
+            break;
+    }
+
+    /* With an accelerator only the rooms are listed */
+    if (scene.accelerator == EAcceleratorType::LINEAR)
+        listed = scene.primitives;
+    else
+        splitRooms(scene, listed, accelerated);
+
+    listFirst = int(texels.size() / 4);
+    listCount = int(listed.size());
+
+    std::vector<float> data =
+        allocateTexels(listFirst + PRIMITIVE_TEXELS * listCount, width, height);
+    float* out = std::copy(texels.begin(), texels.end(), data.data());
+    for (const auto& p : listed)
+    {
+        out = writePrimitiveTexels(p, out);
+    }
+    return data;
+}
+
+std::vector<float> compileSceneMaterialTexels(const TSceneInfo& scene,
+                                              int&              width,
+                                              int&              height)
+{
+    int                count  = scene.materialCount();
+    std::vector<float> texels = allocateTexels(
+        count * MATERIAL_TEXELS, width, height);
+    float* out = texels.data();
+    for (int i = 0; i < count; i++)
+    {
+        out = writeMaterialTexels(scene.material(float(i)), out);
+    }
+    return texels;
+}
+
+std::vector<float> compileSceneIorTexels(const TSceneInfo& scene,
+                                         int&              width,
+                                         int&              height)
+{
+    width  = IOR_SAMPLES;
+    height = scene.materialCount();
+
+    std::vector<float> texels(width * height);
+    float*             out = texels.data();
+    for (int i = 0; i < height; i++)
+    {
+        out = writeIorTexels(scene.material(float(i)), out);
+    }
+    return texels;
+}
+
+std::vector<float> compileScenePolylineTexels(const TSceneInfo& scene,
+                                              int&              width,
+                                              int&              height)
+{
+    int count = int(scene.polylines.size());
+    if (count == 0)
+    {
+        width = height = 0;
+        return std::vector<float>();
+    }
+
+    /* The directory, then the grids */
+    std::vector<float> texels(4 * count, 0.0f);
+    for (int i = 0; i < count; i++)
+    {
+        texels[4 * i] = float(texels.size() / 4);
+        TPolylineGrid(scene.polylines[i]).appendTexels(texels);
+    }
+
+    std::vector<float> data =
+        allocateTexels(int(texels.size() / 4), width, height);
+    std::copy(texels.begin(), texels.end(), data.begin());
+    return data;
+}
+
+bool canCompileSceneCpp(const TSceneInfo& scene)
+{
+    return scene.accelerator == EAcceleratorType::LINEAR &&
+           scene.polylines.empty();
+}
+
+static const char* const primitiveTypeNames[] = {
+    "BBOX",
+    "SPHERE",
+    "LINE",
+    "PRISM",
+    "BICONVEX_LENS",
+    "BICONCAVE_LENS",
+    "MENISCUS_LENS",
+    "PLANO_CONVEX_LENS",
+    "PLANO_CONCAVE_LENS",
+    "POLYLINE",
+    "QUADRATIC_BEZIER",
+    "CUBIC_BEZIER",
+};
+
+static const char* const materialTypeNames[] = {
+    "DIFFUSE",
+    "MIRROR",
+    "ROUGH_MIRROR",
+    "DIELECTRIC",
+    "ROUGH_DIELECTRIC",
+};
+
+/* C++ float literals: {a, b, ...} */
+static std::string cppFloats(const float* v, int count)
+{
+    std::string list = "{";
+    for (int i = 0; i < count; i++)
+    {
+        list += (i ? ", " : "") + glslFloat(v[i]) + "f";
+    }
+    return list + "}";
+}
+
+static std::string cppVec2(glm::vec2 v)
+{
+    float f[] = {v.x, v.y};
+    return cppFloats(f, 2);
+}
+
+static std::string cppVec3(glm::vec3 v)
+{
+    float f[] = {v.x, v.y, v.z};
+    return cppFloats(f, 3);
+}
+
+static void emitStaticMaterial(std::ostream& out, const TSceneMaterial& m)
+{
+    /* The IorData row of dielectrics; other materials have no table */
+    std::string iorTable = "{}";
+    if (m.type == EMaterialType::DIELECTRIC ||
+        m.type == EMaterialType::ROUGH_DIELECTRIC)
+    {
+        float table[IOR_SAMPLES];
+        writeIorTexels(m, table);
+        iorTable = cppFloats(table, IOR_SAMPLES);
+    }
+
+    out << "        TStaticMaterial<EMaterialType::"
+        << materialTypeNames[int(m.type)] << ">{" << glslFloat(m.id) << "f,\n"
+        << "            " << cppVec3(m.albedo) << ",\n"
+        << "            " << (m.faceAlbedo ? "true" : "false") << ",\n"
+        << "            " << cppVec3(m.leftAlbedo) << ",\n"
+        << "            " << cppVec3(m.rightAlbedo) << ",\n"
+        << "            " << glslFloat(m.roughness) << "f,\n"
+        << "            " << iorTable << "}";
+}
+
+std::string compileSceneCpp(const TSceneInfo&  scene,
+                            const std::string& typeName)
+{
+    std::ostringstream out;
+    out << "// " << scene.name << ", compiled from " << scene.file << "\n"
+        << "struct " << typeName << "\n"
+        << "{\n"
+        << "    static constexpr auto primitives = std::make_tuple(";
+    for (size_t i = 0; i < scene.primitives.size(); i++)
+    {
+        const TScenePrimitive& p = scene.primitives[i];
+        out << (i ? ",\n" : "\n")
+            << "        TStaticPrimitive<EPrimitiveType::"
+            << primitiveTypeNames[int(p.type)] << ">{" << cppVec2(p.pos)
+            << ",\n"
+            << "            " << cppVec2(p.size) << ",\n"
+            << "            " << cppFloats(p.params, 4) << ",\n"
+            << "            " << glslFloat(p.matId) << "f}";
+    }
+    out << ");\n"
+        << "\n"
+        << "    static constexpr auto materials = std::make_tuple(\n";
+
+    /* The order of TCpuScene::materials, so the first match wins alike */
+    for (const auto& m : scene.materials)
+    {
+        if (m.id == 0.0f) continue;
+        emitStaticMaterial(out, m);
+        out << ",\n";
+    }
+    emitStaticMaterial(out, scene.material(0.0f));
+    out << ");\n"
+        << "};\n";
+
+    return out.str();
+}
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/* Field by field, so struct padding stays out of the hash */
+template <typename T>
+static void hashValue(uint64_t& hash, const T& value)
+{
+    hash = fnv1a(&value, sizeof(value), hash);
+}
+
+static void hashFloats(uint64_t& hash, const float* v, int count)
+{
+    for (int i = 0; i < count; i++) hashValue(hash, v[i]);
+}
+
+uint64_t sceneFingerprint(const TSceneInfo& scene)
+{
+    uint64_t hash = FNV1A_OFFSET;
+    hashValue(hash, int(scene.primitives.size()));
+    for (const auto& p : scene.primitives)
+    {
+        hashValue(hash, int(p.type));
+        hashFloats(hash, &p.pos.x, 2);
+        hashFloats(hash, &p.size.x, 2);
+        hashFloats(hash, p.params, 4);
+        hashValue(hash, p.matId);
+    }
+    hashValue(hash, int(scene.polylines.size()));
+    hashValue(hash, int(scene.materials.size()));
+    for (const auto& m : scene.materials)
+    {
+        hashValue(hash, m.id);
+        hashValue(hash, int(m.type));
+        hashFloats(hash, &m.albedo.x, 3);
+        hashValue(hash, int(m.faceAlbedo));
+        hashFloats(hash, &m.leftAlbedo.x, 3);
+        hashFloats(hash, &m.rightAlbedo.x, 3);
+        hashValue(hash, m.roughness);
+        hashFloats(hash, &m.sellmeierB.x, 3);
+        hashFloats(hash, &m.sellmeierC.x, 3);
+        hashValue(hash, int(m.iorSqrt));
+        hashValue(hash, m.iorDivisor);
+    }
+    return hash;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "scene_info.h"
+
+/* The SceneData texels of scene, see scene_data.h: those of its
+   accelerator, if any, and its primitive list, listCount primitives from
+   texel listFirst on */
+std::vector<float> compileSceneTexels(const TSceneInfo& scene,
+                                      int&              width,
+                                      int&              height,
+                                      int&              listFirst,
+                                      int&              listCount);
+
+/* The MaterialData texels of the materials of scene, see scene_data.h */
+std::vector<float> compileSceneMaterialTexels(const TSceneInfo& scene,
+                                              int&              width,
+                                              int&              height);
+
+/* The IorData texels of the materials of scene, see scene_data.h; width is
+   IOR_SAMPLES and height the material count */
+std::vector<float> compileSceneIorTexels(const TSceneInfo& scene,
+                                         int&              width,
+                                         int&              height);
+
+/* The PolylineData texels of the polylines of scene, see
+   shaders/polyline-intersect.glsl; empty without polylines */
+std::vector<float> compileScenePolylineTexels(const TSceneInfo& scene,
+                                              int&              width,
+                                              int&              height);
+
+/* Whether compileSceneCpp handles scene: LINEAR scenes without polylines */
+bool canCompileSceneCpp(const TSceneInfo& scene);
+
+/* C++ source of struct typeName, the primitives and materials of scene as
+   constexpr tuples for TStaticScene of cpu_static_scene.h, material 0
+   last. tantalum_scenegen compiles the built-in scenes this way */
+std::string compileSceneCpp(const TSceneInfo&  scene,
+                            const std::string& typeName);
+
+/* 64-bit FNV-1a of size bytes at data, continuing from hash */
+constexpr uint64_t FNV1A_OFFSET = 14695981039346656037ull;
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV1A_OFFSET);
+
+/* Hash of everything compileSceneCpp reads from scene, so equal for
+   scenes that compile to the same TStaticScene; the accelerator is left
+   out */
+uint64_t sceneFingerprint(const TSceneInfo& scene);
+
+/* Shortest GLSL float literal that reads back as exactly x */
+std::string glslFloat(float x);
@@ -0,0 +1,212 @@
+#include "scene_data.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "emitter.h"
+
+using glm::vec2;
+
+/* Rooms aside, slab tests against a box computed in floats can miss a hit
+   the primitive itself reports right on its boundary */
+static constexpr float BOUNDS_PADDING = 1e-4f;
+
+void primitiveBounds(const TScenePrimitive& p, vec2& lower, vec2& upper)
+{
+    const float h = p.params[0], d = p.params[1];
+    const float r1 = p.params[2], r2 = p.params[3];
+
+    /* Lenses are clipped to the vertical span of height h; the horizontal
+       extent is that of the span or box they are clipped to */
+    auto span = [&](float x, float radius) {
+        lower = vec2(x - radius, p.pos.y - h);
+        upper = vec2(x + radius, p.pos.y + h);
+    };
+
+    switch (p.type)
+    {
+        case EPrimitiveType::BBOX:
+            lower = p.pos - p.size;
+            upper = p.pos + p.size;
+            break;
+        case EPrimitiveType::SPHERE:
+            lower = p.pos - vec2(h);
+            upper = p.pos + vec2(h);
+            break;
+        case EPrimitiveType::LINE:
+            lower = glm::min(p.pos, p.size);
+            upper = glm::max(p.pos, p.size);
+            break;
+        case EPrimitiveType::POLYLINE:
+            lower = p.pos;
+            upper = p.size;
+            break;
+        case EPrimitiveType::QUADRATIC_BEZIER:
+        case EPrimitiveType::CUBIC_BEZIER:
+        {
+            /* The hull of the control points holds the curve */
+            vec2 c = vec2(p.params[0], p.params[1]);
+            vec2 e = p.type == EPrimitiveType::CUBIC_BEZIER
+                         ? vec2(p.params[2], p.params[3])
+                         : c;
+            lower  = glm::min(glm::min(p.pos, p.size), glm::min(c, e));
+            upper  = glm::max(glm::max(p.pos, p.size), glm::max(c, e));
+            break;
+        }
+        case EPrimitiveType::PRISM:
+        {
+            /* The corners of prismIntersect */
+            vec2 a = p.pos + vec2(0.0f, 1.0f) * h;
+            vec2 b = p.pos + vec2(0.866f, -0.5f) * h;
+            vec2 c = p.pos + vec2(-0.866f, -0.5f) * h;
+            lower  = glm::min(glm::min(a, b), c);
+            upper  = glm::max(glm::max(a, b), c);
+            break;
+        }
+        case EPrimitiveType::BICONVEX_LENS:
+        {
+            float lo = std::max(p.pos.x + r1 - d - std::abs(r1),
+                                p.pos.x - r2 + d - std::abs(r2));
+            float hi = std::min(p.pos.x + r1 - d + std::abs(r1),
+                                p.pos.x - r2 + d + std::abs(r2));
+            span(0.5f * (lo + hi), 0.5f * (hi - lo));
+            break;
+        }
+        case EPrimitiveType::BICONCAVE_LENS:
+            span(p.pos.x + 0.5f * (r2 - r1),
+                 0.5f * (std::abs(r1) + std::abs(r2)) + d);
+            break;
+        case EPrimitiveType::MENISCUS_LENS:
+            span(p.pos.x + 0.5f * r2, 0.5f * std::abs(r2) + d);
+            break;
+        case EPrimitiveType::PLANO_CONVEX_LENS:
+            span(p.pos.x, d);
+            break;
+        case EPrimitiveType::PLANO_CONCAVE_LENS:
+            span(p.pos.x - 0.5f * r1, 0.5f * std::abs(r1) + d);
+            break;
+    }
+
+    lower -= vec2(BOUNDS_PADDING);
+    upper += vec2(BOUNDS_PADDING);
+}
+
+void splitRooms(const TSceneInfo&             scene,
+                std::vector<TScenePrimitive>& rooms,
+                std::vector<TScenePrimitive>& primitives)
+{
+    for (const auto& p : scene.primitives)
+    {
+        if (p.type == EPrimitiveType::BBOX)
+            rooms.push_back(p);
+        else
+            primitives.push_back(p);
+    }
+}
+
+std::vector<float> allocateTexels(int count, int& width, int& height)
+{
+    width  = SCENE_TEXTURE_WIDTH;
+    height = std::max((count + width - 1) / width, 1);
+    return std::vector<float>(width * height * 4, 0.0f);
+}
+
+float* writePrimitiveTexels(const TScenePrimitive& p, float* out)
+{
+    float texels[4 * PRIMITIVE_TEXELS] = {float(int(p.type)),
+                                          p.matId,
+                                          p.pos.x,
+                                          p.pos.y,
+                                          p.size.x,
+                                          p.size.y,
+                                          p.params[0],
+                                          p.params[1],
+                                          p.params[2],
+                                          p.params[3],
+                                          0.0f,
+                                          0.0f};
+    return std::copy(texels, texels + 4 * PRIMITIVE_TEXELS, out);
+}
+
+float* writeMaterialTexels(const TSceneMaterial& m, float* out)
+{
+    glm::vec3 left  = m.faceAlbedo ? m.leftAlbedo : m.albedo;
+    glm::vec3 right = m.faceAlbedo ? m.rightAlbedo : m.albedo;
+
+    float texels[4 * MATERIAL_TEXELS] = {float(int(m.type)),
+                                         m.roughness,
+                                         m.iorSqrt ? 1.0f : 0.0f,
+                                         m.iorDivisor,
+                                         m.albedo.x,
+                                         m.albedo.y,
+                                         m.albedo.z,
+                                         0.0f,
+                                         left.x,
+                                         left.y,
+                                         left.z,
+                                         0.0f,
+                                         right.x,
+                                         right.y,
+                                         right.z,
+                                         0.0f,
+                                         m.sellmeierB.x,
+                                         m.sellmeierB.y,
+                                         m.sellmeierB.z,
+                                         0.0f,
+                                         m.sellmeierC.x,
+                                         m.sellmeierC.y,
+                                         m.sellmeierC.z,
+                                         0.0f};
+    return std::copy(texels, texels + 4 * MATERIAL_TEXELS, out);
+}
+
+double materialIor(const TSceneMaterial& m, double lambda)
+{
+    double lSq = (lambda * 1e-3) * (lambda * 1e-3);
+    double ior = 1.0;
+    for (int i = 0; i < 3; i++)
+    {
+        ior += m.sellmeierB[i] * lSq / (lSq - m.sellmeierC[i]);
+    }
+    if (m.iorSqrt) ior = std::sqrt(ior);
+    return ior / m.iorDivisor;
+}
+
+float* writeIorTexels(const TSceneMaterial& m, float* out)
+{
+    bool dielectric = m.type == EMaterialType::DIELECTRIC ||
+                      m.type == EMaterialType::ROUGH_DIELECTRIC;
+    for (int k = 0; k < IOR_SAMPLES; k++)
+    {
+        double lambda = LAMBDA_MIN + k * double(LAMBDA_MAX - LAMBDA_MIN) /
+                                         (IOR_SAMPLES - 1);
+        *out++ = dielectric ? float(materialIor(m, lambda)) : 1.0f;
+    }
+    return out;
+}
+
+double iorTableError(const TSceneMaterial& m)
+{
+    float table[IOR_SAMPLES];
+    writeIorTexels(m, table);
+
+    /* Interpolation errors peak between samples; probe each interval at
+       several points rather than only its middle */
+    constexpr int PROBES = 8;
+    double        error  = 0.0;
+    for (int k = 0; k + 1 < IOR_SAMPLES; k++)
+    {
+        for (int j = 1; j < PROBES; j++)
+        {
+            double f      = double(j) / PROBES;
+            double lambda = LAMBDA_MIN + (k + f) *
+                                             double(LAMBDA_MAX - LAMBDA_MIN) /
+                                             (IOR_SAMPLES - 1);
+            double lerp  = table[k] + (table[k + 1] - table[k]) * f;
+            double exact = materialIor(m, lambda);
+            error        = std::max(error, std::abs(lerp - exact));
+        }
+    }
+    return error;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <vector>
+
+#include "scene_info.h"
+
+/* The SceneData texture the trace program reads through
+   shaders/scene-data.glsl: RGBA32F, SCENE_TEXTURE_WIDTH texels per row,
+   addressed by a flat texel index. Each accelerator lays out its own nodes
+   or cells from texel 0 on and ends with the primitives it refers to,
+   PRIMITIVE_TEXELS texels each:
+     (type, matId, pos) (size, params[0], params[1]) (params[2], params[3],
+     0, 0)
+   After them comes the primitive list intersect() walks before the
+   accelerator, in the same format: the rooms in file order, or every
+   primitive for EAcceleratorType::LINEAR */
+constexpr int SCENE_TEXTURE_WIDTH = 1024;
+constexpr int PRIMITIVE_TEXELS    = 3;
+
+/* The MaterialData texture of shaders/material-data.glsl, laid out like
+   SceneData: TSceneInfo::materialCount() materials indexed by id,
+   MATERIAL_TEXELS texels each:
+     (type, roughness, iorSqrt, iorDivisor) (albedo, 0) (leftAlbedo, 0)
+     (rightAlbedo, 0) (sellmeierB, 0) (sellmeierC, 0)
+   Ids without a material of their own hold material 0, and the face
+   albedos are albedo unless faceAlbedo is set */
+constexpr int MATERIAL_TEXELS = 6;
+
+/* The IorData texture of shaders/material-data.glsl: R32F, linearly
+   filtered, one row of IOR_SAMPLES texels per material id. Texel k of a
+   dielectric is its IOR, square root and divisor applied, at
+   LAMBDA_MIN + k*(LAMBDA_MAX - LAMBDA_MIN)/(IOR_SAMPLES - 1); other
+   materials hold 1. The CPU tracer interpolates the same tables. Between
+   the samples the tables of the built-in dielectrics stay within
+   IOR_MAX_ERROR of the Sellmeier equation, see tests/ior_table_test.cpp;
+   the scene parser warns about any other that does not */
+constexpr int   IOR_SAMPLES   = 512;
+constexpr float IOR_MAX_ERROR = 1e-5f;
+
+/* Bounding box of a non-BBOX primitive, padded so slab tests never miss a
+   hit the primitive reports on its boundary */
+void primitiveBounds(const TScenePrimitive& primitive,
+                     glm::vec2&             lower,
+                     glm::vec2&             upper);
+
+/* Splits the primitives of scene into the BBOX rooms, which overwrite the
+   normal of closer hits and so are intersected first in file order, and
+   the rest an accelerator is built over */
+void splitRooms(const TSceneInfo&             scene,
+                std::vector<TScenePrimitive>& rooms,
+                std::vector<TScenePrimitive>& primitives);
+
+/* Zeroed texels for count texels, padded to whole rows */
+std::vector<float> allocateTexels(int count, int& width, int& height);
+
+/* Writes the PRIMITIVE_TEXELS texels of p and returns the end of them */
+float* writePrimitiveTexels(const TScenePrimitive& p, float* out);
+
+/* Writes the MATERIAL_TEXELS texels of m and returns the end of them */
+float* writeMaterialTexels(const TSceneMaterial& m, float* out);
+
+/* The IOR of dielectric m at lambda, evaluated in double precision */
+double materialIor(const TSceneMaterial& m, double lambda);
+
+/* Writes the IOR_SAMPLES texels of m and returns the end of them */
+float* writeIorTexels(const TSceneMaterial& m, float* out);
+
+/* Largest difference between materialIor and the linear interpolation of
+   the IorData texels of dielectric m over [LAMBDA_MIN, LAMBDA_MAX] */
+double iorTableError(const TSceneMaterial& m);
@@ -0,0 +1,257 @@
+#include "scene_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+using glm::ivec2;
+using glm::vec2;
+
+static void sceneBounds(const std::vector<vec2>& lower,
+                        const std::vector<vec2>& upper,
+                        vec2&                    sceneLower,
+                        vec2&                    sceneUpper)
+{
+    sceneLower = vec2(1e30f);
+    sceneUpper = vec2(-1e30f);
+    for (size_t i = 0; i < lower.size(); i++)
+    {
+        sceneLower = glm::min(sceneLower, lower[i]);
+        sceneUpper = glm::max(sceneUpper, upper[i]);
+    }
+}
+
+TSceneGrid::TSceneGrid(const TSceneInfo& scene)
+{
+    splitRooms(scene, this->rooms, this->primitives);
+
+    int               count = int(this->primitives.size());
+    std::vector<vec2> lower(count), upper(count);
+    for (int i = 0; i < count; i++)
+    {
+        primitiveBounds(this->primitives[i], lower[i], upper[i]);
+    }
+    sceneBounds(lower, upper, this->lower, this->upper);
+
+    /* DENSITY * count cells in the aspect ratio of the scene */
+    vec2  extent = glm::max(this->upper - this->lower, vec2(1e-6f));
+    float cell   = std::sqrt(extent.x * extent.y /
+                             std::max(DENSITY * float(count), 1.0f));
+    this->resolution.x =
+        std::min(std::max(int(std::ceil(extent.x / cell)), 1), MAX_RESOLUTION);
+    this->resolution.y =
+        std::min(std::max(int(std::ceil(extent.y / cell)), 1), MAX_RESOLUTION);
+    this->cellSize = extent / vec2(float(this->resolution.x),
+                                   float(this->resolution.y));
+
+    auto cellRange = [&](vec2 a, vec2 b, ivec2& first, ivec2& last) {
+        vec2 lo = glm::floor((a - this->lower) / this->cellSize);
+        vec2 hi = glm::floor((b - this->lower) / this->cellSize);
+        first.x = std::max(int(lo.x), 0);
+        first.y = std::max(int(lo.y), 0);
+        last.x  = std::min(int(hi.x), this->resolution.x - 1);
+        last.y  = std::min(int(hi.y), this->resolution.y - 1);
+    };
+
+    /* Count, then fill the lists of every cell */
+    int numCells = this->resolution.x * this->resolution.y;
+    this->cells.assign(numCells + 1, 0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<int> fill(this->cells.begin(), this->cells.end() - 1);
+        for (int i = 0; i < count; i++)
+        {
+            ivec2 first, last;
+            cellRange(lower[i], upper[i], first, last);
+            for (int y = first.y; y <= last.y; y++)
+            {
+                for (int x = first.x; x <= last.x; x++)
+                {
+                    int c = y * this->resolution.x + x;
+                    if (pass == 0)
+                        this->cells[c + 1]++;
+                    else
+                        this->indices[fill[c]++] = i;
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (int c = 0; c < numCells; c++)
+            {
+                this->cells[c + 1] += this->cells[c];
+            }
+            this->indices.resize(this->cells[numCells]);
+        }
+    }
+}
+
+std::vector<float> TSceneGrid::texels(int& width, int& height) const
+{
+    int numCells      = int(this->cells.size()) - 1;
+    int numIndices    = int(this->indices.size());
+    int numPrimitives = int(this->primitives.size());
+    int indexBase     = 2 + numCells;
+    int primitiveBase = indexBase + numIndices;
+    int count         = primitiveBase + PRIMITIVE_TEXELS * numPrimitives;
+
+    std::vector<float> texels = allocateTexels(count, width, height);
+    float*             out    = texels.data();
+
+    float header[8] = {this->lower.x,
+                       this->lower.y,
+                       this->cellSize.x,
+                       this->cellSize.y,
+                       this->upper.x,
+                       this->upper.y,
+                       float(this->resolution.x),
+                       float(this->resolution.y)};
+    out = std::copy(header, header + 8, out);
+    for (int c = 0; c < numCells; c++)
+    {
+        out[0] = float(indexBase + this->cells[c]);
+        out[1] = float(this->cells[c + 1] - this->cells[c]);
+        out += 4;
+    }
+    for (int index : this->indices)
+    {
+        out[0] = float(primitiveBase + PRIMITIVE_TEXELS * index);
+        out += 4;
+    }
+    for (const auto& p : this->primitives)
+    {
+        out = writePrimitiveTexels(p, out);
+    }
+    return texels;
+}
+
+struct TQuadtreeBuilder
+{
+    void build(int node, const std::vector<int>& items, int depth);
+
+    std::vector<vec2>           lower;
+    std::vector<vec2>           upper;
+    std::vector<TQuadtreeNode>& nodes;
+    std::vector<int>&           indices;
+};
+
+void TQuadtreeBuilder::build(int                     index,
+                             const std::vector<int>& items,
+                             int                     depth)
+{
+    vec2 nodeLower = this->nodes[index].lower;
+    vec2 nodeUpper = this->nodes[index].upper;
+    vec2 mid       = 0.5f * (nodeLower + nodeUpper);
+
+    /* Closed intervals, like the traversal that may end up in either child
+       of a ray right on the split */
+    std::vector<int> children[4];
+    vec2             childLower[4], childUpper[4];
+    for (int c = 0; c < 4; c++)
+    {
+        childLower[c] = vec2(c & 1 ? mid.x : nodeLower.x,
+                             c & 2 ? mid.y : nodeLower.y);
+        childUpper[c] = vec2(c & 1 ? nodeUpper.x : mid.x,
+                             c & 2 ? nodeUpper.y : mid.y);
+    }
+
+    bool split = int(items.size()) > TSceneQuadtree::MAX_LEAF_SIZE &&
+                 depth < TSceneQuadtree::MAX_DEPTH;
+    if (split)
+    {
+        bool helps = false;
+        for (int c = 0; c < 4; c++)
+        {
+            for (int i : items)
+            {
+                if (this->lower[i].x <= childUpper[c].x &&
+                    this->upper[i].x >= childLower[c].x &&
+                    this->lower[i].y <= childUpper[c].y &&
+                    this->upper[i].y >= childLower[c].y)
+                    children[c].push_back(i);
+            }
+            helps = helps || children[c].size() < items.size();
+        }
+        split = helps;
+    }
+
+    if (!split)
+    {
+        this->nodes[index].first = int(this->indices.size());
+        this->nodes[index].count = int(items.size());
+        this->indices.insert(this->indices.end(), items.begin(), items.end());
+        return;
+    }
+
+    int first = int(this->nodes.size());
+    this->nodes[index].first = first;
+    this->nodes[index].count = -1;
+    for (int c = 0; c < 4; c++)
+    {
+        this->nodes.push_back(
+            TQuadtreeNode{childLower[c], childUpper[c], 0, 0});
+    }
+    for (int c = 0; c < 4; c++)
+    {
+        this->build(first + c, children[c], depth + 1);
+    }
+}
+
+TSceneQuadtree::TSceneQuadtree(const TSceneInfo& scene)
+{
+    splitRooms(scene, this->rooms, this->primitives);
+
+    int              count = int(this->primitives.size());
+    TQuadtreeBuilder builder{std::vector<vec2>(count),
+                             std::vector<vec2>(count),
+                             this->nodes,
+                             this->indices};
+    std::vector<int> items(count);
+    for (int i = 0; i < count; i++)
+    {
+        primitiveBounds(
+            this->primitives[i], builder.lower[i], builder.upper[i]);
+        items[i] = i;
+    }
+
+    vec2 lower, upper;
+    sceneBounds(builder.lower, builder.upper, lower, upper);
+    this->nodes.push_back(TQuadtreeNode{lower, upper, 0, 0});
+    builder.build(0, items, 0);
+}
+
+std::vector<float> TSceneQuadtree::texels(int& width, int& height) const
+{
+    int numIndices    = int(this->indices.size());
+    int numPrimitives = int(this->primitives.size());
+    int indexBase     = 2 * int(this->nodes.size());
+    int primitiveBase = indexBase + numIndices;
+    int count         = primitiveBase + PRIMITIVE_TEXELS * numPrimitives;
+
+    std::vector<float> texels = allocateTexels(count, width, height);
+    float*             out    = texels.data();
+    for (const auto& node : this->nodes)
+    {
+        int first = node.count < 0 ? 2 * node.first : indexBase + node.first;
+        float nodeTexels[8] = {node.lower.x,
+                               node.lower.y,
+                               node.upper.x,
+                               node.upper.y,
+                               float(first),
+                               float(node.count),
+                               0.0f,
+                               0.0f};
+        out = std::copy(nodeTexels, nodeTexels + 8, out);
+    }
+    for (int index : this->indices)
+    {
+        out[0] = float(primitiveBase + PRIMITIVE_TEXELS * index);
+        out += 4;
+    }
+    for (const auto& p : this->primitives)
+    {
+        out = writePrimitiveTexels(p, out);
+    }
+    return texels;
+}
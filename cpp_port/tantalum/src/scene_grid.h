@@ -0,0 +1,81 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <vector>
+
+#include "scene_data.h"
+#include "scene_info.h"
+
+/* Uniform grid over the primitives of a scene, about DENSITY cells per
+   primitive with square-ish cells. Every cell lists the primitives whose
+   bounds overlap it, so a primitive may be listed by several cells. The
+   rooms stay out of the grid, see splitRooms.
+
+   shaders/grid-intersect.glsl walks the cells a ray crosses with a 2D DDA,
+   reading the SceneData texture:
+     (lower, cellSize) (upper, resolution)
+   then one texel per cell, row by row,
+     (first index texel, count, 0, 0)
+   one texel per index, (primitive texel, 0, 0, 0), and the primitives */
+class TSceneGrid
+{
+public:
+    static constexpr float DENSITY        = 2.0f;
+    static constexpr int   MAX_RESOLUTION = 256;
+
+    explicit TSceneGrid(const TSceneInfo& scene);
+
+    std::vector<float> texels(int& width, int& height) const;
+
+    std::vector<TScenePrimitive> rooms;
+    std::vector<TScenePrimitive> primitives;
+
+    glm::vec2  lower;
+    glm::vec2  upper;
+    glm::vec2  cellSize;
+    glm::ivec2 resolution;
+
+    /* Cell x, y lists indices[cells[i]] to indices[cells[i + 1]], with
+       i = y * resolution.x + x */
+    std::vector<int> cells;
+    std::vector<int> indices;
+};
+
+/* A node covers [lower, upper]. Inner nodes have count < 0 and the four
+   children from first, split at the center: child 1 is on the upper side
+   in x, child 2 in y. Leaves list indices[first] to indices[first + count] */
+struct TQuadtreeNode
+{
+    glm::vec2 lower;
+    glm::vec2 upper;
+    int       first;
+    int       count;
+};
+
+/* Sparse quadtree over the primitives of a scene: nodes with more than
+   MAX_LEAF_SIZE primitives overlapping them are split, unless that does not
+   take any primitive away from any child. Like in the grid, primitives are
+   listed by every leaf they overlap.
+
+   shaders/quadtree-intersect.glsl walks the leaves a ray crosses without a
+   stack, descending from the root to the leaf the ray is in at the exit
+   distance of the previous one. It reads the SceneData texture: two
+   texels per node,
+     (lower, upper) (first texel, count, 0, 0)
+   where first is the texel of the first child or of the first index, one
+   texel per index, (primitive texel, 0, 0, 0), and the primitives */
+class TSceneQuadtree
+{
+public:
+    static constexpr int MAX_LEAF_SIZE = 4;
+    static constexpr int MAX_DEPTH     = 10;
+
+    explicit TSceneQuadtree(const TSceneInfo& scene);
+
+    std::vector<float> texels(int& width, int& height) const;
+
+    std::vector<TScenePrimitive> rooms;
+    std::vector<TScenePrimitive> primitives;
+    std::vector<TQuadtreeNode>   nodes;
+    std::vector<int>             indices;
+};
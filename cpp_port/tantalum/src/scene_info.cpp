@@ -0,0 +1,585 @@
+#include "scene_info.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <glm/glm.hpp>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "scene_data.h"
+#include "scene_polyline.h"
+
+/* Scene files are line based; '#' starts a comment. Statements:
+
+     name <text>
+     emitter <point|cone|beam|laser|area> <ax> <ay> <bx> <by>
+         emitter preset, positions normalized to the window like
+         setNormalizedEmitterPos
+     accelerator <linear|bvh|grid|quadtree>
+         defaults to bvh for scenes of at least BVH_MIN_PRIMITIVES
+         primitives besides the bboxes, linear otherwise
+     transform <tx> <ty> <scale>
+         p -> scale * p + t for the primitives that follow
+     material <id> <type> [<key> <values>...]
+         ids, here and in <mat> below, are integers below MAX_MATERIALS
+         diffuse           albedo r g b, left r g b, right r g b
+         mirror
+         rough_mirror      roughness s
+         dielectric        sellmeier b1 b2 b3 c1 c2 c3, sqrt, divisor d
+         rough_dielectric  the dielectric keys and roughness s
+
+   and one line per primitive, with the arguments of its GLSL function:
+
+     bbox <cx> <cy> <rx> <ry> <mat>
+     sphere <cx> <cy> <r> <mat>
+     line <ax> <ay> <bx> <by> <mat>
+     prism <cx> <cy> <r> <mat>
+     biconvex_lens | biconcave_lens | meniscus_lens
+         <cx> <cy> <h> <d> <r1> <r2> <mat>
+     plano_convex_lens | plano_concave_lens <cx> <cy> <h> <d> <r> <mat>
+     quadratic_bezier <x0> <y0> <x1> <y1> <x2> <y2> <mat>
+     cubic_bezier <x0> <y0> <x1> <y1> <x2> <y2> <x3> <y3> <mat>
+         the normal is to the left of the direction of the curve, so
+         closed outlines wind clockwise like polygons
+     polygon <x0> <y0> <x1> <y1> <x2> <y2> [<x> <y>...] <mat>
+     polyline <x0> <y0> <x1> <y1> [<x> <y>...] <mat>
+     svg <file> <cx> <cy> <height> <mat>
+         the paths of an SVG file, relative to the scene file, as one
+         polyline scaled to height and centered on cx, cy */
+
+struct TPrimitiveSyntax
+{
+    const char*    keyword;
+    EPrimitiveType type;
+    int            numParams;
+};
+
+static const TPrimitiveSyntax primitiveSyntax[] = {
+    {"bbox", EPrimitiveType::BBOX, 0},
+    {"sphere", EPrimitiveType::SPHERE, 1},
+    {"line", EPrimitiveType::LINE, 0},
+    {"prism", EPrimitiveType::PRISM, 1},
+    {"biconvex_lens", EPrimitiveType::BICONVEX_LENS, 4},
+    {"biconcave_lens", EPrimitiveType::BICONCAVE_LENS, 4},
+    {"meniscus_lens", EPrimitiveType::MENISCUS_LENS, 4},
+    {"plano_convex_lens", EPrimitiveType::PLANO_CONVEX_LENS, 3},
+    {"plano_concave_lens", EPrimitiveType::PLANO_CONCAVE_LENS, 3},
+    {"quadratic_bezier", EPrimitiveType::QUADRATIC_BEZIER, 2},
+    {"cubic_bezier", EPrimitiveType::CUBIC_BEZIER, 4},
+};
+
+static const char* const acceleratorNames[] = {
+    "linear",
+    "bvh",
+    "grid",
+    "quadtree",
+};
+
+static constexpr int BVH_MIN_PRIMITIVES = 16;
+
+class TSceneParser
+{
+public:
+    TSceneParser(const std::string& file) : file(file), line(0)
+    {
+    }
+
+    [[noreturn]] void error(const std::string& message) const
+    {
+        std::string where = this->file;
+        if (this->line > 0) where += ":" + std::to_string(this->line);
+        throw std::runtime_error(where + ": " + message);
+    }
+
+    void warning(const std::string& message) const
+    {
+        std::string where = this->file;
+        if (this->line > 0) where += ":" + std::to_string(this->line);
+        std::cerr << where << ": warning: " << message << std::endl;
+    }
+
+    bool next(std::string& token)
+    {
+        return bool(this->tokens >> token);
+    }
+
+    std::string word(const char* what)
+    {
+        std::string token;
+        if (!this->next(token)) this->error(std::string("expected ") + what);
+        return token;
+    }
+
+    float number(const char* what)
+    {
+        return this->number(this->word(what), what);
+    }
+
+    float number(const std::string& token, const char* what)
+    {
+        size_t      end   = 0;
+        float       value = 0.0f;
+        try
+        {
+            value = std::stof(token, &end);
+        }
+        catch (const std::exception&)
+        {
+            end = 0;
+        }
+        if (end == 0 || end != token.size())
+            this->error(std::string("expected ") + what + ", got '" + token +
+                        "'");
+        return value;
+    }
+
+    glm::vec2 vec2(const char* what)
+    {
+        float x = this->number(what);
+        return glm::vec2(x, this->number(what));
+    }
+
+    glm::vec3 vec3(const char* what)
+    {
+        float x = this->number(what);
+        float y = this->number(what);
+        return glm::vec3(x, y, this->number(what));
+    }
+
+    /* Material ids index the material table of scene_data.h */
+    float materialId()
+    {
+        return this->checkMaterialId(this->number("material id"));
+    }
+
+    float checkMaterialId(float id)
+    {
+        if (id < 0.0f || id >= float(MAX_MATERIALS) || id != std::floor(id))
+            this->error("material ids must be integers in [0, " +
+                        std::to_string(MAX_MATERIALS - 1) + "]");
+        return id;
+    }
+
+    void end()
+    {
+        std::string token;
+        if (this->next(token)) this->error("unexpected '" + token + "'");
+    }
+
+    std::string        file;
+    int                line;
+    std::istringstream tokens;
+};
+
+static ESpreadType parseSpread(TSceneParser& parser)
+{
+    std::string spread = parser.word("emitter type");
+    if (spread == "point") return ESpreadType::SPREAD_POINT;
+    if (spread == "cone") return ESpreadType::SPREAD_CONE;
+    if (spread == "beam") return ESpreadType::SPREAD_BEAM;
+    if (spread == "laser") return ESpreadType::SPREAD_LASER;
+    if (spread == "area") return ESpreadType::SPREAD_AREA;
+    parser.error("unknown emitter type '" + spread + "'");
+}
+
+const char* acceleratorName(EAcceleratorType type)
+{
+    return acceleratorNames[int(type)];
+}
+
+bool parseAccelerator(const std::string& name, EAcceleratorType& type)
+{
+    for (int i = 0; i < int(std::size(acceleratorNames)); i++)
+    {
+        if (name != acceleratorNames[i]) continue;
+        type = EAcceleratorType(i);
+        return true;
+    }
+    return false;
+}
+
+static TSceneMaterial parseMaterial(TSceneParser& parser)
+{
+    TSceneMaterial material;
+    material.id          = parser.materialId();
+    material.albedo      = glm::vec3(1.0f);
+    material.faceAlbedo  = false;
+    material.leftAlbedo  = glm::vec3(1.0f);
+    material.rightAlbedo = glm::vec3(1.0f);
+    material.roughness   = 0.0f;
+    material.sellmeierB  = glm::vec3(0.0f);
+    material.sellmeierC  = glm::vec3(0.0f);
+    material.iorSqrt     = false;
+    material.iorDivisor  = 1.0f;
+
+    std::string type = parser.word("material type");
+    if (type == "diffuse")
+        material.type = EMaterialType::DIFFUSE;
+    else if (type == "mirror")
+        material.type = EMaterialType::MIRROR;
+    else if (type == "rough_mirror")
+        material.type = EMaterialType::ROUGH_MIRROR;
+    else if (type == "dielectric")
+        material.type = EMaterialType::DIELECTRIC;
+    else if (type == "rough_dielectric")
+        material.type = EMaterialType::ROUGH_DIELECTRIC;
+    else
+        parser.error("unknown material type '" + type + "'");
+
+    bool diffuse    = material.type == EMaterialType::DIFFUSE;
+    bool rough      = material.type == EMaterialType::ROUGH_MIRROR ||
+                      material.type == EMaterialType::ROUGH_DIELECTRIC;
+    bool dielectric = material.type == EMaterialType::DIELECTRIC ||
+                      material.type == EMaterialType::ROUGH_DIELECTRIC;
+    bool hasIor     = false;
+
+    std::string key;
+    while (parser.next(key))
+    {
+        if (diffuse && key == "albedo")
+            material.albedo = parser.vec3("albedo");
+        else if (diffuse && (key == "left" || key == "right"))
+        {
+            material.faceAlbedo = true;
+            (key == "left" ? material.leftAlbedo : material.rightAlbedo) =
+                parser.vec3("albedo");
+        }
+        else if (rough && key == "roughness")
+            material.roughness = parser.number("roughness");
+        else if (dielectric && key == "sellmeier")
+        {
+            material.sellmeierB = parser.vec3("sellmeier coefficient");
+            material.sellmeierC = parser.vec3("sellmeier coefficient");
+            hasIor              = true;
+        }
+        else if (dielectric && key == "sqrt")
+            material.iorSqrt = true;
+        else if (dielectric && key == "divisor")
+            material.iorDivisor = parser.number("divisor");
+        else
+            parser.error("unexpected '" + key + "' for " + type);
+    }
+    if (dielectric && !hasIor) parser.error(type + " needs sellmeier");
+    /* Still renders, only with a coarser IOR curve than the analytic one */
+    if (dielectric && !(iorTableError(material) <= IOR_MAX_ERROR))
+        parser.warning("the IOR of this " + type + " varies faster than " +
+                       std::to_string(IOR_SAMPLES) +
+                       " samples over the visible spectrum can follow");
+
+    return material;
+}
+
+static TScenePrimitive parsePrimitive(TSceneParser&           parser,
+                                      const TPrimitiveSyntax& syntax,
+                                      glm::vec2               translation,
+                                      float                   scale)
+{
+    TScenePrimitive primitive = {};
+    primitive.type            = syntax.type;
+    primitive.pos             = parser.vec2("position") * scale + translation;
+
+    bool curve = syntax.type == EPrimitiveType::QUADRATIC_BEZIER ||
+                 syntax.type == EPrimitiveType::CUBIC_BEZIER;
+    if (syntax.type == EPrimitiveType::BBOX)
+        primitive.size = parser.vec2("radius") * scale;
+    else if (syntax.type == EPrimitiveType::LINE)
+        primitive.size = parser.vec2("end point") * scale + translation;
+    else if (curve)
+        primitive.size = parser.vec2("control point") * scale + translation;
+
+    /* The params of curves are control points too */
+    for (int i = 0; i < syntax.numParams; i++)
+    {
+        if (curve)
+        {
+            primitive.params[i] =
+                parser.number("control point") * scale + translation[i % 2];
+        }
+        else
+        {
+            primitive.params[i] = parser.number("size") * scale;
+        }
+    }
+    primitive.matId = parser.materialId();
+    parser.end();
+
+    return primitive;
+}
+
+/* The remaining numbers of the line as points, then the material id */
+static std::vector<glm::vec2> parsePoints(TSceneParser& parser,
+                                          float&        matId,
+                                          size_t        minPoints)
+{
+    std::vector<float> values;
+    std::string        token;
+    while (parser.next(token))
+    {
+        values.push_back(parser.number(token, "point"));
+    }
+    if (values.size() % 2 == 0 || values.size() < 2 * minPoints + 1)
+        parser.error("expected " + std::to_string(minPoints) +
+                     " or more points and a material id");
+
+    std::vector<glm::vec2> points;
+    for (size_t i = 0; i + 1 < values.size(); i += 2)
+    {
+        points.push_back(glm::vec2(values[i], values[i + 1]));
+    }
+    matId = parser.checkMaterialId(values.back());
+    return points;
+}
+
+static std::vector<TSvgPath> parseSvg(TSceneParser& parser, float& matId)
+{
+    std::string file   = parser.word("svg file");
+    glm::vec2   center = parser.vec2("position");
+    float       height = parser.number("height");
+    matId              = parser.materialId();
+    parser.end();
+
+    size_t slash = parser.file.find_last_of("/\\");
+    if (slash != std::string::npos)
+        file = parser.file.substr(0, slash + 1) + file;
+
+    std::vector<TSvgPath> paths = loadSvgPaths(file);
+    glm::vec2             lower = glm::vec2(1e30f), upper = glm::vec2(-1e30f);
+    for (const auto& path : paths)
+    {
+        for (auto p : path.points)
+        {
+            lower = glm::min(lower, p);
+            upper = glm::max(upper, p);
+        }
+    }
+    if (paths.empty() || !(upper.y > lower.y))
+        parser.error(file + " has no paths of any height");
+
+    /* SVG y points down */
+    glm::vec2 middle = 0.5f * (lower + upper);
+    float     scale  = height / (upper.y - lower.y);
+    for (auto& path : paths)
+    {
+        for (auto& p : path.points)
+        {
+            p = center + glm::vec2(p.x - middle.x, middle.y - p.y) * scale;
+        }
+    }
+    return paths;
+}
+
+static TScenePrimitive addPolyline(TSceneInfo&           scene,
+                                   TSceneParser&         parser,
+                                   std::vector<TSvgPath> paths,
+                                   glm::vec2             translation,
+                                   float                 scale,
+                                   float                 matId)
+{
+    TScenePolyline polyline;
+    for (auto& path : paths)
+    {
+        for (auto& p : path.points)
+        {
+            p = p * scale + translation;
+        }
+        appendPath(polyline, path.points, path.closed);
+    }
+    if (polyline.segments.empty()) parser.error("polyline has no length");
+
+    glm::vec2 lower = glm::vec2(1e30f), upper = glm::vec2(-1e30f);
+    for (const auto& segment : polyline.segments)
+    {
+        lower = glm::min(lower, glm::min(segment.a, segment.b));
+        upper = glm::max(upper, glm::max(segment.a, segment.b));
+    }
+
+    TScenePrimitive primitive = {};
+    primitive.type            = EPrimitiveType::POLYLINE;
+    primitive.pos             = lower;
+    primitive.size            = upper;
+    primitive.params[0]       = float(scene.polylines.size());
+    primitive.matId           = matId;
+
+    scene.polylines.push_back(std::move(polyline));
+    return primitive;
+}
+
+int TSceneInfo::materialCount() const
+{
+    float last = 0.0f;
+    for (const auto& material : this->materials)
+    {
+        last = std::max(last, material.id);
+    }
+    for (const auto& primitive : this->primitives)
+    {
+        last = std::max(last, primitive.matId);
+    }
+    return int(last) + 1;
+}
+
+const TSceneMaterial& TSceneInfo::material(float matId) const
+{
+    for (const auto& material : this->materials)
+    {
+        if (material.id == matId) return material;
+    }
+    return this->material(0.0f);
+}
+
+TSceneInfo parseSceneInfo(const std::string& text, const std::string& file)
+{
+    TSceneInfo scene;
+    scene.file        = file;
+    scene.posA        = glm::vec2(0.5f);
+    scene.posB        = glm::vec2(0.5f);
+    scene.spread      = ESpreadType::SPREAD_POINT;
+    scene.accelerator = EAcceleratorType::LINEAR;
+
+    glm::vec2 translation    = glm::vec2(0.0f);
+    float     scale          = 1.0f;
+    bool      hasAccelerator = false;
+
+    TSceneParser       parser(file);
+    std::istringstream lines(text);
+    std::string        line;
+    while (std::getline(lines, line))
+    {
+        parser.line++;
+        parser.tokens.clear();
+        parser.tokens.str(line.substr(0, line.find('#')));
+
+        std::string keyword;
+        if (!parser.next(keyword)) continue;
+
+        if (keyword == "name")
+        {
+            std::getline(parser.tokens >> std::ws, scene.name);
+            while (!scene.name.empty() &&
+                   std::isspace((unsigned char)scene.name.back()))
+                scene.name.pop_back();
+        }
+        else if (keyword == "emitter")
+        {
+            scene.spread = parseSpread(parser);
+            scene.posA   = parser.vec2("emitter position");
+            scene.posB   = parser.vec2("emitter position");
+            parser.end();
+        }
+        else if (keyword == "accelerator")
+        {
+            std::string name = parser.word("accelerator");
+            if (!parseAccelerator(name, scene.accelerator))
+                parser.error("unknown accelerator '" + name + "'");
+            parser.end();
+            hasAccelerator = true;
+        }
+        else if (keyword == "transform")
+        {
+            translation = parser.vec2("translation");
+            scale       = parser.number("scale");
+            parser.end();
+            if (!(scale > 0.0f)) parser.error("scale must be positive");
+        }
+        else if (keyword == "material")
+        {
+            auto material = parseMaterial(parser);
+            for (const auto& other : scene.materials)
+            {
+                if (other.id == material.id)
+                    parser.error("material redefined");
+            }
+            scene.materials.push_back(material);
+        }
+        else if (keyword == "polygon" || keyword == "polyline")
+        {
+            bool  closed = keyword == "polygon";
+            float matId  = 0.0f;
+            auto  points = parsePoints(parser, matId, closed ? 3 : 2);
+            scene.primitives.push_back(addPolyline(scene,
+                                                   parser,
+                                                   {TSvgPath{points, closed}},
+                                                   translation,
+                                                   scale,
+                                                   matId));
+        }
+        else if (keyword == "svg")
+        {
+            float matId = 0.0f;
+            auto  paths = parseSvg(parser, matId);
+            scene.primitives.push_back(addPolyline(
+                scene, parser, paths, translation, scale, matId));
+        }
+        else
+        {
+            const TPrimitiveSyntax* syntax = nullptr;
+            for (const auto& candidate : primitiveSyntax)
+            {
+                if (keyword == candidate.keyword) syntax = &candidate;
+            }
+            if (!syntax) parser.error("unknown statement '" + keyword + "'");
+
+            scene.primitives.push_back(
+                parsePrimitive(parser, *syntax, translation, scale));
+        }
+    }
+
+    parser.line = 0;
+    if (scene.name.empty()) parser.error("scene has no name");
+
+    if (!hasAccelerator)
+    {
+        int count = 0;
+        for (const auto& p : scene.primitives)
+        {
+            count += p.type != EPrimitiveType::BBOX;
+        }
+        scene.accelerator = count >= BVH_MIN_PRIMITIVES
+                                ? EAcceleratorType::BVH
+                                : EAcceleratorType::LINEAR;
+    }
+
+    bool hasDefault = false;
+    for (const auto& material : scene.materials)
+    {
+        hasDefault = hasDefault || material.id == 0.0f;
+    }
+    if (!hasDefault) parser.error("scene has no material 0");
+
+    return scene;
+}
+
+static std::string readFile(const std::string& file)
+{
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("cannot open " + file);
+
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+TSceneInfo loadSceneInfo(const std::string& file)
+{
+    return parseSceneInfo(readFile(file), file);
+}
+
+std::vector<TSceneInfo> builtinSceneInfos(const std::string& sceneDir)
+{
+    std::vector<TSceneInfo> scenes;
+
+    std::istringstream list(readFile(sceneDir + "/scenes.list"));
+    std::string        line;
+    while (std::getline(list, line))
+    {
+        std::istringstream tokens(line.substr(0, line.find('#')));
+        std::string        file;
+        if (tokens >> file)
+            scenes.push_back(loadSceneInfo(sceneDir + "/" + file));
+    }
+    return scenes;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <string>
+#include <vector>
+
+#include "emitter.h"
+
+/* The shapes of shaders/intersect.glsl and shaders/csg-intersect.glsl, the
+   segment chains of shaders/polyline-intersect.glsl and the curves of
+   shaders/curve-intersect.glsl */
+enum class EPrimitiveType
+{
+    BBOX               = 0,
+    SPHERE             = 1,
+    LINE               = 2,
+    PRISM              = 3,
+    BICONVEX_LENS      = 4,
+    BICONCAVE_LENS     = 5,
+    MENISCUS_LENS      = 6,
+    PLANO_CONVEX_LENS  = 7,
+    PLANO_CONCAVE_LENS = 8,
+    POLYLINE           = 9,
+    QUADRATIC_BEZIER   = 10,
+    CUBIC_BEZIER       = 11,
+};
+
+/* The sample functions of shaders/bsdf.glsl */
+enum class EMaterialType
+{
+    DIFFUSE          = 0,
+    MIRROR           = 1,
+    ROUGH_MIRROR     = 2,
+    DIELECTRIC       = 3,
+    ROUGH_DIELECTRIC = 4,
+};
+
+/* How intersect() finds the closest hit: every primitive in turn, or
+   through one of the structures of scene_bvh.h and scene_grid.h */
+enum class EAcceleratorType
+{
+    LINEAR   = 0,
+    BVH      = 1,
+    GRID     = 2,
+    QUADTREE = 3,
+};
+
+/* Arguments of the intersect function of one primitive, after the scene
+   transform:
+     BBOX               pos = center, size = radius
+     SPHERE, PRISM      pos = center, params[0] = radius
+     LINE               pos = a, size = b
+     *_LENS             pos = center, params = h, d, r1, r2; the plano
+                        lenses only have r1
+     POLYLINE           pos = lower, size = upper corner of the bounds,
+                        params[0] = index in TSceneInfo::polylines
+     *_BEZIER           pos = p0, size = p1, params = p2, then p3 for
+                        cubics */
+struct TScenePrimitive
+{
+    EPrimitiveType type;
+    glm::vec2      pos;
+    glm::vec2      size;
+    float          params[4];
+    float          matId;
+};
+
+/* Segments of a POLYLINE primitive, after the scene transform, each from
+   a to b. Closed paths wind clockwise so the lineIntersect normal, to the
+   left of b - a, points out of them as in prismIntersect */
+struct TSceneSegment
+{
+    glm::vec2 a;
+    glm::vec2 b;
+};
+
+struct TScenePolyline
+{
+    std::vector<TSceneSegment> segments;
+};
+
+/* Material ids are integers in [0, MAX_MATERIALS) */
+constexpr int MAX_MATERIALS = 256;
+
+/* One entry of the material table sample() reads. Diffuse surfaces scale the throughput by albedo,
+   or by leftAlbedo / rightAlbedo where the normal is (-1, 0) / (1, 0) if
+   faceAlbedo is set. Dielectrics use the Sellmeier IOR, optionally square
+   rooted, divided by iorDivisor */
+struct TSceneMaterial
+{
+    float         id;
+    EMaterialType type;
+    glm::vec3     albedo;
+    bool          faceAlbedo;
+    glm::vec3     leftAlbedo;
+    glm::vec3     rightAlbedo;
+    float         roughness;
+    glm::vec3     sellmeierB;
+    glm::vec3     sellmeierC;
+    bool          iorSqrt;
+    float         iorDivisor;
+};
+
+/* A scene file: emitter preset, geometry and materials. Material 0 applies
+   to every matId without a material of its own */
+class TSceneInfo
+{
+public:
+    std::string file;
+    std::string name;
+    glm::vec2   posA;
+    glm::vec2   posB;
+    ESpreadType spread;
+
+    EAcceleratorType accelerator;
+
+    std::vector<TScenePrimitive> primitives;
+    std::vector<TScenePolyline>  polylines;
+    std::vector<TSceneMaterial>  materials;
+
+    const TSceneMaterial& material(float matId) const;
+
+    /* One past the largest id of the materials and the primitives: the
+       size of the material table, see scene_data.h */
+    int materialCount() const;
+};
+
+/* Name of type in scene files, and the reverse; false for unknown names */
+const char* acceleratorName(EAcceleratorType type);
+bool        parseAccelerator(const std::string& name, EAcceleratorType& type);
+
+/* Parses the text of a scene file, see scene_info.cpp for the format.
+   Throws std::runtime_error naming file and line on malformed input */
+TSceneInfo parseSceneInfo(const std::string& text, const std::string& file);
+
+TSceneInfo loadSceneInfo(const std::string& file);
+
+/* The scenes listed in sceneDir/scenes.list, in order */
+std::vector<TSceneInfo> builtinSceneInfos(const std::string& sceneDir);
@@ -0,0 +1,584 @@
+#include "scene_polyline.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <glm/glm.hpp>
+#include <sstream>
+#include <stdexcept>
+
+#include "cpu_preamble.h"
+
+using glm::ivec2;
+using glm::vec2;
+
+/* Segments per Bezier curve, and per quarter turn of an elliptical arc */
+static constexpr int CURVE_SEGMENTS = 16;
+static constexpr int ARC_SEGMENTS   = 8;
+
+/* Tokens of SVG path data and point lists: command letters and numbers,
+   with optional separators */
+class TSvgPathScanner
+{
+public:
+    TSvgPathScanner(const std::string& text, const std::string& file)
+        : text(text), file(file), pos(0)
+    {
+    }
+
+    [[noreturn]] void error(const std::string& message) const
+    {
+        throw std::runtime_error(this->file + ": " + message);
+    }
+
+    void skipSeparators()
+    {
+        while (this->pos < this->text.size() &&
+               (std::isspace((unsigned char)this->text[this->pos]) ||
+                this->text[this->pos] == ','))
+            this->pos++;
+    }
+
+    bool atEnd()
+    {
+        this->skipSeparators();
+        return this->pos == this->text.size();
+    }
+
+    bool atNumber()
+    {
+        this->skipSeparators();
+        if (this->pos == this->text.size()) return false;
+        char c = this->text[this->pos];
+        return std::isdigit((unsigned char)c) || c == '-' || c == '+' ||
+               c == '.';
+    }
+
+    char command()
+    {
+        this->skipSeparators();
+        char c = this->text[this->pos];
+        if (!std::isalpha((unsigned char)c))
+            this->error(std::string("expected a path command, got '") + c +
+                        "'");
+        this->pos++;
+        return c;
+    }
+
+    float number()
+    {
+        if (!this->atNumber()) this->error("expected a number in path data");
+
+        /* strtof would read "1.5.5" as one number and the second ".5" is a
+           number of its own in SVG, so find the end first */
+        size_t end = this->pos;
+        if (this->text[end] == '-' || this->text[end] == '+') end++;
+        bool dot = false;
+        while (end < this->text.size() &&
+               (std::isdigit((unsigned char)this->text[end]) ||
+                (this->text[end] == '.' && !dot)))
+        {
+            dot = dot || this->text[end] == '.';
+            end++;
+        }
+        if (end < this->text.size() &&
+            (this->text[end] == 'e' || this->text[end] == 'E'))
+        {
+            size_t exponent = end + 1;
+            if (exponent < this->text.size() &&
+                (this->text[exponent] == '-' || this->text[exponent] == '+'))
+                exponent++;
+            if (exponent < this->text.size() &&
+                std::isdigit((unsigned char)this->text[exponent]))
+            {
+                end = exponent;
+                while (end < this->text.size() &&
+                       std::isdigit((unsigned char)this->text[end]))
+                    end++;
+            }
+        }
+
+        std::string token = this->text.substr(this->pos, end - this->pos);
+        this->pos         = end;
+        char* tail        = nullptr;
+        float value       = std::strtof(token.c_str(), &tail);
+        if (tail == token.c_str())
+            this->error("malformed number '" + token + "'");
+        return value;
+    }
+
+    vec2 point()
+    {
+        float x = this->number();
+        return vec2(x, this->number());
+    }
+
+    /* Arc flags may be written without separators, as in "a1 1 0 011 1" */
+    bool flag()
+    {
+        this->skipSeparators();
+        if (this->pos == this->text.size() ||
+            (this->text[this->pos] != '0' && this->text[this->pos] != '1'))
+            this->error("expected an arc flag");
+        return this->text[this->pos++] == '1';
+    }
+
+private:
+    const std::string& text;
+    const std::string& file;
+    size_t             pos;
+};
+
+static void cubicTo(std::vector<vec2>& points, vec2 p1, vec2 p2, vec2 p3)
+{
+    vec2 p0 = points.back();
+    for (int i = 1; i <= CURVE_SEGMENTS; i++)
+    {
+        float t = float(i) / CURVE_SEGMENTS, s = 1.0f - t;
+        points.push_back(s * s * s * p0 + 3.0f * s * s * t * p1 +
+                         3.0f * s * t * t * p2 + t * t * t * p3);
+    }
+}
+
+static void quadraticTo(std::vector<vec2>& points, vec2 p1, vec2 p2)
+{
+    vec2 p0 = points.back();
+    for (int i = 1; i <= CURVE_SEGMENTS; i++)
+    {
+        float t = float(i) / CURVE_SEGMENTS, s = 1.0f - t;
+        points.push_back(s * s * p0 + 2.0f * s * t * p1 + t * t * p2);
+    }
+}
+
+/* Endpoint to center conversion of SVG 1.1 appendix F.6.5 */
+static void arcTo(std::vector<vec2>& points,
+                  vec2               radius,
+                  float              rotation,
+                  bool               largeArc,
+                  bool               sweep,
+                  vec2               p1)
+{
+    vec2 p0 = points.back();
+    radius  = glm::abs(radius);
+    if (p0 == p1) return;
+    if (radius.x == 0.0f || radius.y == 0.0f)
+    {
+        points.push_back(p1);
+        return;
+    }
+
+    float cosPhi = std::cos(rotation * PI / 180.0f);
+    float sinPhi = std::sin(rotation * PI / 180.0f);
+    vec2  half   = 0.5f * (p0 - p1);
+    vec2  q      = vec2(cosPhi * half.x + sinPhi * half.y,
+                        -sinPhi * half.x + cosPhi * half.y);
+
+    float lambda = (q.x * q.x) / (radius.x * radius.x) +
+                   (q.y * q.y) / (radius.y * radius.y);
+    if (lambda > 1.0f) radius *= std::sqrt(lambda);
+
+    float rx2 = radius.x * radius.x, ry2 = radius.y * radius.y;
+    float num = rx2 * ry2 - rx2 * q.y * q.y - ry2 * q.x * q.x;
+    float den = rx2 * q.y * q.y + ry2 * q.x * q.x;
+    float k   = std::sqrt(std::max(num / den, 0.0f));
+    if (largeArc == sweep) k = -k;
+    vec2 c = k * vec2(radius.x * q.y / radius.y, -radius.y * q.x / radius.x);
+
+    vec2 center = vec2(cosPhi * c.x - sinPhi * c.y,
+                       sinPhi * c.x + cosPhi * c.y) +
+                  0.5f * (p0 + p1);
+
+    auto angle = [](vec2 u, vec2 v) {
+        return std::atan2(u.x * v.y - u.y * v.x, glm::dot(u, v));
+    };
+    vec2  u      = (q - c) / radius;
+    vec2  v      = (-q - c) / radius;
+    float theta  = angle(vec2(1.0f, 0.0f), u);
+    float dTheta = angle(u, v);
+    if (!sweep && dTheta > 0.0f) dTheta -= 2.0f * PI;
+    if (sweep && dTheta < 0.0f) dTheta += 2.0f * PI;
+
+    int n = int(std::ceil(std::abs(dTheta) / PI_HALF * ARC_SEGMENTS));
+    n     = std::max(n, 1);
+    for (int i = 1; i < n; i++)
+    {
+        float a = theta + dTheta * float(i) / n;
+        vec2  e = radius * vec2(std::cos(a), std::sin(a));
+        points.push_back(center +
+                         vec2(cosPhi * e.x - sinPhi * e.y,
+                              sinPhi * e.x + cosPhi * e.y));
+    }
+    points.push_back(p1);
+}
+
+static void parsePathData(const std::string&     data,
+                          const std::string&     file,
+                          std::vector<TSvgPath>& paths)
+{
+    TSvgPathScanner scanner(data, file);
+
+    TSvgPath path  = {{}, false};
+    auto     flush = [&]() {
+        if (path.points.size() >= 2)
+        {
+            if (path.closed && path.points.front() == path.points.back())
+                path.points.pop_back();
+            paths.push_back(path);
+        }
+        path = {{}, false};
+    };
+
+    vec2 current  = vec2(0.0f), start = vec2(0.0f), control = vec2(0.0f);
+    char previous = 0;
+    while (!scanner.atEnd())
+    {
+        char command  = scanner.command();
+        bool relative = std::islower((unsigned char)command);
+        char upper    = char(std::toupper((unsigned char)command));
+
+        if (upper == 'Z')
+        {
+            path.closed = true;
+            current     = start;
+            previous    = upper;
+            flush();
+            continue;
+        }
+        if (upper != 'M' && path.points.empty()) path.points.push_back(current);
+
+        /* Every command but Z repeats while numbers follow */
+        do
+        {
+            vec2 origin = relative ? current : vec2(0.0f);
+            switch (upper)
+            {
+                case 'M':
+                    flush();
+                    current = start = origin + scanner.point();
+                    path.points.push_back(current);
+                    /* Further pairs are implicit lineto commands */
+                    upper = 'L';
+                    break;
+                case 'L':
+                    current = origin + scanner.point();
+                    path.points.push_back(current);
+                    break;
+                case 'H':
+                {
+                    float x  = scanner.number();
+                    current.x = relative ? current.x + x : x;
+                    path.points.push_back(current);
+                    break;
+                }
+                case 'V':
+                {
+                    float y  = scanner.number();
+                    current.y = relative ? current.y + y : y;
+                    path.points.push_back(current);
+                    break;
+                }
+                case 'C':
+                {
+                    vec2 p1 = origin + scanner.point();
+                    vec2 p2 = origin + scanner.point();
+                    vec2 p3 = origin + scanner.point();
+                    cubicTo(path.points, p1, p2, p3);
+                    control = p2;
+                    current = p3;
+                    break;
+                }
+                case 'S':
+                {
+                    bool smooth = previous == 'C' || previous == 'S';
+                    vec2 p1     = smooth ? 2.0f * current - control : current;
+                    vec2 p2     = origin + scanner.point();
+                    vec2 p3     = origin + scanner.point();
+                    cubicTo(path.points, p1, p2, p3);
+                    control = p2;
+                    current = p3;
+                    break;
+                }
+                case 'Q':
+                {
+                    vec2 p1 = origin + scanner.point();
+                    vec2 p2 = origin + scanner.point();
+                    quadraticTo(path.points, p1, p2);
+                    control = p1;
+                    current = p2;
+                    break;
+                }
+                case 'T':
+                {
+                    bool smooth = previous == 'Q' || previous == 'T';
+                    vec2 p1     = smooth ? 2.0f * current - control : current;
+                    vec2 p2     = origin + scanner.point();
+                    quadraticTo(path.points, p1, p2);
+                    control = p1;
+                    current = p2;
+                    break;
+                }
+                case 'A':
+                {
+                    vec2  radius   = scanner.point();
+                    float rotation = scanner.number();
+                    bool  largeArc = scanner.flag();
+                    bool  sweep    = scanner.flag();
+                    vec2  p1       = origin + scanner.point();
+                    arcTo(path.points, radius, rotation, largeArc, sweep, p1);
+                    current = p1;
+                    break;
+                }
+                default:
+                    scanner.error(std::string("unsupported path command '") +
+                                  command + "'");
+            }
+            previous = upper;
+        } while (scanner.atNumber());
+    }
+    flush();
+}
+
+static void parsePointList(const std::string&     data,
+                           const std::string&     file,
+                           bool                   closed,
+                           std::vector<TSvgPath>& paths)
+{
+    TSvgPathScanner scanner(data, file);
+
+    TSvgPath path = {{}, closed};
+    while (!scanner.atEnd())
+    {
+        path.points.push_back(scanner.point());
+    }
+    if (path.points.size() >= 2) paths.push_back(path);
+}
+
+/* Value of attribute name in the tag text, empty if it has none */
+static std::string attribute(const std::string& tag, const std::string& name)
+{
+    for (size_t pos = tag.find(name); pos != std::string::npos;
+         pos        = tag.find(name, pos + 1))
+    {
+        if (pos == 0 || !std::isspace((unsigned char)tag[pos - 1])) continue;
+
+        size_t equals = tag.find_first_not_of(" \t\r\n", pos + name.size());
+        if (equals == std::string::npos || tag[equals] != '=') continue;
+        size_t quote = tag.find_first_not_of(" \t\r\n", equals + 1);
+        if (quote == std::string::npos ||
+            (tag[quote] != '"' && tag[quote] != '\''))
+            continue;
+        size_t end = tag.find(tag[quote], quote + 1);
+        if (end == std::string::npos) break;
+        return tag.substr(quote + 1, end - quote - 1);
+    }
+    return "";
+}
+
+std::vector<TSvgPath> parseSvgPaths(const std::string& text,
+                                    const std::string& file)
+{
+    std::vector<TSvgPath> paths;
+    for (size_t open = text.find('<'); open != std::string::npos;
+         open        = text.find('<', open + 1))
+    {
+        size_t close = text.find('>', open);
+        if (close == std::string::npos) break;
+        std::string tag = text.substr(open + 1, close - open - 1);
+
+        size_t      nameEnd = tag.find_first_of(" \t\r\n/");
+        std::string name    = tag.substr(0, nameEnd);
+        if (name == "path")
+            parsePathData(attribute(tag, "d"), file, paths);
+        else if (name == "polygon" || name == "polyline")
+            parsePointList(
+                attribute(tag, "points"), file, name == "polygon", paths);
+    }
+    return paths;
+}
+
+std::vector<TSvgPath> loadSvgPaths(const std::string& file)
+{
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("cannot open " + file);
+
+    std::stringstream text;
+    text << in.rdbuf();
+    return parseSvgPaths(text.str(), file);
+}
+
+void appendPath(TScenePolyline&          polyline,
+                const std::vector<vec2>& points,
+                bool                     closed)
+{
+    int n = int(points.size());
+
+    /* Twice the signed area, positive for counterclockwise paths */
+    float area = 0.0f;
+    for (int i = 0; closed && i < n; i++)
+    {
+        vec2 a = points[i], b = points[(i + 1) % n];
+        area += a.x * b.y - b.x * a.y;
+    }
+
+    int count = closed ? n : n - 1;
+    for (int i = 0; i < count; i++)
+    {
+        TSceneSegment segment = {points[i], points[(i + 1) % n]};
+        if (area > 0.0f) std::swap(segment.a, segment.b);
+        if (segment.a != segment.b) polyline.segments.push_back(segment);
+    }
+}
+
+TPolylineGrid::TPolylineGrid(const TScenePolyline& polyline)
+{
+    int count = int(polyline.segments.size());
+
+    this->lower = vec2(1e30f);
+    this->upper = vec2(-1e30f);
+    for (const auto& segment : polyline.segments)
+    {
+        this->lower = glm::min(this->lower, glm::min(segment.a, segment.b));
+        this->upper = glm::max(this->upper, glm::max(segment.a, segment.b));
+    }
+    if (count == 0) this->lower = this->upper = vec2(0.0f);
+
+    /* DENSITY * count cells in the aspect ratio of the polyline */
+    vec2  extent = glm::max(this->upper - this->lower, vec2(1e-6f));
+    float cell   = std::sqrt(extent.x * extent.y /
+                           std::max(DENSITY * float(count), 1.0f));
+    this->resolution.x =
+        std::min(std::max(int(std::ceil(extent.x / cell)), 1), MAX_RESOLUTION);
+    this->resolution.y =
+        std::min(std::max(int(std::ceil(extent.y / cell)), 1), MAX_RESOLUTION);
+    vec2 steps = vec2(float(this->resolution.x * CELL_STEPS),
+                      float(this->resolution.y * CELL_STEPS));
+    this->unit     = extent / steps;
+    this->cellSize = this->unit * float(CELL_STEPS);
+    this->upper    = this->lower + steps * this->unit;
+
+    struct TPiece
+    {
+        int      cell;
+        uint32_t a, b;
+    };
+    std::vector<TPiece> pieces;
+
+    auto snap = [&](vec2 p) {
+        vec2 s = glm::floor((p - this->lower) / this->unit + vec2(0.5f));
+        return ivec2(std::min(std::max(int(s.x), 0), int(steps.x)),
+                     std::min(std::max(int(s.y), 0), int(steps.y)));
+    };
+
+    /* Lattice points along a segment where it crosses a cell, with the
+       crossed coordinate exact */
+    struct TCrossing
+    {
+        double s;
+        ivec2  p;
+    };
+    std::vector<TCrossing> crossings;
+    for (const auto& segment : polyline.segments)
+    {
+        ivec2 a = snap(segment.a), b = snap(segment.b);
+        if (a.x == b.x && a.y == b.y) continue;
+
+        crossings.clear();
+        crossings.push_back({0.0, a});
+        crossings.push_back({1.0, b});
+        for (int axis = 0; axis < 2; axis++)
+        {
+            int a0 = axis == 0 ? a.x : a.y, b0 = axis == 0 ? b.x : b.y;
+            int a1 = axis == 0 ? a.y : a.x, b1 = axis == 0 ? b.y : b.x;
+            int lo = std::min(a0, b0), hi = std::max(a0, b0);
+            for (int line = (lo / CELL_STEPS + 1) * CELL_STEPS; line < hi;
+                 line += CELL_STEPS)
+            {
+                double s     = double(line - a0) / double(b0 - a0);
+                int    other = int(std::floor(a1 + (b1 - a1) * s + 0.5));
+                crossings.push_back(
+                    {s, axis == 0 ? ivec2(line, other) : ivec2(other, line)});
+            }
+        }
+        std::sort(crossings.begin(),
+                  crossings.end(),
+                  [](const TCrossing& x, const TCrossing& y) {
+                      return x.s < y.s;
+                  });
+
+        for (size_t i = 0; i + 1 < crossings.size(); i++)
+        {
+            ivec2 p = crossings[i].p, q = crossings[i + 1].p;
+            if (p.x == q.x && p.y == q.y) continue;
+
+            int cellX = std::min((p.x + q.x) / (2 * CELL_STEPS),
+                                 this->resolution.x - 1);
+            int cellY = std::min((p.y + q.y) / (2 * CELL_STEPS),
+                                 this->resolution.y - 1);
+            auto pack = [&](ivec2 e) {
+                int x = std::min(std::max(e.x - cellX * CELL_STEPS, 0),
+                                 CELL_STEPS);
+                int y = std::min(std::max(e.y - cellY * CELL_STEPS, 0),
+                                 CELL_STEPS);
+                return uint32_t(x) | uint32_t(y) << 12;
+            };
+            pieces.push_back(
+                {cellY * this->resolution.x + cellX, pack(p), pack(q)});
+        }
+    }
+
+    /* Counting sort of the pieces by cell */
+    int numCells = this->resolution.x * this->resolution.y;
+    this->cells.assign(numCells + 1, 0);
+    for (const auto& piece : pieces)
+    {
+        this->cells[piece.cell + 1]++;
+    }
+    for (int c = 0; c < numCells; c++)
+    {
+        this->cells[c + 1] += this->cells[c];
+    }
+    std::vector<int> fill(this->cells.begin(), this->cells.end() - 1);
+    this->ends.resize(2 * pieces.size());
+    for (const auto& piece : pieces)
+    {
+        int k                 = fill[piece.cell]++;
+        this->ends[2 * k]     = piece.a;
+        this->ends[2 * k + 1] = piece.b;
+    }
+}
+
+void TPolylineGrid::appendTexels(std::vector<float>& texels) const
+{
+    int numCells    = int(this->cells.size()) - 1;
+    int headerTexel = int(texels.size() / 4);
+    int pieceTexel  = headerTexel + 3 + numCells;
+
+    float header[12] = {this->lower.x,
+                        this->lower.y,
+                        this->cellSize.x,
+                        this->cellSize.y,
+                        this->upper.x,
+                        this->upper.y,
+                        float(this->resolution.x),
+                        float(this->resolution.y),
+                        this->unit.x,
+                        this->unit.y,
+                        float(pieceTexel),
+                        0.0f};
+    texels.insert(texels.end(), header, header + 12);
+    for (int c = 0; c < numCells; c++)
+    {
+        float cell[4] = {float(this->cells[c]),
+                         float(this->cells[c + 1] - this->cells[c]),
+                         0.0f,
+                         0.0f};
+        texels.insert(texels.end(), cell, cell + 4);
+    }
+    for (uint32_t end : this->ends)
+    {
+        texels.push_back(float(end));
+    }
+    texels.resize((texels.size() + 3) / 4 * 4, 0.0f);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <string>
+#include <vector>
+
+#include "scene_info.h"
+
+/* A path of an SVG file, in SVG user units with y pointing down. Curves and
+   arcs are flattened into segments */
+struct TSvgPath
+{
+    std::vector<glm::vec2> points;
+    bool                   closed;
+};
+
+/* The <path>, <polygon> and <polyline> elements of an SVG document, in
+   document order. Transforms and styles are ignored. Throws
+   std::runtime_error naming file on malformed path data */
+std::vector<TSvgPath> parseSvgPaths(const std::string& text,
+                                    const std::string& file);
+
+std::vector<TSvgPath> loadSvgPaths(const std::string& file);
+
+/* Adds the segments from one point to the next, and back to the first one
+   if closed. Closed paths are reversed if needed to wind clockwise */
+void appendPath(TScenePolyline&               polyline,
+                const std::vector<glm::vec2>& points,
+                bool                          closed);
+
+/* Uniform grid over the segments of a polyline, about DENSITY cells per
+   segment. Segment ends are snapped to a lattice of CELL_STEPS steps per
+   cell and segments are split where they cross a cell, so every piece lies
+   in the one cell that lists it. A piece stores its ends relative to the
+   corner of that cell, as x + 4096 * y in lattice steps: 24 bits that a
+   float holds exactly. Pieces sharing an end decode it to the same point,
+   so closed paths stay closed.
+
+   shaders/polyline-intersect.glsl walks the cells like grid-intersect.glsl
+   walks the scene grid, reading the PolylineData texture:
+     (lower, cellSize) (upper, resolution) (unit, piece texel, 0)
+   then one texel per cell, row by row, (first piece, count, 0, 0), and two
+   pieces per texel, (a, b, a, b) */
+class TPolylineGrid
+{
+public:
+    static constexpr int   CELL_STEPS     = 2048;
+    static constexpr float DENSITY        = 0.5f;
+    static constexpr int   MAX_RESOLUTION = 1024;
+
+    explicit TPolylineGrid(const TScenePolyline& polyline);
+
+    /* Appends the texels of the layout above to the RGBA texels, whose
+       indices it refers to */
+    void appendTexels(std::vector<float>& texels) const;
+
+    /* End of a piece in cell x, y */
+    glm::vec2 decode(int x, int y, uint32_t end) const
+    {
+        float stepX = float(x * CELL_STEPS + int(end & 4095u));
+        float stepY = float(y * CELL_STEPS + int(end >> 12));
+        return this->lower + glm::vec2(stepX, stepY) * this->unit;
+    }
+
+    glm::vec2  lower;
+    glm::vec2  upper;
+    glm::vec2  cellSize;
+    glm::vec2  unit;
+    glm::ivec2 resolution;
+
+    /* Cell x, y holds pieces cells[i] to cells[i + 1], with
+       i = y * resolution.x + x */
+    std::vector<int> cells;
+    /* Two ends per piece, a then b */
+    std::vector<uint32_t> ends;
+};
@@ -1,614 +1,590 @@
 #include "tantalum_data.h"
 
-#include <iostream>
+namespace
+{
 
-using std::cout;
-using std::endl;
+constexpr float aluminumWavelengths[] = {
+    390.068, 393.2,   394.4,   396.152, 399.586, 422.681, 458.582, 458.819,
+    466.68,  489.876, 490.277, 528.021, 510.752, 528.377, 528.585, 531.232,
+    531.607, 537.184, 555.706, 555.795, 559.323, 585.362, 597.194, 600.176,
+    600.188, 600.642, 606.111, 606.843, 606.853, 607.323, 618.157, 618.168,
+    618.228, 618.245, 618.342, 620.152, 620.17,  622.618, 623.178, 624.336,
+    633.574, 669.602, 669.867, 708.397, 708.464};
+constexpr int aluminumStrengths[] = {
+    450, 60,  4500, 9000, 110, 290, 150, 110, 550, 110, 110, 150, 70,  290, 150,
+    110, 220, 150,  180,  110, 450, 110, 220, 290, 220, 450, 150, 290, 110, 450,
+    110, 150, 290,  220,  450, 450, 360, 290, 360, 450, 450, 360, 230, 60,  70};
 
-TantalumData::TantalumData()
-{
-    std::call_once(flag, [this]() { this->init_data(); });
-}
+constexpr float argonWavelengths[] = {
+    392.572, 392.862, 393.255, 394.61,  394.751, 394.898, 397.936, 399.479,
+    401.386, 403.381, 403.546, 404.289, 404.442, 405.292, 407.201, 407.239,
+    407.663, 407.957, 408.239, 410.391, 413.172, 415.609, 415.859, 416.418,
+    417.93,  418.188, 419.071, 419.103, 419.832, 420.067, 421.867, 422.264,
+    422.699, 422.816, 423.722, 425.119, 425.936, 426.629, 426.653, 427.217,
+    427.753, 428.29,  430.01,  430.065, 430.924, 433.12,  433.203, 433.356,
+    433.534, 434.517, 434.806, 435.221, 436.207, 436.783, 437.075, 437.133,
+    437.595, 437.967, 438.506, 440.01,  440.099, 442.6,   443.019, 443.1,
+    443.384, 443.946, 444.888, 447.476, 448.181, 451.073, 452.232, 453.055,
+    454.505, 456.441, 457.935, 458.99,  459.61,  460.957, 462.844, 463.723,
+    465.79,  470.232, 472.159, 472.687, 473.205, 473.591, 476.487, 480.602,
+    484.781, 486.591, 487.986, 488.904, 490.475, 493.321, 496.508, 500.933,
+    501.716, 506.204, 509.05,  514.178, 514.531, 515.139, 516.229, 516.577,
+    518.775, 521.681, 522.127, 542.135, 545.165, 549.587, 550.611, 555.87,
+    557.254, 560.673, 565.07,  573.952, 583.426, 586.031, 588.262, 588.858,
+    591.209, 592.881, 594.267, 598.73,  599.9,   602.515, 603.213, 604.322,
+    605.272, 605.937, 609.88,  610.564, 611.492, 614.544, 617.017, 617.228,
+    617.31,  621.25,  621.594, 624.312, 629.687, 630.766, 636.958, 638.472,
+    641.631, 648.308, 653.811, 660.485, 663.822, 663.974, 664.37,  666.068,
+    666.405, 666.636, 667.728, 668.429, 675.283, 675.616, 676.661, 686.127,
+    687.129, 687.958, 688.817, 693.766, 695.148, 696.025, 696.543, 703.025,
+    706.722, 706.874, 710.748, 712.582, 714.704, 715.884};
+constexpr int argonStrengths[] = {
+    35,   50,  25,  70,  7,    35,  20,  35,  50,  50,  20,  150, 50,   100,
+    200,  70,  25,  35,  25,   150, 300, 35,  400, 50,  35,  50,  100,  50,
+    200,  400, 25,  25,  25,   100, 100, 25,  200, 100, 70,  150, 550,  20,
+    100,  25,  70,  200, 50,   100, 50,  25,  800, 50,  25,  50,  200,  70,
+    50,   150, 50,  70,  200,  400, 150, 50,  50,  20,  35,  100, 200,  100,
+    20,   20,  400, 20,  400,  400, 15,  550, 7,   35,  400, 15,  20,   550,
+    50,   300, 800, 550, 150,  50,  800, 70,  20,  35,  200, 50,  70,   70,
+    20,   100, 70,  5,   15,   25,  20,  20,  7,   5,   10,  25,  5,    25,
+    10,   35,  20,  10,  5,    10,  15,  25,  50,  15,  5,   7,   5,    5,
+    70,   35,  10,  20,  7,    10,  100, 10,  7,   150, 10,  10,  5,    25,
+    7,    15,  7,   20,  70,   25,  15,  15,  25,  20,  50,  5,   5,    25,
+    100,  35,  150, 5,   15,   20,  150, 5,   10,  50,  7,   7,   9999, 150,
+    9999, 100, 25,  25,  1000, 15};
 
-void TantalumData::init_data()
-{
-    lines = {
-        {"Aluminum",
-         std::vector<float>{
-             390.068, 393.2,   394.4,   396.152, 399.586, 422.681, 458.582,
-             458.819, 466.68,  489.876, 490.277, 528.021, 510.752, 528.377,
-             528.585, 531.232, 531.607, 537.184, 555.706, 555.795, 559.323,
-             585.362, 597.194, 600.176, 600.188, 600.642, 606.111, 606.843,
-             606.853, 607.323, 618.157, 618.168, 618.228, 618.245, 618.342,
-             620.152, 620.17,  622.618, 623.178, 624.336, 633.574, 669.602,
-             669.867, 708.397, 708.464},
-         std::vector<int>{450, 60,  4500, 9000, 110, 290, 150, 110, 550,
-                          110, 110, 150,  70,   290, 150, 110, 220, 150,
-                          180, 110, 450,  110,  220, 290, 220, 450, 150,
-                          290, 110, 450,  110,  150, 290, 220, 450, 450,
-                          360, 290, 360,  450,  450, 360, 230, 60,  70}},
-        {"Argon",
-         std::vector<float>{
-             392.572, 392.862, 393.255, 394.61,  394.751, 394.898, 397.936,
-             399.479, 401.386, 403.381, 403.546, 404.289, 404.442, 405.292,
-             407.201, 407.239, 407.663, 407.957, 408.239, 410.391, 413.172,
-             415.609, 415.859, 416.418, 417.93,  418.188, 419.071, 419.103,
-             419.832, 420.067, 421.867, 422.264, 422.699, 422.816, 423.722,
-             425.119, 425.936, 426.629, 426.653, 427.217, 427.753, 428.29,
-             430.01,  430.065, 430.924, 433.12,  433.203, 433.356, 433.534,
-             434.517, 434.806, 435.221, 436.207, 436.783, 437.075, 437.133,
-             437.595, 437.967, 438.506, 440.01,  440.099, 442.6,   443.019,
-             443.1,   443.384, 443.946, 444.888, 447.476, 448.181, 451.073,
-             452.232, 453.055, 454.505, 456.441, 457.935, 458.99,  459.61,
-             460.957, 462.844, 463.723, 465.79,  470.232, 472.159, 472.687,
-             473.205, 473.591, 476.487, 480.602, 484.781, 486.591, 487.986,
-             488.904, 490.475, 493.321, 496.508, 500.933, 501.716, 506.204,
-             509.05,  514.178, 514.531, 515.139, 516.229, 516.577, 518.775,
-             521.681, 522.127, 542.135, 545.165, 549.587, 550.611, 555.87,
-             557.254, 560.673, 565.07,  573.952, 583.426, 586.031, 588.262,
-             588.858, 591.209, 592.881, 594.267, 598.73,  599.9,   602.515,
-             603.213, 604.322, 605.272, 605.937, 609.88,  610.564, 611.492,
-             614.544, 617.017, 617.228, 617.31,  621.25,  621.594, 624.312,
-             629.687, 630.766, 636.958, 638.472, 641.631, 648.308, 653.811,
-             660.485, 663.822, 663.974, 664.37,  666.068, 666.405, 666.636,
-             667.728, 668.429, 675.283, 675.616, 676.661, 686.127, 687.129,
-             687.958, 688.817, 693.766, 695.148, 696.025, 696.543, 703.025,
-             706.722, 706.874, 710.748, 712.582, 714.704, 715.884},
-         std::vector<int>{
-             35,  50,  25,  70,   7,   35,  20,  35,  50,  50,  20,   150, 50,
-             100, 200, 70,  25,   35,  25,  150, 300, 35,  400, 50,   35,  50,
-             100, 50,  200, 400,  25,  25,  25,  100, 100, 25,  200,  100, 70,
-             150, 550, 20,  100,  25,  70,  200, 50,  100, 50,  25,   800, 50,
-             25,  50,  200, 70,   50,  150, 50,  70,  200, 400, 150,  50,  50,
-             20,  35,  100, 200,  100, 20,  20,  400, 20,  400, 400,  15,  550,
-             7,   35,  400, 15,   20,  550, 50,  300, 800, 550, 150,  50,  800,
-             70,  20,  35,  200,  50,  70,  70,  20,  100, 70,  5,    15,  25,
-             20,  20,  7,   5,    10,  25,  5,   25,  10,  35,  20,   10,  5,
-             10,  15,  25,  50,   15,  5,   7,   5,   5,   70,  35,   10,  20,
-             7,   10,  100, 10,   7,   150, 10,  10,  5,   25,  7,    15,  7,
-             20,  70,  25,  15,   15,  25,  20,  50,  5,   5,   25,   100, 35,
-             150, 5,   15,  20,   150, 5,   10,  50,  7,   7,   9999, 150, 9999,
-             100, 25,  25,  1000, 15}},
-        {"Barium",
-         std::vector<float>{
-             405.371, 408.096, 408.487, 408.725, 408.734, 413.065, 413.243,
-             416.6,   417.935, 422.396, 423.956, 424.26,  426.442, 426.792,
-             428.31,  429.116, 430.518, 430.927, 430.927, 432.3,   432.511,
-             433.291, 435.033, 435.953, 440.254, 440.683, 441.366, 443.189,
-             446.709, 448.898, 449.364, 450.435, 450.592, 452.317, 452.493,
-             455.403, 457.385, 457.964, 458.976, 459.182, 459.972, 460.498,
-             461.992, 462.833, 467.362, 469.161, 469.744, 469.91,  470.042,
-             472.471, 472.643, 487.765, 489.993, 490.285, 493.408, 494.731,
-             495.709, 499.564, 501.295, 501.295, 504.955, 505.496, 509.754,
-             510.225, 513.454, 515.988, 525.38,  530.57,  542.455, 543.732,
-             551.904, 553.548, 553.587, 559.331, 568.0,   568.018, 577.762,
-             578.404, 580.023, 580.568, 581.881, 582.627, 585.368, 590.764,
-             597.17,  597.846, 599.709, 599.8,   601.947, 606.311, 608.339,
-             610.199, 611.078, 612.923, 614.171, 634.168, 637.711, 638.376,
-             641.111, 645.085, 648.291, 649.69,  649.876, 652.617, 652.731,
-             659.533, 665.411, 667.527, 669.384, 676.948, 677.186, 686.569,
-             686.791, 687.408, 687.408, 696.148},
-         std::vector<int>{
-             18,  13,  43,  8,   9,    910, 309,  103, 14,  34,  25,   17,
-             42,  8,   530, 26,  6,    4,   4,    61,  18,  39,  271,  9,
-             273, 29,  13,  374, 30,   234, 137,  5,   209, 327, 188,  9300,
-             230, 580, 22,  28,  108,  28,  40,   63,  133, 306, 15,   24,
-             80,  8,   371, 66,  273,  63,  6900, 25,  10,  5,   5,    5,
-             10,  19,  10,  12,  10,   80,  5,    6,   199, 5,   280,  1830,
-             112, 5,   21,  41,  740,  5,   203,  419, 14,  610, 331,  94,
-             700, 8,   620, 10,  610,  840, 5,    13,  880, 5,   1510, 900,
-             10,  10,  3,   580, 1770, 900, 1060, 8,   890, 740, 9,    462,
-             454, 6,   4,   62,  8,    7,   7,    1}},
-        {"Calcium",
-         std::vector<float>{
-             362.411, 363.075, 363.097, 364.441, 364.477, 364.499, 367.529,
-             367.821, 368.37,  369.411, 369.436, 370.603, 373.69,  373.938,
-             374.835, 375.029, 375.334, 375.567, 375.839, 387.048, 387.254,
-             387.256, 387.578, 387.58,  388.91,  392.348, 393.366, 393.529,
-             394.604, 394.89,  395.705, 396.847, 397.257, 397.371, 408.177,
-             409.71,  409.853, 409.857, 410.982, 411.028, 415.357, 416.431,
-             418.42,  420.618, 420.724, 422.007, 422.673, 423.374, 424.046,
-             424.074, 428.301, 428.439, 428.936, 429.899, 430.253, 430.281,
-             430.774, 431.865, 432.919, 433.357, 435.508, 435.838, 439.959,
-             440.629, 442.544, 443.13,  443.496, 443.569, 445.478, 445.589,
-             445.661, 447.204, 447.923, 448.918, 449.988, 451.659, 452.694,
-             457.212, 457.855, 458.14,  458.147, 458.587, 458.596, 468.527,
-             470.883, 471.627, 471.674, 472.103, 479.997, 485.917, 487.813,
-             500.148, 500.895, 501.997, 502.114, 504.162, 505.007, 518.885,
-             523.182, 524.737, 526.171, 526.224, 526.424, 526.556, 527.027,
-             527.198, 528.527, 530.132, 530.722, 532.129, 532.806, 533.919,
-             534.947, 551.298, 557.058, 557.906, 558.197, 558.876, 559.012,
-             559.447, 559.849, 560.129, 560.285, 585.745, 592.272, 592.369,
-             606.998, 610.272, 612.222, 616.129, 616.217, 616.376, 616.644,
-             616.906, 616.956, 617.322, 621.398, 629.489, 637.011, 638.755,
-             642.451, 643.907, 644.981, 645.56,  645.687, 646.257, 647.166,
-             648.535, 649.378, 649.965, 653.878, 654.224, 657.278, 671.769,
-             714.815, 720.219, 730.869, 732.615},
-         std::vector<int>{
-             15, 17, 14, 20, 14, 8,  5,  6,  30, 40, 10,  170, 180, 10, 6,  8,
-             9,  20, 30, 9,  11, 11, 12, 12, 6,  6,  230, 9,   6,   15, 17, 220,
-             8,  18, 15, 50, 15, 15, 60, 30, 15, 15, 15,  40,  18,  50, 50, 17,
-             15, 16, 24, 15, 22, 22, 25, 20, 23, 22, 15,  16,  20,  15, 19, 17,
-             25, 17, 26, 25, 30, 28, 20, 20, 10, 20, 19,  18,  23,  18, 22, 23,
-             23, 24, 24, 20, 11, 11, 30, 40, 40, 10, 25,  70,  10,  80, 40, 23,
-             10, 25, 10, 11, 22, 23, 22, 24, 25, 13, 60,  10,  70,  11, 10, 50,
-             27, 23, 11, 10, 25, 27, 24, 26, 25, 24, 24,  30,  10,  10, 13, 27,
-             29, 22, 30, 22, 24, 26, 28, 10, 12, 11, 11,  10,  12,  35, 30, 22,
-             80, 34, 29, 12, 32, 28, 10, 10, 23, 30, 33,  31,  10,  33}},
-        {"Carbon",
-         std::vector<float>{
-             391.898, 392.069, 407.452, 407.585, 426.7,   426.726, 477.175,
-             493.205, 505.217, 513.294, 513.328, 514.349, 514.516, 515.109,
-             538.034, 564.807, 566.247, 588.977, 589.159, 600.113, 600.603,
-             600.718, 601.068, 601.322, 601.484, 657.805, 658.288, 658.761,
-             678.39,  711.318, 711.519, 711.563, 711.699, 711.99},
-         std::vector<int>{570, 800, 250, 350, 800, 1000, 200, 200, 200,
-                          350, 350, 350, 570, 400, 300,  250, 350, 570,
-                          350, 200, 250, 110, 150, 300,  250, 800, 570,
-                          200, 250, 250, 250, 250, 200,  350}},
-        {"Helium",
-         std::vector<float>{
-             396.473, 400.927, 402.619, 402.636, 412.082, 412.099, 414.376,
-             438.793, 443.755, 447.148, 447.168, 468.54,  468.57,  471.315,
-             471.338, 492.193, 501.568, 504.774, 541.152, 587.562, 587.597,
-             656.01,  667.815, 686.748, 706.519, 706.571},
-         std::vector<int>{20,  1,   50,  5,  12,  2, 3,   10,  3,
-                          200, 25,  6,   30, 30,  4, 20,  100, 10,
-                          5,   500, 100, 8,  100, 3, 200, 30}},
-        {"Hydrogen",
-         std::vector<float>{
-             397.007, 410.174, 434.047, 486.133, 656.272, 656.285},
-         std::vector<int>{8, 15, 30, 80, 120, 180}},
-        {"Iron",
-         std::vector<float>{
-             400.524, 400.971, 401.453, 402.187, 404.064, 404.581, 406.359,
-             406.698, 406.798, 407.174, 407.663, 410.074, 410.749, 411.854,
-             412.76,  413.206, 413.468, 413.7,   414.342, 414.387, 415.39,
-             415.45,  415.68,  417.274, 417.491, 417.564, 417.759, 418.175,
-             418.489, 418.704, 418.78,  419.143, 419.532, 419.83,  419.91,
-             420.203, 420.398, 420.67,  421.034, 421.618, 421.936, 422.221,
-             422.596, 422.742, 423.36,  423.594, 423.88,  424.743, 425.012,
-             425.079, 425.832, 426.047, 427.115, 427.176, 428.24,  429.146,
-             429.923, 430.79,  431.508, 432.576, 435.273, 436.977, 437.593,
-             438.354, 440.475, 441.512, 442.73,  446.165, 446.655, 447.602,
-             448.217, 448.225, 448.974, 452.861, 464.743, 473.677, 485.974,
-             487.132, 487.214, 487.821, 489.075, 489.149, 490.331, 491.899,
-             492.05,  495.76,  500.186, 500.191, 500.571, 500.612, 501.207,
-             501.494, 503.077, 504.176, 504.982, 505.163, 507.475, 510.073,
-             511.036, 513.369, 513.925, 513.946, 515.191, 516.227, 516.628,
-             516.749, 516.889, 517.16,  519.145, 519.234, 519.494, 520.458,
-             521.518, 521.627, 521.685, 522.686, 522.715, 523.294, 526.026,
-             526.656, 526.954, 527.036, 528.179, 528.362, 530.23,  532.418,
-             532.804, 532.853, 533.29,  533.993, 534.102, 536.487, 536.747,
-             536.996, 537.149, 538.337, 539.317, 539.713, 540.412, 540.577,
-             541.091, 541.52,  542.407, 542.783, 542.97,  543.452, 544.687,
-             545.545, 545.561, 546.593, 546.694, 548.231, 549.752, 550.146,
-             550.62,  550.678, 556.962, 557.284, 558.676, 561.564, 562.454,
-             566.252, 576.299, 586.235, 591.411, 598.696, 596.171, 596.24,
-             606.548, 610.216, 613.661, 613.769, 614.773, 614.924, 619.156,
-             621.343, 621.928, 623.073, 623.837, 624.632, 624.756, 625.255,
-             639.36,  640.0,   641.165, 641.69,  642.135, 643.084, 644.643,
-             645.638, 649.498, 651.605, 654.624, 659.291, 667.799},
-         std::vector<int>{
-             400, 60,  80,   100, 50,   4000, 1500, 50,  50,   1200, 40,
-             40,  40,  150,  40,  400,  80,   40,   200, 800,  40,   50,
-             60,  50,  60,   50,  50,   120,  50,   120, 120,  80,   40,
-             150, 40,  300,  40,  80,   80,   400,  100, 50,   50,   200,
-             100, 250, 50,   50,  200,  300,  40,   800, 250,  1200, 1200,
-             80,  250, 1200, 150, 1500, 80,   80,   800, 3000, 1200, 300,
-             600, 400, 120,  80,  80,   200,  50,   50,  30,   30,   50,
-             120, 60,  30,   100, 250,  30,   150,  500, 1500, 80,   18,
-             30,  100, 60,   30,  25,   150,  30,   30,  25,   18,   150,
-             40,  40,  100,  25,  30,   80,   2500, 80,  500,  50,   80,
-             200, 30,  25,   150, 18,   60,   1000, 250, 18,   100,  1200,
-             800, 30,  60,   25,  150,  800,  300,  100, 80,   500,  25,
-             40,  50,  400,  60,  40,   300,  60,   250, 30,   60,   60,
-             30,  250, 100,  200, 25,   120,  16,   20,  16,   25,   20,
-             18,  30,  30,   60,  120,  200,  20,   50,  20,   30,   30,
-             30,  18,  30,   40,  30,   40,   40,   30,  20,   40,   30,
-             30,  40,  20,   20,  80,   30,   20,   30,  20,   20,   20,
-             30,  20,  200,  60,  20,   20,   20,   40}},
-        {"Krypton",
-         std::vector<float>{
-             390.618, 392.008, 399.484, 399.779, 405.704, 406.513, 408.834,
-             409.873, 410.925, 414.512, 425.058, 427.397, 428.297, 429.292,
-             430.049, 431.781, 431.855, 431.958, 432.298, 435.136, 435.548,
-             436.264, 436.969, 437.612, 438.654, 439.997, 442.519, 443.169,
-             443.681, 445.392, 446.369, 447.501, 448.988, 450.235, 452.314,
-             455.661, 457.721, 458.298, 459.28,  461.529, 461.917, 463.389,
-             465.888, 468.04,  469.13,  469.436, 473.9,   476.244, 476.574,
-             481.176, 482.518, 483.208, 484.661, 485.72,  494.559, 502.24,
-             508.652, 512.573, 520.832, 530.866, 533.341, 546.817, 556.222,
-             557.029, 558.039, 564.956, 568.189, 569.035, 583.286, 587.091,
-             599.222, 599.385, 605.613, 642.018, 642.103, 645.629, 657.007,
-             669.923, 690.468},
-         std::vector<int>{150,  200,  100,  100,  300,  300, 500,  250, 100,
-                          250,  150,  1000, 100,  600,  200, 500,  400, 1000,
-                          150,  100,  3000, 500,  200,  800, 300,  200, 100,
-                          500,  600,  600,  800,  800,  400, 600,  400, 200,
-                          800,  300,  150,  500,  1000, 800, 2000, 500, 100,
-                          200,  3000, 300,  1000, 300,  300, 800,  700, 150,
-                          300,  200,  250,  400,  500,  200, 500,  200, 500,
-                          2000, 80,   100,  400,  200,  100, 3000, 200, 60,
-                          60,   300,  100,  200,  150,  60,  100}},
-        {"Magnesium",
-         std::vector<float>{
-             390.386, 393.84,  398.421, 398.675, 405.469, 405.75,  407.506,
-             408.183, 416.51,  416.727, 435.191, 435.453, 438.038, 438.464,
-             439.059, 442.8,   443.399, 443.649, 443.66,  448.116, 448.133,
-             453.429, 457.11,  462.13,  470.299, 473.003, 473.959, 473.971,
-             485.11,  516.733, 517.268, 518.361, 526.421, 526.437, 534.598,
-             540.154, 550.96,  552.841, 571.109, 578.531, 578.556, 591.643,
-             591.816, 631.872, 631.924, 631.949, 634.674, 634.696, 654.597,
-             662.044, 662.057, 663.083, 678.145, 678.785, 681.286, 681.927,
-             689.49,  696.54,  706.041},
-         std::vector<int>{4,  6,  1,  8, 2, 10, 3,  2,   4,  15, 20, 6,
-                          6,  9,  10, 8, 9, 5,  4,  14,  12, 6,  28, 3,
-                          7,  10, 6,  5, 7, 75, 22, 400, 8,  7,  1,  9,
-                          2,  6,  30, 5, 4, 7,  6,  10,  9,  7,  10, 9,
-                          11, 5,  6,  2, 7, 8,  7,  8,   4,  6,  8}},
-        {"Mercury",
-         std::vector<float>{
-             404.656, 407.783, 410.805, 433.922, 434.749, 435.833, 439.862,
-             466.028, 485.572, 488.3,   488.991, 491.607, 497.037, 498.064,
-             510.27,  512.064, 512.845, 513.794, 529.074, 531.678, 535.405,
-             538.463, 546.074, 554.963, 567.586, 576.96,  578.966, 579.066,
-             580.378, 585.925, 587.173, 587.198, 607.272, 614.95,  623.44,
-             652.113, 671.643, 690.752, 708.19,  709.186},
-         std::vector<int>{1800, 150, 40,  125,  240,  2000, 100, 90, 80, 5,  5,
-                          80,   5,   5,   20,   40,   100,  20,  20, 5,  60, 30,
-                          1100, 30,  160, 1240, 1100, 280,  140, 60, 60, 20, 20,
-                          1000, 30,  80,  160,  250,  250,  200}},
-        {"Neon",
-         std::vector<float>{
-             421.974, 423.385, 425.065, 436.986, 437.94,  437.955, 438.506,
-             439.199, 439.799, 440.93,  441.322, 442.139, 442.852, 442.863,
-             443.09,  443.094, 445.705, 452.272, 453.775, 454.038, 456.906,
-             470.44,  470.886, 471.007, 471.207, 471.535, 475.273, 478.893,
-             479.022, 482.734, 488.492, 500.516, 503.775, 514.494, 533.078,
-             534.109, 534.328, 540.056, 556.277, 565.666, 571.923, 574.83,
-             576.442, 580.445, 582.016, 585.249, 587.283, 588.19,  590.246,
-             590.643, 594.483, 596.547, 597.463, 597.553, 598.791, 603.0,
-             607.434, 609.616, 612.845, 614.306, 616.359, 618.215, 621.728,
-             626.65,  630.479, 633.443, 638.299, 640.225, 650.653, 653.288,
-             659.895, 665.209, 667.828, 671.704, 692.947, 702.405, 703.241,
-             705.129, 705.911},
-         std::vector<int>{150, 100, 120, 120, 70,  150, 100, 200, 150, 150,
-                          100, 100, 100, 100, 150, 150, 120, 100, 10,  10,
-                          100, 15,  12,  10,  10,  15,  10,  12,  10,  10,
-                          10,  4,   10,  10,  25,  20,  8,   60,  5,   10,
-                          5,   12,  80,  12,  40,  500, 100, 100, 60,  60,
-                          100, 100, 100, 120, 80,  100, 100, 80,  60,  100,
-                          120, 250, 150, 150, 60,  100, 120, 200, 150, 60,
-                          150, 70,  90,  20,  100, 90,  100, 50,  80}},
-        {"Nitrogen",
-         std::vector<float>{
-             391.9,   395.585, 399.5,   403.508, 404.131, 404.353, 409.994,
-             410.995, 417.616, 422.774, 423.691, 423.705, 424.178, 443.274,
-             444.703, 453.041, 460.148, 460.716, 461.387, 462.139, 463.054,
-             464.308, 478.813, 480.329, 484.738, 489.511, 491.494, 493.512,
-             495.023, 496.398, 498.737, 499.436, 500.148, 500.27,  500.515,
-             500.732, 501.062, 501.639, 502.566, 504.51,  528.12,  529.268,
-             549.567, 553.536, 566.663, 567.602, 567.956, 568.621, 571.077,
-             574.73,  575.25,  576.475, 582.954, 585.404, 592.781, 593.178,
-             594.024, 594.165, 595.239, 599.943, 600.847, 616.776, 637.962,
-             641.165, 642.064, 642.302, 642.832, 643.768, 644.094, 645.79,
-             646.844, 648.205, 648.27,  648.375, 648.171, 648.48,  649.122,
-             649.954, 650.631, 661.056, 662.254, 663.694, 664.496, 664.65,
-             665.346, 665.651, 672.262},
-         std::vector<int>{
-             360, 450, 1000, 360, 550, 360, 140, 185, 285, 285, 285, 220, 450,
-             285, 650, 360,  550, 450, 360, 450, 870, 550, 285, 450, 180, 285,
-             160, 210, 160,  350, 285, 450, 650, 360, 870, 550, 450, 360, 360,
-             550, 185, 140,  450, 285, 650, 550, 870, 450, 450, 285, 700, 240,
-             265, 235, 360,  550, 285, 650, 285, 160, 210, 285, 360, 185, 210,
-             210, 210, 185,  235, 185, 300, 750, 360, 300, 265, 325, 160, 210,
-             185, 750, 185,  185, 235, 185, 235, 210, 185}},
-        {"Oxygen",
-         std::vector<float>{
-             391.196, 391.929, 394.729, 394.748, 394.759, 395.437, 395.461,
-             397.326, 398.22,  406.99,  407.216, 407.587, 408.391, 408.714,
-             408.927, 409.724, 410.5,   411.922, 413.281, 414.606, 415.33,
-             418.546, 418.979, 423.327, 425.374, 425.398, 427.547, 430.378,
-             431.714, 433.686, 434.556, 434.943, 436.69,  436.825, 439.595,
-             441.491, 441.698, 444.821, 445.238, 446.545, 446.628, 446.783,
-             446.941, 459.097, 459.617, 460.939, 463.885, 464.181, 464.914,
-             465.084, 466.164, 467.623, 469.921, 470.536, 492.46,  494.306,
-             532.91,  532.968, 533.074, 543.518, 543.578, 543.686, 557.734,
-             595.839, 595.858, 599.528, 604.623, 604.644, 604.649, 610.627,
-             615.598, 615.677, 615.818, 625.683, 626.155, 636.634, 637.432,
-             645.36,  645.444, 645.598, 660.491, 665.383, 700.192, 700.223,
-             715.67},
-         std::vector<int>{450, 160, 185, 160, 140, 220, 100, 450, 220, 160, 285,
-                          450, 80,  50,  150, 110, 220, 285, 160, 50,  220, 285,
-                          450, 80,  50,  50,  50,  50,  285, 160, 220, 285, 220,
-                          100, 220, 450, 285, 160, 160, 50,  50,  50,  50,  360,
-                          285, 80,  160, 360, 450, 160, 360, 285, 220, 285, 160,
-                          220, 135, 160, 190, 90,  110, 135, 120, 160, 190, 80,
-                          160, 190, 110, 100, 400, 450, 490, 80,  100, 100, 100,
-                          320, 360, 400, 80,  100, 360, 450, 210}},
-        {"Potassium",
-         std::vector<float>{
-             360.888, 361.849, 362.642, 368.154, 371.66,  372.134, 373.913,
-             374.442, 376.736, 378.319, 380.014, 381.656, 381.75,  387.374,
-             387.862, 389.792, 392.3,   392.636, 394.253, 395.521, 396.672,
-             397.258, 399.51,  400.124, 401.21,  404.259, 409.369, 411.499,
-             413.472, 414.919, 418.624, 422.297, 422.567, 426.34,  430.5,
-             430.91,  434.003, 438.816, 446.665, 450.533, 459.565, 460.845,
-             465.938, 482.923, 494.329, 500.56,  505.627, 531.024, 547.013,
-             564.273, 577.232, 596.964, 612.027, 624.659, 630.729, 642.796,
-             659.5},
-         std::vector<int>{5, 6, 4, 6, 5, 5, 5, 5, 6, 6, 6, 6, 7, 5, 4,
-                          8, 5, 5, 6, 6, 6, 6, 6, 7, 5, 6, 5, 6, 7, 7,
-                          8, 7, 7, 7, 7, 7, 5, 7, 5, 6, 5, 8, 5, 9, 6,
-                          8, 7, 5, 6, 5, 4, 2, 8, 6, 7, 5, 2}},
-        {"Silicon",
-         std::vector<float>{
-             390.552, 395.574, 397.746, 399.177, 399.801, 407.545, 407.678,
-             410.294, 412.807, 413.089, 418.335, 419.072, 419.813, 462.142,
-             462.172, 478.299, 479.221, 479.232, 488.32,  490.699, 493.28,
-             494.761, 500.606, 504.103, 505.598, 518.19,  518.525, 519.286,
-             520.241, 529.519, 540.534, 541.724, 542.892, 543.289, 543.862,
-             544.726, 545.449, 545.645, 546.643, 546.687, 546.921, 549.323,
-             549.645, 551.754, 554.074, 557.666, 562.222, 563.297, 563.948,
-             564.561, 566.066, 566.555, 566.956, 568.144, 568.448, 568.881,
-             569.043, 570.111, 570.137, 570.637, 570.84,  574.767, 575.363,
-             575.422, 576.298, 577.215, 578.038, 578.573, 579.307, 579.49,
-             579.786, 580.047, 580.674, 582.78,  584.613, 586.748, 586.84,
-             587.376, 591.522, 594.855, 595.756, 597.893, 606.745, 608.006,
-             608.667, 612.502, 613.157, 613.185, 614.249, 614.502, 615.513,
-             623.732, 623.829, 624.381, 624.447, 625.419, 633.195, 634.71,
-             637.136, 652.661, 652.72,  655.546, 666.052, 666.5,   667.188,
-             669.938, 671.704, 672.185, 674.164, 675.028, 681.845, 682.982,
-             684.857, 697.652, 700.357, 700.588, 701.728, 701.765, 703.49,
-             716.469, 716.555, 718.489, 719.358, 719.39},
-         std::vector<int>{
-             300,  10,   10,   15,  10,   20,  15,  70,  300, 500, 10,  100,
-             50,   100,  150,  50,  35,   80,  15,  20,  20,  30,  40,  1000,
-             1000, 100,  100,  200, 500,  30,  100, 15,  15,  15,  100, 20,
-             15,   100,  500,  500, 100,  40,  200, 35,  100, 150, 30,  100,
-             200,  90,   150,  80,  1000, 30,  120, 300, 100, 90,  200, 100,
-             160,  45,   45,   45,  45,   70,  70,  30,  90,  30,  100, 150,
-             200,  30,   50,   10,  300,  40,  150, 200, 500, 500, 10,  20,
-             10,   90,   85,   90,  100,  100, 160, 160, 40,  125, 125, 180,
-             45,   1000, 1000, 45,  45,   45,  50,  15,  100, 20,  50,  100,
-             30,   20,   30,   50,  30,   80,  180, 180, 30,  90,  250, 70,
-             200,  70,   65,   30}},
-        {"Sodium",
-         std::vector<float>{
-             371.107, 411.37,  412.308, 423.326, 423.899, 424.09,  424.208,
-             424.208, 424.941, 425.252, 427.364, 427.679, 427.679, 428.784,
-             429.101, 429.248, 429.286, 430.881, 430.904, 432.091, 432.14,
-             432.462, 432.462, 433.729, 434.149, 434.411, 434.474, 436.86,
-             437.522, 438.749, 439.003, 439.281, 439.334, 439.334, 440.512,
-             441.988, 442.325, 444.67,  444.741, 445.474, 445.523, 445.721,
-             447.463, 447.88,  448.167, 449.015, 449.087, 449.418, 449.766,
-             449.766, 449.962, 450.697, 451.921, 452.498, 453.332, 454.163,
-             454.519, 455.153, 459.092, 466.481, 466.856, 466.856, 472.223,
-             473.11,  474.167, 474.794, 475.182, 476.879, 478.879, 497.854,
-             498.281, 514.884, 515.34,  519.165, 520.855, 540.046, 541.455,
-             568.263, 568.819, 568.821, 588.995, 589.592, 615.423, 616.075,
-             617.525, 619.926, 623.468, 626.001, 627.474, 636.115, 636.641,
-             651.421, 652.468, 653.07,  654.404, 654.575, 655.243, 737.323,
-             737.349},
-         std::vector<int>{850,   300,   250, 250, 6,   250, 10,  10,  1,   2,
-                          15,    20,    20,  2,   3,   250, 250, 250, 250, 250,
-                          30,    40,    40,  250, 3,   250, 5,   200, 200, 200,
-                          40,    250,   60,  60,  200, 5,   8,   200, 200, 200,
-                          200,   200,   200, 200, 200, 200, 200, 60,  100, 100,
-                          200,   200,   200, 200, 200, 10,  15,  200, 160, 120,
-                          200,   200,   160, 160, 160, 20,  30,  160, 100, 200,
-                          400,   40,    80,  100, 80,  70,  90,  280, 70,  560,
-                          80000, 40000, 120, 240, 60,  70,  70,  80,  80,  70,
-                          70,    90,    80,  130, 130, 130, 80,  20,  10}},
-        {"Strontium",
-         std::vector<float>{
-             403.038, 403.238, 407.771, 409.403, 409.702, 410.563, 416.18,
-             421.552, 429.857, 430.545, 433.58,  443.804, 460.733, 468.508,
-             472.228, 474.192, 478.432, 481.188, 483.208, 485.504, 486.87,
-             487.249, 487.606, 487.632, 489.198, 496.226, 496.794, 507.109,
-             513.034, 515.607, 515.826, 522.22,  522.511, 522.927, 523.855,
-             525.69,  525.771, 526.221, 528.832, 532.982, 539.103, 544.348,
-             545.084, 546.39,  548.084, 548.612, 550.417, 552.183, 553.481,
-             554.005, 554.336, 566.466, 568.972, 597.01,  634.575, 636.394,
-             636.996, 638.075, 638.65,  638.824, 640.847, 644.668, 646.579,
-             650.4,   654.679, 655.026, 661.726, 664.354, 679.105, 687.838,
-             689.259},
-         std::vector<int>{1300, 300,  46000, 30,   30,    30,   200,  32000,
-                          9,    340,  35,    350,  65000, 9,    3200, 2200,
-                          1400, 4800, 3600,  500,  600,   3000, 600,  2000,
-                          1000, 8000, 1300,  30,   30,    800,  35,   1400,
-                          2000, 2000, 2800,  4800, 40,    30,   30,   350,
-                          30,   40,   1500,  30,   7000,  1100, 3500, 2600,
-                          2000, 2000, 250,   30,   30,    200,  250,  250,
-                          350,  1000, 900,   600,  9000,  250,  250,  5500,
-                          1000, 1700, 3000,  800,  1800,  4800, 1200}},
-        {"Sulfur",
-         std::vector<float>{390.2,  393.33, 412.08, 414.23, 414.51, 415.31,
-                            416.27, 469.41, 469.54, 469.62, 471.62, 481.55,
-                            492.41, 492.53, 499.35, 542.86, 543.28, 545.38,
-                            547.36, 550.97, 556.49, 560.61, 564.0,  564.03,
-                            564.7,  565.99, 566.47, 570.61, 581.92, 605.27,
-                            628.64, 628.71, 630.55, 631.27, 638.49, 639.73,
-                            639.8,  641.37, 674.36, 674.88, 675.72, 757.9},
-         std::vector<int>{285,  360,  450, 280,  360, 450, 450, 450, 285,
-                          160,  280,  450, 360,  450, 285, 360, 650, 1000,
-                          1000, 1000, 280, 1000, 450, 450, 280, 650, 450,
-                          160,  450,  450, 280,  450, 450, 450, 280, 280,
-                          280,  360,  160, 285,  450, 450}},
-        {"Xenon",
-         std::vector<float>{
-             390.791, 403.759, 405.746, 409.889, 415.804, 418.01,  419.315,
-             420.848, 420.947, 421.372, 421.56,  422.3,   423.825, 424.538,
-             425.157, 429.64,  431.051, 433.052, 436.92,  437.378, 439.32,
-             439.577, 440.688, 441.607, 444.813, 446.219, 448.086, 452.186,
-             473.415, 479.262, 480.702, 482.971, 484.329, 491.651, 492.315,
-             497.171, 497.271, 498.877, 499.117, 502.828, 504.492, 508.062,
-             512.242, 512.57,  517.882, 518.804, 519.137, 519.21,  526.044,
-             526.195, 529.222, 530.927, 531.387, 533.933, 536.32,  536.807,
-             537.239, 539.28,  541.915, 543.896, 544.545, 545.045, 546.039,
-             547.261, 549.486, 552.553, 553.107, 556.662, 561.667, 565.938,
-             566.756, 567.091, 569.575, 569.961, 571.61,  572.691, 575.103,
-             575.865, 577.639, 581.596, 582.389, 582.48,  587.502, 589.329,
-             589.499, 590.513, 593.417, 594.553, 597.113, 597.646, 600.892,
-             603.62,  605.115, 609.35,  609.759, 610.143, 611.508, 614.645,
-             617.83,  617.966, 618.242, 619.407, 619.826, 622.002, 627.082,
-             627.754, 628.441, 628.601, 630.086, 631.806, 634.396, 635.635,
-             637.528, 639.799, 646.97,  647.284, 648.776, 649.872, 650.418,
-             651.283, 652.865, 653.316, 659.501, 659.556, 659.725, 659.884,
-             666.892, 669.432, 672.801, 678.871, 679.037, 680.574, 682.732,
-             687.211, 688.216, 691.022, 692.553, 694.211, 697.618, 699.088,
-             708.215},
-         std::vector<int>{
-             100, 100,  200, 100,  200,  1000, 500,  300,  100,  300,  100,
-             300, 400,  500, 100,  500,  500,  1000, 200,  100,  500,  500,
-             200, 150,  500, 1000, 500,  100,  600,  150,  500,  400,  300,
-             500, 500,  200, 400,  300,  100,  200,  200,  1000, 300,  100,
-             100, 300,  400, 100,  500,  500,  2000, 300,  1000, 2000, 200,
-             200, 500,  100, 3000, 800,  300,  200,  400,  1000, 100,  200,
-             600, 100,  300, 300,  600,  150,  100,  200,  200,  500,  500,
-             300, 300,  100, 300,  150,  100,  300,  100,  200,  100,  500,
-             300, 2000, 200, 1000, 2000, 600,  1500, 400,  100,  100,  150,
-             120, 300,  500, 100,  100,  500,  400,  100,  100,  250,  500,
-             400, 600,  200, 100,  300,  150,  120,  100,  200,  300,  200,
-             100, 1000, 100, 400,  100,  150,  300,  200,  150,  100,  1000,
-             200, 100,  300, 80,   100,  800,  100,  2000, 150}}};
+constexpr float bariumWavelengths[] = {
+    405.371, 408.096, 408.487, 408.725, 408.734, 413.065, 413.243, 416.6,
+    417.935, 422.396, 423.956, 424.26,  426.442, 426.792, 428.31,  429.116,
+    430.518, 430.927, 430.927, 432.3,   432.511, 433.291, 435.033, 435.953,
+    440.254, 440.683, 441.366, 443.189, 446.709, 448.898, 449.364, 450.435,
+    450.592, 452.317, 452.493, 455.403, 457.385, 457.964, 458.976, 459.182,
+    459.972, 460.498, 461.992, 462.833, 467.362, 469.161, 469.744, 469.91,
+    470.042, 472.471, 472.643, 487.765, 489.993, 490.285, 493.408, 494.731,
+    495.709, 499.564, 501.295, 501.295, 504.955, 505.496, 509.754, 510.225,
+    513.454, 515.988, 525.38,  530.57,  542.455, 543.732, 551.904, 553.548,
+    553.587, 559.331, 568.0,   568.018, 577.762, 578.404, 580.023, 580.568,
+    581.881, 582.627, 585.368, 590.764, 597.17,  597.846, 599.709, 599.8,
+    601.947, 606.311, 608.339, 610.199, 611.078, 612.923, 614.171, 634.168,
+    637.711, 638.376, 641.111, 645.085, 648.291, 649.69,  649.876, 652.617,
+    652.731, 659.533, 665.411, 667.527, 669.384, 676.948, 677.186, 686.569,
+    686.791, 687.408, 687.408, 696.148};
+constexpr int bariumStrengths[] = {
+    18,  13,   43,   8,   9,    910, 309, 103,  14,  34,  25,   17,  42,   8,
+    530, 26,   6,    4,   4,    61,  18,  39,   271, 9,   273,  29,  13,   374,
+    30,  234,  137,  5,   209,  327, 188, 9300, 230, 580, 22,   28,  108,  28,
+    40,  63,   133,  306, 15,   24,  80,  8,    371, 66,  273,  63,  6900, 25,
+    10,  5,    5,    5,   10,   19,  10,  12,   10,  80,  5,    6,   199,  5,
+    280, 1830, 112,  5,   21,   41,  740, 5,    203, 419, 14,   610, 331,  94,
+    700, 8,    620,  10,  610,  840, 5,   13,   880, 5,   1510, 900, 10,   10,
+    3,   580,  1770, 900, 1060, 8,   890, 740,  9,   462, 454,  6,   4,    62,
+    8,   7,    7,    1};
+
+constexpr float calciumWavelengths[] = {
+    362.411, 363.075, 363.097, 364.441, 364.477, 364.499, 367.529, 367.821,
+    368.37,  369.411, 369.436, 370.603, 373.69,  373.938, 374.835, 375.029,
+    375.334, 375.567, 375.839, 387.048, 387.254, 387.256, 387.578, 387.58,
+    388.91,  392.348, 393.366, 393.529, 394.604, 394.89,  395.705, 396.847,
+    397.257, 397.371, 408.177, 409.71,  409.853, 409.857, 410.982, 411.028,
+    415.357, 416.431, 418.42,  420.618, 420.724, 422.007, 422.673, 423.374,
+    424.046, 424.074, 428.301, 428.439, 428.936, 429.899, 430.253, 430.281,
+    430.774, 431.865, 432.919, 433.357, 435.508, 435.838, 439.959, 440.629,
+    442.544, 443.13,  443.496, 443.569, 445.478, 445.589, 445.661, 447.204,
+    447.923, 448.918, 449.988, 451.659, 452.694, 457.212, 457.855, 458.14,
+    458.147, 458.587, 458.596, 468.527, 470.883, 471.627, 471.674, 472.103,
+    479.997, 485.917, 487.813, 500.148, 500.895, 501.997, 502.114, 504.162,
+    505.007, 518.885, 523.182, 524.737, 526.171, 526.224, 526.424, 526.556,
+    527.027, 527.198, 528.527, 530.132, 530.722, 532.129, 532.806, 533.919,
+    534.947, 551.298, 557.058, 557.906, 558.197, 558.876, 559.012, 559.447,
+    559.849, 560.129, 560.285, 585.745, 592.272, 592.369, 606.998, 610.272,
+    612.222, 616.129, 616.217, 616.376, 616.644, 616.906, 616.956, 617.322,
+    621.398, 629.489, 637.011, 638.755, 642.451, 643.907, 644.981, 645.56,
+    645.687, 646.257, 647.166, 648.535, 649.378, 649.965, 653.878, 654.224,
+    657.278, 671.769, 714.815, 720.219, 730.869, 732.615};
+constexpr int calciumStrengths[] = {
+    15, 17, 14, 20, 14, 8,  5,  6,  30,  40, 10, 170, 180, 10,  6,  8,  9,  20,
+    30, 9,  11, 11, 12, 12, 6,  6,  230, 9,  6,  15,  17,  220, 8,  18, 15, 50,
+    15, 15, 60, 30, 15, 15, 15, 40, 18,  50, 50, 17,  15,  16,  24, 15, 22, 22,
+    25, 20, 23, 22, 15, 16, 20, 15, 19,  17, 25, 17,  26,  25,  30, 28, 20, 20,
+    10, 20, 19, 18, 23, 18, 22, 23, 23,  24, 24, 20,  11,  11,  30, 40, 40, 10,
+    25, 70, 10, 80, 40, 23, 10, 25, 10,  11, 22, 23,  22,  24,  25, 13, 60, 10,
+    70, 11, 10, 50, 27, 23, 11, 10, 25,  27, 24, 26,  25,  24,  24, 30, 10, 10,
+    13, 27, 29, 22, 30, 22, 24, 26, 28,  10, 12, 11,  11,  10,  12, 35, 30, 22,
+    80, 34, 29, 12, 32, 28, 10, 10, 23,  30, 33, 31,  10,  33};
+
+constexpr float carbonWavelengths[] = {
+    391.898, 392.069, 407.452, 407.585, 426.7,   426.726, 477.175, 493.205,
+    505.217, 513.294, 513.328, 514.349, 514.516, 515.109, 538.034, 564.807,
+    566.247, 588.977, 589.159, 600.113, 600.603, 600.718, 601.068, 601.322,
+    601.484, 657.805, 658.288, 658.761, 678.39,  711.318, 711.519, 711.563,
+    711.699, 711.99};
+constexpr int carbonStrengths[] = {
+    570, 800, 250, 350, 800, 1000, 200, 200, 200, 350, 350, 350, 570, 400, 300,
+    250, 350, 570, 350, 200, 250,  110, 150, 300, 250, 800, 570, 200, 250, 250,
+    250, 250, 200, 350};
+
+constexpr float heliumWavelengths[] = {
+    396.473, 400.927, 402.619, 402.636, 412.082, 412.099, 414.376, 438.793,
+    443.755, 447.148, 447.168, 468.54,  468.57,  471.315, 471.338, 492.193,
+    501.568, 504.774, 541.152, 587.562, 587.597, 656.01,  667.815, 686.748,
+    706.519, 706.571};
+constexpr int heliumStrengths[] = {
+    20,  1,   50, 5,   12, 2,   3, 10, 3, 200, 25, 6, 30, 30, 4, 20, 100, 10, 5,
+    500, 100, 8,  100, 3,  200, 30};
+
+constexpr float hydrogenWavelengths[] = {
+    397.007, 410.174, 434.047, 486.133, 656.272, 656.285};
+constexpr int hydrogenStrengths[] = {
+    8, 15, 30, 80, 120, 180};
+
+constexpr float ironWavelengths[] = {
+    400.524, 400.971, 401.453, 402.187, 404.064, 404.581, 406.359, 406.698,
+    406.798, 407.174, 407.663, 410.074, 410.749, 411.854, 412.76,  413.206,
+    413.468, 413.7,   414.342, 414.387, 415.39,  415.45,  415.68,  417.274,
+    417.491, 417.564, 417.759, 418.175, 418.489, 418.704, 418.78,  419.143,
+    419.532, 419.83,  419.91,  420.203, 420.398, 420.67,  421.034, 421.618,
+    421.936, 422.221, 422.596, 422.742, 423.36,  423.594, 423.88,  424.743,
+    425.012, 425.079, 425.832, 426.047, 427.115, 427.176, 428.24,  429.146,
+    429.923, 430.79,  431.508, 432.576, 435.273, 436.977, 437.593, 438.354,
+    440.475, 441.512, 442.73,  446.165, 446.655, 447.602, 448.217, 448.225,
+    448.974, 452.861, 464.743, 473.677, 485.974, 487.132, 487.214, 487.821,
+    489.075, 489.149, 490.331, 491.899, 492.05,  495.76,  500.186, 500.191,
+    500.571, 500.612, 501.207, 501.494, 503.077, 504.176, 504.982, 505.163,
+    507.475, 510.073, 511.036, 513.369, 513.925, 513.946, 515.191, 516.227,
+    516.628, 516.749, 516.889, 517.16,  519.145, 519.234, 519.494, 520.458,
+    521.518, 521.627, 521.685, 522.686, 522.715, 523.294, 526.026, 526.656,
+    526.954, 527.036, 528.179, 528.362, 530.23,  532.418, 532.804, 532.853,
+    533.29,  533.993, 534.102, 536.487, 536.747, 536.996, 537.149, 538.337,
+    539.317, 539.713, 540.412, 540.577, 541.091, 541.52,  542.407, 542.783,
+    542.97,  543.452, 544.687, 545.545, 545.561, 546.593, 546.694, 548.231,
+    549.752, 550.146, 550.62,  550.678, 556.962, 557.284, 558.676, 561.564,
+    562.454, 566.252, 576.299, 586.235, 591.411, 598.696, 596.171, 596.24,
+    606.548, 610.216, 613.661, 613.769, 614.773, 614.924, 619.156, 621.343,
+    621.928, 623.073, 623.837, 624.632, 624.756, 625.255, 639.36,  640.0,
+    641.165, 641.69,  642.135, 643.084, 644.643, 645.638, 649.498, 651.605,
+    654.624, 659.291, 667.799};
+constexpr int ironStrengths[] = {
+    400, 60,   80,   100,  50,  4000, 1500, 50,   50,  1200, 40,  40,   40,
+    150, 40,   400,  80,   40,  200,  800,  40,   50,  60,   50,  60,   50,
+    50,  120,  50,   120,  120, 80,   40,   150,  40,  300,  40,  80,   80,
+    400, 100,  50,   50,   200, 100,  250,  50,   50,  200,  300, 40,   800,
+    250, 1200, 1200, 80,   250, 1200, 150,  1500, 80,  80,   800, 3000, 1200,
+    300, 600,  400,  120,  80,  80,   200,  50,   50,  30,   30,  50,   120,
+    60,  30,   100,  250,  30,  150,  500,  1500, 80,  18,   30,  100,  60,
+    30,  25,   150,  30,   30,  25,   18,   150,  40,  40,   100, 25,   30,
+    80,  2500, 80,   500,  50,  80,   200,  30,   25,  150,  18,  60,   1000,
+    250, 18,   100,  1200, 800, 30,   60,   25,   150, 800,  300, 100,  80,
+    500, 25,   40,   50,   400, 60,   40,   300,  60,  250,  30,  60,   60,
+    30,  250,  100,  200,  25,  120,  16,   20,   16,  25,   20,  18,   30,
+    30,  60,   120,  200,  20,  50,   20,   30,   30,  30,   18,  30,   40,
+    30,  40,   40,   30,   20,  40,   30,   30,   40,  20,   20,  80,   30,
+    20,  30,   20,   20,   20,  30,   20,   200,  60,  20,   20,  20,   40};
+
+constexpr float kryptonWavelengths[] = {
+    390.618, 392.008, 399.484, 399.779, 405.704, 406.513, 408.834, 409.873,
+    410.925, 414.512, 425.058, 427.397, 428.297, 429.292, 430.049, 431.781,
+    431.855, 431.958, 432.298, 435.136, 435.548, 436.264, 436.969, 437.612,
+    438.654, 439.997, 442.519, 443.169, 443.681, 445.392, 446.369, 447.501,
+    448.988, 450.235, 452.314, 455.661, 457.721, 458.298, 459.28,  461.529,
+    461.917, 463.389, 465.888, 468.04,  469.13,  469.436, 473.9,   476.244,
+    476.574, 481.176, 482.518, 483.208, 484.661, 485.72,  494.559, 502.24,
+    508.652, 512.573, 520.832, 530.866, 533.341, 546.817, 556.222, 557.029,
+    558.039, 564.956, 568.189, 569.035, 583.286, 587.091, 599.222, 599.385,
+    605.613, 642.018, 642.103, 645.629, 657.007, 669.923, 690.468};
+constexpr int kryptonStrengths[] = {
+    150, 200,  100, 100,  300,  300, 500, 250,  100, 250,  150, 1000, 100,
+    600, 200,  500, 400,  1000, 150, 100, 3000, 500, 200,  800, 300,  200,
+    100, 500,  600, 600,  800,  800, 400, 600,  400, 200,  800, 300,  150,
+    500, 1000, 800, 2000, 500,  100, 200, 3000, 300, 1000, 300, 300,  800,
+    700, 150,  300, 200,  250,  400, 500, 200,  500, 200,  500, 2000, 80,
+    100, 400,  200, 100,  3000, 200, 60,  60,   300, 100,  200, 150,  60,
+    100};
+
+constexpr float magnesiumWavelengths[] = {
+    390.386, 393.84,  398.421, 398.675, 405.469, 405.75,  407.506, 408.183,
+    416.51,  416.727, 435.191, 435.453, 438.038, 438.464, 439.059, 442.8,
+    443.399, 443.649, 443.66,  448.116, 448.133, 453.429, 457.11,  462.13,
+    470.299, 473.003, 473.959, 473.971, 485.11,  516.733, 517.268, 518.361,
+    526.421, 526.437, 534.598, 540.154, 550.96,  552.841, 571.109, 578.531,
+    578.556, 591.643, 591.816, 631.872, 631.924, 631.949, 634.674, 634.696,
+    654.597, 662.044, 662.057, 663.083, 678.145, 678.785, 681.286, 681.927,
+    689.49,  696.54,  706.041};
+constexpr int magnesiumStrengths[] = {
+    4, 6,  1, 8, 2,  10, 3,  2, 4,  15, 20,  6, 6, 9, 10, 8, 9, 5,  4, 14, 12,
+    6, 28, 3, 7, 10, 6,  5,  7, 75, 22, 400, 8, 7, 1, 9,  2, 6, 30, 5, 4,  7,
+    6, 10, 9, 7, 10, 9,  11, 5, 6,  2,  7,   8, 7, 8, 4,  6, 8};
+
+constexpr float mercuryWavelengths[] = {
+    404.656, 407.783, 410.805, 433.922, 434.749, 435.833, 439.862, 466.028,
+    485.572, 488.3,   488.991, 491.607, 497.037, 498.064, 510.27,  512.064,
+    512.845, 513.794, 529.074, 531.678, 535.405, 538.463, 546.074, 554.963,
+    567.586, 576.96,  578.966, 579.066, 580.378, 585.925, 587.173, 587.198,
+    607.272, 614.95,  623.44,  652.113, 671.643, 690.752, 708.19,  709.186};
+constexpr int mercuryStrengths[] = {
+    1800, 150, 40,  125, 240, 2000, 100, 90, 80,   5,   5,   80,   5,    5,
+    20,   40,  100, 20,  20,  5,    60,  30, 1100, 30,  160, 1240, 1100, 280,
+    140,  60,  60,  20,  20,  1000, 30,  80, 160,  250, 250, 200};
+
+constexpr float neonWavelengths[] = {
+    421.974, 423.385, 425.065, 436.986, 437.94,  437.955, 438.506, 439.199,
+    439.799, 440.93,  441.322, 442.139, 442.852, 442.863, 443.09,  443.094,
+    445.705, 452.272, 453.775, 454.038, 456.906, 470.44,  470.886, 471.007,
+    471.207, 471.535, 475.273, 478.893, 479.022, 482.734, 488.492, 500.516,
+    503.775, 514.494, 533.078, 534.109, 534.328, 540.056, 556.277, 565.666,
+    571.923, 574.83,  576.442, 580.445, 582.016, 585.249, 587.283, 588.19,
+    590.246, 590.643, 594.483, 596.547, 597.463, 597.553, 598.791, 603.0,
+    607.434, 609.616, 612.845, 614.306, 616.359, 618.215, 621.728, 626.65,
+    630.479, 633.443, 638.299, 640.225, 650.653, 653.288, 659.895, 665.209,
+    667.828, 671.704, 692.947, 702.405, 703.241, 705.129, 705.911};
+constexpr int neonStrengths[] = {
+    150, 100, 120, 120, 70, 150, 100, 200, 150, 150, 100, 100, 100, 100, 150,
+    150, 120, 100, 10,  10, 100, 15,  12,  10,  10,  15,  10,  12,  10,  10,
+    10,  4,   10,  10,  25, 20,  8,   60,  5,   10,  5,   12,  80,  12,  40,
+    500, 100, 100, 60,  60, 100, 100, 100, 120, 80,  100, 100, 80,  60,  100,
+    120, 250, 150, 150, 60, 100, 120, 200, 150, 60,  150, 70,  90,  20,  100,
+    90,  100, 50,  80};
+
+constexpr float nitrogenWavelengths[] = {
+    391.9,   395.585, 399.5,   403.508, 404.131, 404.353, 409.994, 410.995,
+    417.616, 422.774, 423.691, 423.705, 424.178, 443.274, 444.703, 453.041,
+    460.148, 460.716, 461.387, 462.139, 463.054, 464.308, 478.813, 480.329,
+    484.738, 489.511, 491.494, 493.512, 495.023, 496.398, 498.737, 499.436,
+    500.148, 500.27,  500.515, 500.732, 501.062, 501.639, 502.566, 504.51,
+    528.12,  529.268, 549.567, 553.536, 566.663, 567.602, 567.956, 568.621,
+    571.077, 574.73,  575.25,  576.475, 582.954, 585.404, 592.781, 593.178,
+    594.024, 594.165, 595.239, 599.943, 600.847, 616.776, 637.962, 641.165,
+    642.064, 642.302, 642.832, 643.768, 644.094, 645.79,  646.844, 648.205,
+    648.27,  648.375, 648.171, 648.48,  649.122, 649.954, 650.631, 661.056,
+    662.254, 663.694, 664.496, 664.65,  665.346, 665.651, 672.262};
+constexpr int nitrogenStrengths[] = {
+    360, 450, 1000, 360, 550, 360, 140, 185, 285, 285, 285, 220, 450, 285, 650,
+    360, 550, 450,  360, 450, 870, 550, 285, 450, 180, 285, 160, 210, 160, 350,
+    285, 450, 650,  360, 870, 550, 450, 360, 360, 550, 185, 140, 450, 285, 650,
+    550, 870, 450,  450, 285, 700, 240, 265, 235, 360, 550, 285, 650, 285, 160,
+    210, 285, 360,  185, 210, 210, 210, 185, 235, 185, 300, 750, 360, 300, 265,
+    325, 160, 210,  185, 750, 185, 185, 235, 185, 235, 210, 185};
+
+constexpr float oxygenWavelengths[] = {
+    391.196, 391.929, 394.729, 394.748, 394.759, 395.437, 395.461, 397.326,
+    398.22,  406.99,  407.216, 407.587, 408.391, 408.714, 408.927, 409.724,
+    410.5,   411.922, 413.281, 414.606, 415.33,  418.546, 418.979, 423.327,
+    425.374, 425.398, 427.547, 430.378, 431.714, 433.686, 434.556, 434.943,
+    436.69,  436.825, 439.595, 441.491, 441.698, 444.821, 445.238, 446.545,
+    446.628, 446.783, 446.941, 459.097, 459.617, 460.939, 463.885, 464.181,
+    464.914, 465.084, 466.164, 467.623, 469.921, 470.536, 492.46,  494.306,
+    532.91,  532.968, 533.074, 543.518, 543.578, 543.686, 557.734, 595.839,
+    595.858, 599.528, 604.623, 604.644, 604.649, 610.627, 615.598, 615.677,
+    615.818, 625.683, 626.155, 636.634, 637.432, 645.36,  645.444, 645.598,
+    660.491, 665.383, 700.192, 700.223, 715.67};
+constexpr int oxygenStrengths[] = {
+    450, 160, 185, 160, 140, 220, 100, 450, 220, 160, 285, 450, 80,  50,  150,
+    110, 220, 285, 160, 50,  220, 285, 450, 80,  50,  50,  50,  50,  285, 160,
+    220, 285, 220, 100, 220, 450, 285, 160, 160, 50,  50,  50,  50,  360, 285,
+    80,  160, 360, 450, 160, 360, 285, 220, 285, 160, 220, 135, 160, 190, 90,
+    110, 135, 120, 160, 190, 80,  160, 190, 110, 100, 400, 450, 490, 80,  100,
+    100, 100, 320, 360, 400, 80,  100, 360, 450, 210};
 
-    wavelength_to_rgb = {
-        +0.00045, -0.00048, +0.00344, 0.0, +0.00054, -0.00057, +0.00411, 0.0,
-        +0.00064, -0.00068, +0.00491, 0.0, +0.00076, -0.00081, +0.00587, 0.0,
-        +0.00091, -0.00097, +0.00702, 0.0, +0.00109, -0.00116, +0.00840, 0.0,
-        +0.00129, -0.00138, +0.01001, 0.0, +0.00153, -0.00164, +0.01190, 0.0,
-        +0.00182, -0.00194, +0.01414, 0.0, +0.00218, -0.00234, +0.01703, 0.0,
-        +0.00264, -0.00284, +0.02071, 0.0, +0.00322, -0.00348, +0.02534, 0.0,
-        +0.00386, -0.00417, +0.03038, 0.0, +0.00450, -0.00486, +0.03546, 0.0,
-        +0.00516, -0.00558, +0.04072, 0.0, +0.00598, -0.00647, +0.04724, 0.0,
-        +0.00710, -0.00769, +0.05613, 0.0, +0.00863, -0.00936, +0.06836, 0.0,
-        +0.01053, -0.01144, +0.08357, 0.0, +0.01274, -0.01385, +0.10125, 0.0,
-        +0.01519, -0.01653, +0.12093, 0.0, +0.01803, -0.01965, +0.14389, 0.0,
-        +0.02168, -0.02365, +0.17330, 0.0, +0.02643, -0.02888, +0.21162, 0.0,
-        +0.03245, -0.03552, +0.26028, 0.0, +0.03908, -0.04284, +0.31394, 0.0,
-        +0.04569, -0.05016, +0.36771, 0.0, +0.05227, -0.05746, +0.42149, 0.0,
-        +0.06027, -0.06638, +0.48734, 0.0, +0.07081, -0.07815, +0.57443, 0.0,
-        +0.08552, -0.09461, +0.69639, 0.0, +0.10362, -0.11491, +0.84703, 0.0,
-        +0.12528, -0.13927, +1.02788, 0.0, +0.14983, -0.16697, +1.23378, 0.0,
-        +0.17827, -0.19920, +1.47406, 0.0, +0.21158, -0.23708, +1.75729, 0.0,
-        +0.25101, -0.28203, +2.09453, 0.0, +0.29624, -0.33380, +2.48475, 0.0,
-        +0.34779, -0.39321, +2.93667, 0.0, +0.40658, -0.46162, +3.46319, 0.0,
-        +0.47220, -0.53867, +4.06305, 0.0, +0.54051, -0.61973, +4.70338, 0.0,
-        +0.60635, -0.69886, +5.33983, 0.0, +0.66537, -0.77121, +5.93862, 0.0,
-        +0.71768, -0.83688, +6.49979, 0.0, +0.76113, -0.89376, +7.01109, 0.0,
-        +0.79616, -0.94228, +7.47436, 0.0, +0.82035, -0.97986, +7.87338, 0.0,
-        +0.83614, -1.00873, +8.22049, 0.0, +0.84242, -1.02744, +8.50645, 0.0,
-        +0.84078, -1.03762, +8.74118, 0.0, +0.83034, -1.03859, +8.92043, 0.0,
-        +0.81254, -1.03214, +9.05476, 0.0, +0.78703, -1.01809, +9.14316, 0.0,
-        +0.75484, -0.99759, +9.19545, 0.0, +0.71615, -0.97105, +9.21808, 0.0,
-        +0.67160, -0.93921, +9.21831, 0.0, +0.62161, -0.90259, +9.20002, 0.0,
-        +0.56689, -0.86205, +9.17044, 0.0, +0.50834, -0.81861, +9.13661, 0.0,
-        +0.44594, -0.77208, +9.09795, 0.0, +0.37943, -0.72170, +9.04709, 0.0,
-        +0.30755, -0.66573, +8.97282, 0.0, +0.23092, -0.60438, +8.87416, 0.0,
-        +0.14981, -0.53723, +8.74625, 0.0, +0.06594, -0.46565, +8.59299, 0.0,
-        -0.02033, -0.38919, +8.40964, 0.0, -0.10876, -0.30770, +8.19449, 0.0,
-        -0.20050, -0.21796, +7.92484, 0.0, -0.29554, -0.11954, +7.59637, 0.0,
-        -0.39331, -0.01241, +7.21152, 0.0, -0.49150, +0.09945, +6.80323, 0.0,
-        -0.58821, +0.21359, +6.39517, 0.0, -0.68287, +0.32900, +5.99509, 0.0,
-        -0.77548, +0.44604, +5.60104, 0.0, -0.86610, +0.56489, +5.21161, 0.0,
-        -0.95460, +0.68545, +4.82936, 0.0, -1.04075, +0.80685, +4.45829, 0.0,
-        -1.12455, +0.92810, +4.09979, 0.0, -1.20591, +1.04853, +3.75664, 0.0,
-        -1.28534, +1.16898, +3.42953, 0.0, -1.36289, +1.29080, +3.12382, 0.0,
-        -1.43893, +1.41475, +2.83930, 0.0, -1.51418, +1.54219, +2.57957, 0.0,
-        -1.59057, +1.67393, +2.33844, 0.0, -1.67070, +1.81285, +2.11752, 0.0,
-        -1.75483, +1.95874, +1.91220, 0.0, -1.84334, +2.11293, +1.72443, 0.0,
-        -1.93521, +2.27405, +1.55044, 0.0, -2.03042, +2.44286, +1.39069, 0.0,
-        -2.13002, +2.62100, +1.24237, 0.0, -2.23687, +2.81319, +1.10525, 0.0,
-        -2.35236, +3.02163, +0.97760, 0.0, -2.47428, +3.24476, +0.85780, 0.0,
-        -2.59703, +3.47704, +0.74210, 0.0, -2.71594, +3.71384, +0.62737, 0.0,
-        -2.82897, +3.95378, +0.51297, 0.0, -2.93632, +4.19762, +0.39993, 0.0,
-        -3.03724, +4.44667, +0.28956, 0.0, -3.13108, +4.69930, +0.18189, 0.0,
-        -3.21371, +4.95123, +0.07878, 0.0, -3.28397, +5.19852, -0.01863, 0.0,
-        -3.33736, +5.43706, -0.10798, 0.0, -3.37511, +5.66511, -0.19039, 0.0,
-        -3.39057, +5.87377, -0.26368, 0.0, -3.38528, +6.06146, -0.32886, 0.0,
-        -3.35591, +6.22465, -0.38509, 0.0, -3.30812, +6.37058, -0.43551, 0.0,
-        -3.24179, +6.50082, -0.48132, 0.0, -3.15961, +6.61749, -0.52364, 0.0,
-        -3.06176, +6.71875, -0.56240, 0.0, -2.95103, +6.80507, -0.59813, 0.0,
-        -2.82820, +6.87607, -0.63112, 0.0, -2.69357, +6.93282, -0.66147, 0.0,
-        -2.54728, +6.97631, -0.68910, 0.0, -2.38914, +7.00683, -0.71390, 0.0,
-        -2.22005, +7.02525, -0.73614, 0.0, -2.03886, +7.03046, -0.75560, 0.0,
-        -1.84668, +7.02377, -0.77259, 0.0, -1.64223, +7.00396, -0.78687, 0.0,
-        -1.42756, +6.97316, -0.79889, 0.0, -1.20113, +6.92961, -0.80833, 0.0,
-        -0.96551, +6.87626, -0.81577, 0.0, -0.71778, +6.81012, -0.82080, 0.0,
-        -0.46110, +6.73561, -0.82419, 0.0, -0.19336, +6.65064, -0.82569, 0.0,
-        +0.08365, +6.55671, -0.82561, 0.0, +0.37088, +6.45270, -0.82381, 0.0,
-        +0.66727, +6.33938, -0.82051, 0.0, +0.97318, +6.21586, -0.81561, 0.0,
-        +1.28739, +6.08248, -0.80924, 0.0, +1.60955, +5.93863, -0.80137, 0.0,
-        +1.93880, +5.78480, -0.79209, 0.0, +2.27437, +5.62195, -0.78153, 0.0,
-        +2.61591, +5.45037, -0.76973, 0.0, +2.96233, +5.27108, -0.75682, 0.0,
-        +3.31285, +5.08373, -0.74275, 0.0, +3.66602, +4.88945, -0.72766, 0.0,
-        +4.02090, +4.68771, -0.71146, 0.0, +4.37621, +4.48023, -0.69439, 0.0,
-        +4.73064, +4.26687, -0.67639, 0.0, +5.08331, +4.04937, -0.65773, 0.0,
-        +5.43209, +3.82766, -0.63835, 0.0, +5.77578, +3.60300, -0.61845, 0.0,
-        +6.11136, +3.37554, -0.59802, 0.0, +6.43833, +3.14646, -0.57722, 0.0,
-        +6.75425, +2.91678, -0.55610, 0.0, +7.05863, +2.68778, -0.53481, 0.0,
-        +7.34897, +2.46063, -0.51343, 0.0, +7.62475, +2.23621, -0.49201, 0.0,
-        +7.88502, +2.01551, -0.47056, 0.0, +8.12917, +1.79937, -0.44912, 0.0,
-        +8.35493, +1.58891, -0.42780, 0.0, +8.55610, +1.38639, -0.40686, 0.0,
-        +8.72994, +1.19299, -0.38646, 0.0, +8.87308, +1.01015, -0.36670, 0.0,
-        +8.99180, +0.83597, -0.34746, 0.0, +9.08621, +0.67076, -0.32872, 0.0,
-        +9.16062, +0.51316, -0.31041, 0.0, +9.20686, +0.36631, -0.29275, 0.0,
-        +9.22610, +0.22973, -0.27574, 0.0, +9.21024, +0.10654, -0.25962, 0.0,
-        +9.16717, -0.00588, -0.24419, 0.0, +9.09596, -0.10655, -0.22948, 0.0,
-        +9.00259, -0.19742, -0.21535, 0.0, +8.88469, -0.27749, -0.20186, 0.0,
-        +8.74432, -0.34784, -0.18898, 0.0, +8.58049, -0.40808, -0.17677, 0.0,
-        +8.39510, -0.45899, -0.16519, 0.0, +8.18703, -0.50078, -0.15418, 0.0,
-        +7.95487, -0.53377, -0.14371, 0.0, +7.70010, -0.55866, -0.13371, 0.0,
-        +7.42649, -0.57586, -0.12424, 0.0, +7.14029, -0.58670, -0.11524, 0.0,
-        +6.84421, -0.59128, -0.10677, 0.0, +6.54303, -0.59108, -0.09875, 0.0,
-        +6.24334, -0.58674, -0.09130, 0.0, +5.95045, -0.57990, -0.08435, 0.0,
-        +5.66682, -0.57050, -0.07797, 0.0, +5.38831, -0.55895, -0.07199, 0.0,
-        +5.11322, -0.54477, -0.06645, 0.0, +4.84120, -0.52865, -0.06124, 0.0,
-        +4.57352, -0.51058, -0.05640, 0.0, +4.30991, -0.49103, -0.05187, 0.0,
-        +4.05110, -0.47010, -0.04764, 0.0, +3.79769, -0.44817, -0.04369, 0.0,
-        +3.55123, -0.42545, -0.04004, 0.0, +3.31243, -0.40220, -0.03666, 0.0,
-        +3.08214, -0.37871, -0.03354, 0.0, +2.86197, -0.35542, -0.03067, 0.0,
-        +2.65285, -0.33270, -0.02800, 0.0, +2.45568, -0.31075, -0.02556, 0.0,
-        +2.26865, -0.28947, -0.02330, 0.0, +2.09183, -0.26889, -0.02122, 0.0,
-        +1.92374, -0.24898, -0.01930, 0.0, +1.76572, -0.22991, -0.01753, 0.0,
-        +1.61595, -0.21155, -0.01589, 0.0, +1.47600, -0.19411, -0.01440, 0.0,
-        +1.34405, -0.17747, -0.01302, 0.0, +1.22181, -0.16189, -0.01176, 0.0,
-        +1.10773, -0.14727, -0.01060, 0.0, +1.00305, -0.13378, -0.00954, 0.0,
-        +0.90716, -0.12137, -0.00858, 0.0, +0.82139, -0.11020, -0.00773, 0.0,
-        +0.74466, -0.10017, -0.00697, 0.0, +0.67637, -0.09120, -0.00631, 0.0,
-        +0.61518, -0.08315, -0.00571, 0.0, +0.56049, -0.07594, -0.00518, 0.0,
-        +0.51097, -0.06939, -0.00470, 0.0, +0.46462, -0.06325, -0.00425, 0.0,
-        +0.42008, -0.05731, -0.00383, 0.0, +0.37742, -0.05161, -0.00343, 0.0,
-        +0.33796, -0.04630, -0.00305, 0.0, +0.30196, -0.04144, -0.00272, 0.0,
-        +0.26980, -0.03708, -0.00242, 0.0, +0.24065, -0.03310, -0.00216, 0.0,
-        +0.21505, -0.02960, -0.00193, 0.0, +0.19221, -0.02648, -0.00172, 0.0,
-        +0.17238, -0.02376, -0.00154, 0.0, +0.15483, -0.02136, -0.00138, 0.0,
-        +0.13963, -0.01927, -0.00124, 0.0, +0.12619, -0.01742, -0.00112, 0.0,
-        +0.11421, -0.01577, -0.00102, 0.0, +0.10320, -0.01425, -0.00092, 0.0,
-        +0.09311, -0.01286, -0.00083, 0.0, +0.08395, -0.01159, -0.00075, 0.0,
-        +0.07572, -0.01046, -0.00067, 0.0, +0.06834, -0.00944, -0.00061, 0.0,
-        +0.06165, -0.00851, -0.00055, 0.0, +0.05561, -0.00768, -0.00049, 0.0,
-        +0.05009, -0.00692, -0.00045, 0.0, +0.04513, -0.00623, -0.00040, 0.0,
-        +0.04059, -0.00560, -0.00036, 0.0, +0.03653, -0.00504, -0.00033, 0.0,
-        +0.03281, -0.00453, -0.00029, 0.0, +0.02951, -0.00407, -0.00026, 0.0,
-        +0.02652, -0.00366, -0.00024, 0.0, +0.02386, -0.00330, -0.00021, 0.0,
-        +0.02146, -0.00296, -0.00019, 0.0, +0.01930, -0.00267, -0.00017, 0.0,
-        +0.01734, -0.00239, -0.00015, 0.0, +0.01557, -0.00215, -0.00014, 0.0,
-        +0.01396, -0.00193, -0.00012, 0.0, +0.01250, -0.00173, -0.00011, 0.0,
-        +0.01118, -0.00154, -0.00010, 0.0, +0.01000, -0.00138, -0.00009, 0.0,
-        +0.00893, -0.00123, -0.00008, 0.0, +0.00797, -0.00110, -0.00007, 0.0,
-        +0.00712, -0.00098, -0.00006, 0.0, +0.00635, -0.00088, -0.00006, 0.0,
-        +0.00567, -0.00078, -0.00005, 0.0, +0.00506, -0.00070, -0.00005, 0.0,
-        +0.00453, -0.00062, -0.00004, 0.0, +0.00405, -0.00056, -0.00004, 0.0,
-        +0.00363, -0.00050, -0.00003, 0.0, +0.00326, -0.00045, -0.00003, 0.0};
+constexpr float potassiumWavelengths[] = {
+    360.888, 361.849, 362.642, 368.154, 371.66,  372.134, 373.913, 374.442,
+    376.736, 378.319, 380.014, 381.656, 381.75,  387.374, 387.862, 389.792,
+    392.3,   392.636, 394.253, 395.521, 396.672, 397.258, 399.51,  400.124,
+    401.21,  404.259, 409.369, 411.499, 413.472, 414.919, 418.624, 422.297,
+    422.567, 426.34,  430.5,   430.91,  434.003, 438.816, 446.665, 450.533,
+    459.565, 460.845, 465.938, 482.923, 494.329, 500.56,  505.627, 531.024,
+    547.013, 564.273, 577.232, 596.964, 612.027, 624.659, 630.729, 642.796,
+    659.5};
+constexpr int potassiumStrengths[] = {
+    5, 6, 4, 6, 5, 5, 5, 5, 6, 6, 6, 6, 7, 5, 4, 8, 5, 5, 6, 6, 6, 6, 6, 7, 5,
+    6, 5, 6, 7, 7, 8, 7, 7, 7, 7, 7, 5, 7, 5, 6, 5, 8, 5, 9, 6, 8, 7, 5, 6, 5,
+    4, 2, 8, 6, 7, 5, 2};
 
-    for (auto& [name, wavelengths, strengths] : lines)
+constexpr float siliconWavelengths[] = {
+    390.552, 395.574, 397.746, 399.177, 399.801, 407.545, 407.678, 410.294,
+    412.807, 413.089, 418.335, 419.072, 419.813, 462.142, 462.172, 478.299,
+    479.221, 479.232, 488.32,  490.699, 493.28,  494.761, 500.606, 504.103,
+    505.598, 518.19,  518.525, 519.286, 520.241, 529.519, 540.534, 541.724,
+    542.892, 543.289, 543.862, 544.726, 545.449, 545.645, 546.643, 546.687,
+    546.921, 549.323, 549.645, 551.754, 554.074, 557.666, 562.222, 563.297,
+    563.948, 564.561, 566.066, 566.555, 566.956, 568.144, 568.448, 568.881,
+    569.043, 570.111, 570.137, 570.637, 570.84,  574.767, 575.363, 575.422,
+    576.298, 577.215, 578.038, 578.573, 579.307, 579.49,  579.786, 580.047,
+    580.674, 582.78,  584.613, 586.748, 586.84,  587.376, 591.522, 594.855,
+    595.756, 597.893, 606.745, 608.006, 608.667, 612.502, 613.157, 613.185,
+    614.249, 614.502, 615.513, 623.732, 623.829, 624.381, 624.447, 625.419,
+    633.195, 634.71,  637.136, 652.661, 652.72,  655.546, 666.052, 666.5,
+    667.188, 669.938, 671.704, 672.185, 674.164, 675.028, 681.845, 682.982,
+    684.857, 697.652, 700.357, 700.588, 701.728, 701.765, 703.49,  716.469,
+    716.555, 718.489, 719.358, 719.39};
+constexpr int siliconStrengths[] = {
+    300,  10,  10,  15,  10,  20,  15,  70,  300, 500,  10,   100, 50,  100,
+    150,  50,  35,  80,  15,  20,  20,  30,  40,  1000, 1000, 100, 100, 200,
+    500,  30,  100, 15,  15,  15,  100, 20,  15,  100,  500,  500, 100, 40,
+    200,  35,  100, 150, 30,  100, 200, 90,  150, 80,   1000, 30,  120, 300,
+    100,  90,  200, 100, 160, 45,  45,  45,  45,  70,   70,   30,  90,  30,
+    100,  150, 200, 30,  50,  10,  300, 40,  150, 200,  500,  500, 10,  20,
+    10,   90,  85,  90,  100, 100, 160, 160, 40,  125,  125,  180, 45,  1000,
+    1000, 45,  45,  45,  50,  15,  100, 20,  50,  100,  30,   20,  30,  50,
+    30,   80,  180, 180, 30,  90,  250, 70,  200, 70,   65,   30};
+
+constexpr float sodiumWavelengths[] = {
+    371.107, 411.37,  412.308, 423.326, 423.899, 424.09,  424.208, 424.208,
+    424.941, 425.252, 427.364, 427.679, 427.679, 428.784, 429.101, 429.248,
+    429.286, 430.881, 430.904, 432.091, 432.14,  432.462, 432.462, 433.729,
+    434.149, 434.411, 434.474, 436.86,  437.522, 438.749, 439.003, 439.281,
+    439.334, 439.334, 440.512, 441.988, 442.325, 444.67,  444.741, 445.474,
+    445.523, 445.721, 447.463, 447.88,  448.167, 449.015, 449.087, 449.418,
+    449.766, 449.766, 449.962, 450.697, 451.921, 452.498, 453.332, 454.163,
+    454.519, 455.153, 459.092, 466.481, 466.856, 466.856, 472.223, 473.11,
+    474.167, 474.794, 475.182, 476.879, 478.879, 497.854, 498.281, 514.884,
+    515.34,  519.165, 520.855, 540.046, 541.455, 568.263, 568.819, 568.821,
+    588.995, 589.592, 615.423, 616.075, 617.525, 619.926, 623.468, 626.001,
+    627.474, 636.115, 636.641, 651.421, 652.468, 653.07,  654.404, 654.575,
+    655.243, 737.323, 737.349};
+constexpr int sodiumStrengths[] = {
+    850, 300, 250, 250, 6,   250, 10,  10,  1,   2,   15,    20,    20,  2,
+    3,   250, 250, 250, 250, 250, 30,  40,  40,  250, 3,     250,   5,   200,
+    200, 200, 40,  250, 60,  60,  200, 5,   8,   200, 200,   200,   200, 200,
+    200, 200, 200, 200, 200, 60,  100, 100, 200, 200, 200,   200,   200, 10,
+    15,  200, 160, 120, 200, 200, 160, 160, 160, 20,  30,    160,   100, 200,
+    400, 40,  80,  100, 80,  70,  90,  280, 70,  560, 80000, 40000, 120, 240,
+    60,  70,  70,  80,  80,  70,  70,  90,  80,  130, 130,   130,   80,  20,
+    10};
+
+constexpr float strontiumWavelengths[] = {
+    403.038, 403.238, 407.771, 409.403, 409.702, 410.563, 416.18,  421.552,
+    429.857, 430.545, 433.58,  443.804, 460.733, 468.508, 472.228, 474.192,
+    478.432, 481.188, 483.208, 485.504, 486.87,  487.249, 487.606, 487.632,
+    489.198, 496.226, 496.794, 507.109, 513.034, 515.607, 515.826, 522.22,
+    522.511, 522.927, 523.855, 525.69,  525.771, 526.221, 528.832, 532.982,
+    539.103, 544.348, 545.084, 546.39,  548.084, 548.612, 550.417, 552.183,
+    553.481, 554.005, 554.336, 566.466, 568.972, 597.01,  634.575, 636.394,
+    636.996, 638.075, 638.65,  638.824, 640.847, 644.668, 646.579, 650.4,
+    654.679, 655.026, 661.726, 664.354, 679.105, 687.838, 689.259};
+constexpr int strontiumStrengths[] = {
+    1300,  300,  46000, 30,   30,   30,   200,  32000, 9,    340,  35,   350,
+    65000, 9,    3200,  2200, 1400, 4800, 3600, 500,   600,  3000, 600,  2000,
+    1000,  8000, 1300,  30,   30,   800,  35,   1400,  2000, 2000, 2800, 4800,
+    40,    30,   30,    350,  30,   40,   1500, 30,    7000, 1100, 3500, 2600,
+    2000,  2000, 250,   30,   30,   200,  250,  250,   350,  1000, 900,  600,
+    9000,  250,  250,   5500, 1000, 1700, 3000, 800,   1800, 4800, 1200};
+
+constexpr float sulfurWavelengths[] = {
+    390.2,  393.33, 412.08, 414.23, 414.51, 415.31, 416.27, 469.41, 469.54,
+    469.62, 471.62, 481.55, 492.41, 492.53, 499.35, 542.86, 543.28, 545.38,
+    547.36, 550.97, 556.49, 560.61, 564.0,  564.03, 564.7,  565.99, 566.47,
+    570.61, 581.92, 605.27, 628.64, 628.71, 630.55, 631.27, 638.49, 639.73,
+    639.8,  641.37, 674.36, 674.88, 675.72, 757.9};
+constexpr int sulfurStrengths[] = {
+    285, 360, 450, 280,  360,  450,  450, 450,  285, 160, 280, 450, 360, 450,
+    285, 360, 650, 1000, 1000, 1000, 280, 1000, 450, 450, 280, 650, 450, 160,
+    450, 450, 280, 450,  450,  450,  280, 280,  280, 360, 160, 285, 450, 450};
+
+constexpr float xenonWavelengths[] = {
+    390.791, 403.759, 405.746, 409.889, 415.804, 418.01,  419.315, 420.848,
+    420.947, 421.372, 421.56,  422.3,   423.825, 424.538, 425.157, 429.64,
+    431.051, 433.052, 436.92,  437.378, 439.32,  439.577, 440.688, 441.607,
+    444.813, 446.219, 448.086, 452.186, 473.415, 479.262, 480.702, 482.971,
+    484.329, 491.651, 492.315, 497.171, 497.271, 498.877, 499.117, 502.828,
+    504.492, 508.062, 512.242, 512.57,  517.882, 518.804, 519.137, 519.21,
+    526.044, 526.195, 529.222, 530.927, 531.387, 533.933, 536.32,  536.807,
+    537.239, 539.28,  541.915, 543.896, 544.545, 545.045, 546.039, 547.261,
+    549.486, 552.553, 553.107, 556.662, 561.667, 565.938, 566.756, 567.091,
+    569.575, 569.961, 571.61,  572.691, 575.103, 575.865, 577.639, 581.596,
+    582.389, 582.48,  587.502, 589.329, 589.499, 590.513, 593.417, 594.553,
+    597.113, 597.646, 600.892, 603.62,  605.115, 609.35,  609.759, 610.143,
+    611.508, 614.645, 617.83,  617.966, 618.242, 619.407, 619.826, 622.002,
+    627.082, 627.754, 628.441, 628.601, 630.086, 631.806, 634.396, 635.635,
+    637.528, 639.799, 646.97,  647.284, 648.776, 649.872, 650.418, 651.283,
+    652.865, 653.316, 659.501, 659.556, 659.725, 659.884, 666.892, 669.432,
+    672.801, 678.871, 679.037, 680.574, 682.732, 687.211, 688.216, 691.022,
+    692.553, 694.211, 697.618, 699.088, 708.215};
+constexpr int xenonStrengths[] = {
+    100,  100,  200,  100,  200,  1000, 500,  300, 100, 300,  100, 300,  400,
+    500,  100,  500,  500,  1000, 200,  100,  500, 500, 200,  150, 500,  1000,
+    500,  100,  600,  150,  500,  400,  300,  500, 500, 200,  400, 300,  100,
+    200,  200,  1000, 300,  100,  100,  300,  400, 100, 500,  500, 2000, 300,
+    1000, 2000, 200,  200,  500,  100,  3000, 800, 300, 200,  400, 1000, 100,
+    200,  600,  100,  300,  300,  600,  150,  100, 200, 200,  500, 500,  300,
+    300,  100,  300,  150,  100,  300,  100,  200, 100, 500,  300, 2000, 200,
+    1000, 2000, 600,  1500, 400,  100,  100,  150, 120, 300,  500, 100,  100,
+    500,  400,  100,  100,  250,  500,  400,  600, 200, 100,  300, 150,  120,
+    100,  200,  300,  200,  100,  1000, 100,  400, 100, 150,  300, 200,  150,
+    100,  1000, 200,  100,  300,  80,   100,  800, 100, 2000, 150};
+
+constexpr GasDischargeLines gasLines[] = {
+    {"Aluminum", aluminumWavelengths, aluminumStrengths},
+    {"Argon", argonWavelengths, argonStrengths},
+    {"Barium", bariumWavelengths, bariumStrengths},
+    {"Calcium", calciumWavelengths, calciumStrengths},
+    {"Carbon", carbonWavelengths, carbonStrengths},
+    {"Helium", heliumWavelengths, heliumStrengths},
+    {"Hydrogen", hydrogenWavelengths, hydrogenStrengths},
+    {"Iron", ironWavelengths, ironStrengths},
+    {"Krypton", kryptonWavelengths, kryptonStrengths},
+    {"Magnesium", magnesiumWavelengths, magnesiumStrengths},
+    {"Mercury", mercuryWavelengths, mercuryStrengths},
+    {"Neon", neonWavelengths, neonStrengths},
+    {"Nitrogen", nitrogenWavelengths, nitrogenStrengths},
+    {"Oxygen", oxygenWavelengths, oxygenStrengths},
+    {"Potassium", potassiumWavelengths, potassiumStrengths},
+    {"Silicon", siliconWavelengths, siliconStrengths},
+    {"Sodium", sodiumWavelengths, sodiumStrengths},
+    {"Strontium", strontiumWavelengths, strontiumStrengths},
+    {"Sulfur", sulfurWavelengths, sulfurStrengths},
+    {"Xenon", xenonWavelengths, xenonStrengths},
+};
+
+constexpr bool linesMatchStrengths()
+{
+    for (const GasDischargeLines& gas : gasLines)
     {
-        cout << name << " : " << wavelengths.size() << ", " << strengths.size()
-             << endl;
+        if (gas.wavelengths.size() != gas.strengths.size()) return false;
     }
+    return true;
+}
+static_assert(linesMatchStrengths(), "a gas has a line without strength");
 
-    cout << "lut : " << wavelength_to_rgb.size() << endl;
+constexpr float wavelengthToRgb[] = {
+    +0.00045, -0.00048, +0.00344, 0.0, +0.00054, -0.00057, +0.00411, 0.0,
+    +0.00064, -0.00068, +0.00491, 0.0, +0.00076, -0.00081, +0.00587, 0.0,
+    +0.00091, -0.00097, +0.00702, 0.0, +0.00109, -0.00116, +0.00840, 0.0,
+    +0.00129, -0.00138, +0.01001, 0.0, +0.00153, -0.00164, +0.01190, 0.0,
+    +0.00182, -0.00194, +0.01414, 0.0, +0.00218, -0.00234, +0.01703, 0.0,
+    +0.00264, -0.00284, +0.02071, 0.0, +0.00322, -0.00348, +0.02534, 0.0,
+    +0.00386, -0.00417, +0.03038, 0.0, +0.00450, -0.00486, +0.03546, 0.0,
+    +0.00516, -0.00558, +0.04072, 0.0, +0.00598, -0.00647, +0.04724, 0.0,
+    +0.00710, -0.00769, +0.05613, 0.0, +0.00863, -0.00936, +0.06836, 0.0,
+    +0.01053, -0.01144, +0.08357, 0.0, +0.01274, -0.01385, +0.10125, 0.0,
+    +0.01519, -0.01653, +0.12093, 0.0, +0.01803, -0.01965, +0.14389, 0.0,
+    +0.02168, -0.02365, +0.17330, 0.0, +0.02643, -0.02888, +0.21162, 0.0,
+    +0.03245, -0.03552, +0.26028, 0.0, +0.03908, -0.04284, +0.31394, 0.0,
+    +0.04569, -0.05016, +0.36771, 0.0, +0.05227, -0.05746, +0.42149, 0.0,
+    +0.06027, -0.06638, +0.48734, 0.0, +0.07081, -0.07815, +0.57443, 0.0,
+    +0.08552, -0.09461, +0.69639, 0.0, +0.10362, -0.11491, +0.84703, 0.0,
+    +0.12528, -0.13927, +1.02788, 0.0, +0.14983, -0.16697, +1.23378, 0.0,
+    +0.17827, -0.19920, +1.47406, 0.0, +0.21158, -0.23708, +1.75729, 0.0,
+    +0.25101, -0.28203, +2.09453, 0.0, +0.29624, -0.33380, +2.48475, 0.0,
+    +0.34779, -0.39321, +2.93667, 0.0, +0.40658, -0.46162, +3.46319, 0.0,
+    +0.47220, -0.53867, +4.06305, 0.0, +0.54051, -0.61973, +4.70338, 0.0,
+    +0.60635, -0.69886, +5.33983, 0.0, +0.66537, -0.77121, +5.93862, 0.0,
+    +0.71768, -0.83688, +6.49979, 0.0, +0.76113, -0.89376, +7.01109, 0.0,
+    +0.79616, -0.94228, +7.47436, 0.0, +0.82035, -0.97986, +7.87338, 0.0,
+    +0.83614, -1.00873, +8.22049, 0.0, +0.84242, -1.02744, +8.50645, 0.0,
+    +0.84078, -1.03762, +8.74118, 0.0, +0.83034, -1.03859, +8.92043, 0.0,
+    +0.81254, -1.03214, +9.05476, 0.0, +0.78703, -1.01809, +9.14316, 0.0,
+    +0.75484, -0.99759, +9.19545, 0.0, +0.71615, -0.97105, +9.21808, 0.0,
+    +0.67160, -0.93921, +9.21831, 0.0, +0.62161, -0.90259, +9.20002, 0.0,
+    +0.56689, -0.86205, +9.17044, 0.0, +0.50834, -0.81861, +9.13661, 0.0,
+    +0.44594, -0.77208, +9.09795, 0.0, +0.37943, -0.72170, +9.04709, 0.0,
+    +0.30755, -0.66573, +8.97282, 0.0, +0.23092, -0.60438, +8.87416, 0.0,
+    +0.14981, -0.53723, +8.74625, 0.0, +0.06594, -0.46565, +8.59299, 0.0,
+    -0.02033, -0.38919, +8.40964, 0.0, -0.10876, -0.30770, +8.19449, 0.0,
+    -0.20050, -0.21796, +7.92484, 0.0, -0.29554, -0.11954, +7.59637, 0.0,
+    -0.39331, -0.01241, +7.21152, 0.0, -0.49150, +0.09945, +6.80323, 0.0,
+    -0.58821, +0.21359, +6.39517, 0.0, -0.68287, +0.32900, +5.99509, 0.0,
+    -0.77548, +0.44604, +5.60104, 0.0, -0.86610, +0.56489, +5.21161, 0.0,
+    -0.95460, +0.68545, +4.82936, 0.0, -1.04075, +0.80685, +4.45829, 0.0,
+    -1.12455, +0.92810, +4.09979, 0.0, -1.20591, +1.04853, +3.75664, 0.0,
+    -1.28534, +1.16898, +3.42953, 0.0, -1.36289, +1.29080, +3.12382, 0.0,
+    -1.43893, +1.41475, +2.83930, 0.0, -1.51418, +1.54219, +2.57957, 0.0,
+    -1.59057, +1.67393, +2.33844, 0.0, -1.67070, +1.81285, +2.11752, 0.0,
+    -1.75483, +1.95874, +1.91220, 0.0, -1.84334, +2.11293, +1.72443, 0.0,
+    -1.93521, +2.27405, +1.55044, 0.0, -2.03042, +2.44286, +1.39069, 0.0,
+    -2.13002, +2.62100, +1.24237, 0.0, -2.23687, +2.81319, +1.10525, 0.0,
+    -2.35236, +3.02163, +0.97760, 0.0, -2.47428, +3.24476, +0.85780, 0.0,
+    -2.59703, +3.47704, +0.74210, 0.0, -2.71594, +3.71384, +0.62737, 0.0,
+    -2.82897, +3.95378, +0.51297, 0.0, -2.93632, +4.19762, +0.39993, 0.0,
+    -3.03724, +4.44667, +0.28956, 0.0, -3.13108, +4.69930, +0.18189, 0.0,
+    -3.21371, +4.95123, +0.07878, 0.0, -3.28397, +5.19852, -0.01863, 0.0,
+    -3.33736, +5.43706, -0.10798, 0.0, -3.37511, +5.66511, -0.19039, 0.0,
+    -3.39057, +5.87377, -0.26368, 0.0, -3.38528, +6.06146, -0.32886, 0.0,
+    -3.35591, +6.22465, -0.38509, 0.0, -3.30812, +6.37058, -0.43551, 0.0,
+    -3.24179, +6.50082, -0.48132, 0.0, -3.15961, +6.61749, -0.52364, 0.0,
+    -3.06176, +6.71875, -0.56240, 0.0, -2.95103, +6.80507, -0.59813, 0.0,
+    -2.82820, +6.87607, -0.63112, 0.0, -2.69357, +6.93282, -0.66147, 0.0,
+    -2.54728, +6.97631, -0.68910, 0.0, -2.38914, +7.00683, -0.71390, 0.0,
+    -2.22005, +7.02525, -0.73614, 0.0, -2.03886, +7.03046, -0.75560, 0.0,
+    -1.84668, +7.02377, -0.77259, 0.0, -1.64223, +7.00396, -0.78687, 0.0,
+    -1.42756, +6.97316, -0.79889, 0.0, -1.20113, +6.92961, -0.80833, 0.0,
+    -0.96551, +6.87626, -0.81577, 0.0, -0.71778, +6.81012, -0.82080, 0.0,
+    -0.46110, +6.73561, -0.82419, 0.0, -0.19336, +6.65064, -0.82569, 0.0,
+    +0.08365, +6.55671, -0.82561, 0.0, +0.37088, +6.45270, -0.82381, 0.0,
+    +0.66727, +6.33938, -0.82051, 0.0, +0.97318, +6.21586, -0.81561, 0.0,
+    +1.28739, +6.08248, -0.80924, 0.0, +1.60955, +5.93863, -0.80137, 0.0,
+    +1.93880, +5.78480, -0.79209, 0.0, +2.27437, +5.62195, -0.78153, 0.0,
+    +2.61591, +5.45037, -0.76973, 0.0, +2.96233, +5.27108, -0.75682, 0.0,
+    +3.31285, +5.08373, -0.74275, 0.0, +3.66602, +4.88945, -0.72766, 0.0,
+    +4.02090, +4.68771, -0.71146, 0.0, +4.37621, +4.48023, -0.69439, 0.0,
+    +4.73064, +4.26687, -0.67639, 0.0, +5.08331, +4.04937, -0.65773, 0.0,
+    +5.43209, +3.82766, -0.63835, 0.0, +5.77578, +3.60300, -0.61845, 0.0,
+    +6.11136, +3.37554, -0.59802, 0.0, +6.43833, +3.14646, -0.57722, 0.0,
+    +6.75425, +2.91678, -0.55610, 0.0, +7.05863, +2.68778, -0.53481, 0.0,
+    +7.34897, +2.46063, -0.51343, 0.0, +7.62475, +2.23621, -0.49201, 0.0,
+    +7.88502, +2.01551, -0.47056, 0.0, +8.12917, +1.79937, -0.44912, 0.0,
+    +8.35493, +1.58891, -0.42780, 0.0, +8.55610, +1.38639, -0.40686, 0.0,
+    +8.72994, +1.19299, -0.38646, 0.0, +8.87308, +1.01015, -0.36670, 0.0,
+    +8.99180, +0.83597, -0.34746, 0.0, +9.08621, +0.67076, -0.32872, 0.0,
+    +9.16062, +0.51316, -0.31041, 0.0, +9.20686, +0.36631, -0.29275, 0.0,
+    +9.22610, +0.22973, -0.27574, 0.0, +9.21024, +0.10654, -0.25962, 0.0,
+    +9.16717, -0.00588, -0.24419, 0.0, +9.09596, -0.10655, -0.22948, 0.0,
+    +9.00259, -0.19742, -0.21535, 0.0, +8.88469, -0.27749, -0.20186, 0.0,
+    +8.74432, -0.34784, -0.18898, 0.0, +8.58049, -0.40808, -0.17677, 0.0,
+    +8.39510, -0.45899, -0.16519, 0.0, +8.18703, -0.50078, -0.15418, 0.0,
+    +7.95487, -0.53377, -0.14371, 0.0, +7.70010, -0.55866, -0.13371, 0.0,
+    +7.42649, -0.57586, -0.12424, 0.0, +7.14029, -0.58670, -0.11524, 0.0,
+    +6.84421, -0.59128, -0.10677, 0.0, +6.54303, -0.59108, -0.09875, 0.0,
+    +6.24334, -0.58674, -0.09130, 0.0, +5.95045, -0.57990, -0.08435, 0.0,
+    +5.66682, -0.57050, -0.07797, 0.0, +5.38831, -0.55895, -0.07199, 0.0,
+    +5.11322, -0.54477, -0.06645, 0.0, +4.84120, -0.52865, -0.06124, 0.0,
+    +4.57352, -0.51058, -0.05640, 0.0, +4.30991, -0.49103, -0.05187, 0.0,
+    +4.05110, -0.47010, -0.04764, 0.0, +3.79769, -0.44817, -0.04369, 0.0,
+    +3.55123, -0.42545, -0.04004, 0.0, +3.31243, -0.40220, -0.03666, 0.0,
+    +3.08214, -0.37871, -0.03354, 0.0, +2.86197, -0.35542, -0.03067, 0.0,
+    +2.65285, -0.33270, -0.02800, 0.0, +2.45568, -0.31075, -0.02556, 0.0,
+    +2.26865, -0.28947, -0.02330, 0.0, +2.09183, -0.26889, -0.02122, 0.0,
+    +1.92374, -0.24898, -0.01930, 0.0, +1.76572, -0.22991, -0.01753, 0.0,
+    +1.61595, -0.21155, -0.01589, 0.0, +1.47600, -0.19411, -0.01440, 0.0,
+    +1.34405, -0.17747, -0.01302, 0.0, +1.22181, -0.16189, -0.01176, 0.0,
+    +1.10773, -0.14727, -0.01060, 0.0, +1.00305, -0.13378, -0.00954, 0.0,
+    +0.90716, -0.12137, -0.00858, 0.0, +0.82139, -0.11020, -0.00773, 0.0,
+    +0.74466, -0.10017, -0.00697, 0.0, +0.67637, -0.09120, -0.00631, 0.0,
+    +0.61518, -0.08315, -0.00571, 0.0, +0.56049, -0.07594, -0.00518, 0.0,
+    +0.51097, -0.06939, -0.00470, 0.0, +0.46462, -0.06325, -0.00425, 0.0,
+    +0.42008, -0.05731, -0.00383, 0.0, +0.37742, -0.05161, -0.00343, 0.0,
+    +0.33796, -0.04630, -0.00305, 0.0, +0.30196, -0.04144, -0.00272, 0.0,
+    +0.26980, -0.03708, -0.00242, 0.0, +0.24065, -0.03310, -0.00216, 0.0,
+    +0.21505, -0.02960, -0.00193, 0.0, +0.19221, -0.02648, -0.00172, 0.0,
+    +0.17238, -0.02376, -0.00154, 0.0, +0.15483, -0.02136, -0.00138, 0.0,
+    +0.13963, -0.01927, -0.00124, 0.0, +0.12619, -0.01742, -0.00112, 0.0,
+    +0.11421, -0.01577, -0.00102, 0.0, +0.10320, -0.01425, -0.00092, 0.0,
+    +0.09311, -0.01286, -0.00083, 0.0, +0.08395, -0.01159, -0.00075, 0.0,
+    +0.07572, -0.01046, -0.00067, 0.0, +0.06834, -0.00944, -0.00061, 0.0,
+    +0.06165, -0.00851, -0.00055, 0.0, +0.05561, -0.00768, -0.00049, 0.0,
+    +0.05009, -0.00692, -0.00045, 0.0, +0.04513, -0.00623, -0.00040, 0.0,
+    +0.04059, -0.00560, -0.00036, 0.0, +0.03653, -0.00504, -0.00033, 0.0,
+    +0.03281, -0.00453, -0.00029, 0.0, +0.02951, -0.00407, -0.00026, 0.0,
+    +0.02652, -0.00366, -0.00024, 0.0, +0.02386, -0.00330, -0.00021, 0.0,
+    +0.02146, -0.00296, -0.00019, 0.0, +0.01930, -0.00267, -0.00017, 0.0,
+    +0.01734, -0.00239, -0.00015, 0.0, +0.01557, -0.00215, -0.00014, 0.0,
+    +0.01396, -0.00193, -0.00012, 0.0, +0.01250, -0.00173, -0.00011, 0.0,
+    +0.01118, -0.00154, -0.00010, 0.0, +0.01000, -0.00138, -0.00009, 0.0,
+    +0.00893, -0.00123, -0.00008, 0.0, +0.00797, -0.00110, -0.00007, 0.0,
+    +0.00712, -0.00098, -0.00006, 0.0, +0.00635, -0.00088, -0.00006, 0.0,
+    +0.00567, -0.00078, -0.00005, 0.0, +0.00506, -0.00070, -0.00005, 0.0,
+    +0.00453, -0.00062, -0.00004, 0.0, +0.00405, -0.00056, -0.00004, 0.0,
+    +0.00363, -0.00050, -0.00003, 0.0, +0.00326, -0.00045, -0.00003, 0.0};
+
+static_assert(sizeof(wavelengthToRgb) / sizeof(float) == 256 * 4,
+              "one RGBA texel per spectrum sample");
+
+}  // namespace
+
+TSpan<const float> wavelengthToRgbTable()
+{
+    return wavelengthToRgb;
+}
+
+TSpan<const GasDischargeLines> gasDischargeLines()
+{
+    return gasLines;
 }
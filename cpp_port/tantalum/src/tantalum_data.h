@@ -1,24 +1,64 @@
 #pragma once
 
-#include <functional>
-#include <map>
-#include <mutex>
-#include <vector>
+#include <cstddef>
 
-struct GasDischargeLines
+/* Read-only view of a constant array, like C++20 std::span */
+template <typename T>
+class TSpan
 {
-    std::string        name;
-    std::vector<float> wavelengths;
-    std::vector<int>   strengths;
+public:
+    constexpr TSpan() : first(nullptr), count(0)
+    {
+    }
+
+    template <size_t N>
+    constexpr TSpan(T (&array)[N]) : first(array), count(N)
+    {
+    }
+
+    constexpr T* data() const
+    {
+        return this->first;
+    }
+
+    constexpr size_t size() const
+    {
+        return this->count;
+    }
+
+    constexpr T* begin() const
+    {
+        return this->first;
+    }
+
+    constexpr T* end() const
+    {
+        return this->first + this->count;
+    }
+
+    constexpr T& operator[](size_t i) const
+    {
+        return this->first[i];
+    }
+
+private:
+    T*     first;
+    size_t count;
 };
 
-struct TantalumData
+struct GasDischargeLines
 {
-    TantalumData();
+    const char*        name;
+    TSpan<const float> wavelengths;
+    TSpan<const int>   strengths;
+};
+
+/* The tables are constant arrays in read-only memory, with no
+   initialization at startup */
 
-    void init_data();
+/* RGB response to unit radiance at TEmitter::SPECTRUM_SAMPLES wavelengths
+   over [LAMBDA_MIN, LAMBDA_MAX], one RGBA texel each, alpha 0 */
+TSpan<const float> wavelengthToRgbTable();
 
-    std::vector<GasDischargeLines> lines;
-    std::vector<float>             wavelength_to_rgb;
-    std::once_flag                 flag;
-};
\ No newline at end of file
+/* Emission lines of each gas, wavelengths in nm with relative strengths */
+TSpan<const GasDischargeLines> gasDischargeLines();
@@ -0,0 +1,196 @@
+#include <cstring>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cpu_static_scene.h"
+
+using std::cout;
+using std::endl;
+
+static constexpr int RAYS       = 4096;
+static constexpr int PRIMITIVES = 64;
+
+struct TRayInput
+{
+    glm::vec4 posDir;
+    float     tMin;
+    float     tMax;
+};
+
+struct TPrimitiveInput
+{
+    glm::vec2 pos;
+    glm::vec2 size;
+    float     params[4];
+};
+
+static bool sameBits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* Rays from inside and around the scene box in every direction, including
+   ones within the 1e-5 clamp of unpackRay. Some start with a closer hit
+   already found, so the tMax tests of the primitives decide too */
+static std::vector<TRayInput> rays(std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> span(-1.5f, 1.5f);
+
+    std::vector<TRayInput> result(RAYS);
+    for (int i = 0; i < RAYS; i++)
+    {
+        float     theta = unit(rng) * PI * 2.0f;
+        glm::vec2 dir(std::cos(theta), std::sin(theta));
+        if (i % 16 == 1) dir = glm::vec2(1e-6f, i % 32 == 1 ? 1.0f : -1.0f);
+        if (i % 16 == 2) dir = glm::vec2(i % 32 == 2 ? 1.0f : -1.0f, 0.0f);
+
+        result[i].posDir = glm::vec4(span(rng), span(rng), dir.x, dir.y);
+        result[i].tMin   = 1e-4f;
+        result[i].tMax   = i % 4 == 3 ? unit(rng) * 2.0f : 1e30f;
+    }
+    return result;
+}
+
+/* Parameters in the ranges of the built-in scenes, with radii of either
+   sign where the primitive takes one */
+static std::vector<TPrimitiveInput> primitives(std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> span(-1.0f, 1.0f);
+
+    std::vector<TPrimitiveInput> result(PRIMITIVES);
+    for (auto& p : result)
+    {
+        p.pos       = glm::vec2(span(rng), span(rng));
+        p.size      = glm::vec2(span(rng), span(rng));
+        p.params[0] = 0.05f + unit(rng) * 0.5f;
+        p.params[1] = 0.01f + unit(rng) * 0.2f;
+        for (int k = 2; k < 4; k++)
+        {
+            float sign  = unit(rng) < 0.5f ? -1.0f : 1.0f;
+            p.params[k] = sign * (0.3f + unit(rng) * 1.2f);
+        }
+    }
+    return result;
+}
+
+/* intersectShape on the packet of V against the scalar code on each of its
+   lanes; tMax, normal and material have to agree bit for bit */
+template <EPrimitiveType TYPE, typename V>
+static bool check(const char*                         name,
+                  const std::vector<TRayInput>&       rays,
+                  const std::vector<TPrimitiveInput>& primitives)
+{
+    constexpr int SIZE = V::SIZE;
+    alignas(64) float lanes[9][SIZE];
+
+    for (int base = 0; base < RAYS; base += SIZE)
+    {
+        for (int k = 0; k < SIZE; k++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                lanes[c][k] = rays[base + k].posDir[c];
+            }
+            lanes[4][k] = rays[base + k].tMin;
+            lanes[5][k] = rays[base + k].tMax;
+        }
+        TRayPacket<V> packet = unpackRayPacket(V::load(lanes[0]),
+                                               V::load(lanes[1]),
+                                               V::load(lanes[2]),
+                                               V::load(lanes[3]));
+
+        for (int i = 0; i < PRIMITIVES; i++)
+        {
+            const TPrimitiveInput& p = primitives[i];
+            float                  matId = float(i % 16);
+
+            TIntersectionPacket<V> isect;
+            isect.tMin = V::load(lanes[4]);
+            isect.tMax = V::load(lanes[5]);
+            isect.nX   = V(0.0f);
+            isect.nY   = V(0.0f);
+            isect.mat  = V(-1.0f);
+            intersectShape<TYPE>(packet, p.pos, p.size, p.params, matId, isect);
+            isect.tMax.store(lanes[5]);
+            isect.nX.store(lanes[6]);
+            isect.nY.store(lanes[7]);
+            isect.mat.store(lanes[8]);
+
+            for (int k = 0; k < SIZE; k++)
+            {
+                const TRayInput& input = rays[base + k];
+                Ray              ray   = unpackRay(input.posDir);
+                Intersection     scalar{input.tMin,
+                                        input.tMax,
+                                        glm::vec2(0.0f),
+                                        -1.0f};
+                intersectShape<TYPE>(
+                    ray, p.pos, p.size, p.params, matId, scalar);
+
+                if (!sameBits(scalar.tMax, lanes[5][k]) ||
+                    !sameBits(scalar.n.x, lanes[6][k]) ||
+                    !sameBits(scalar.n.y, lanes[7][k]) ||
+                    !sameBits(scalar.mat, lanes[8][k]))
+                {
+                    cout << name << ", " << SIZE << " wide: ray " << base + k
+                         << ", primitive " << i << ": t " << lanes[5][k]
+                         << " n (" << lanes[6][k] << ", " << lanes[7][k]
+                         << ") mat " << lanes[8][k] << " instead of t "
+                         << scalar.tMax << " n (" << scalar.n.x << ", "
+                         << scalar.n.y << ") mat " << scalar.mat << endl;
+                    return false;
+                }
+            }
+            /* Restores the tMax of the rays for the next primitive */
+            for (int k = 0; k < SIZE; k++)
+            {
+                lanes[5][k] = rays[base + k].tMax;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename V>
+static bool checkAll(const std::vector<TRayInput>&       rays,
+                     const std::vector<TPrimitiveInput>& primitives)
+{
+    using E = EPrimitiveType;
+
+    bool passed = true;
+    passed &= check<E::BBOX, V>("bbox", rays, primitives);
+    passed &= check<E::SPHERE, V>("sphere", rays, primitives);
+    passed &= check<E::LINE, V>("line", rays, primitives);
+    passed &= check<E::PRISM, V>("prism", rays, primitives);
+    passed &= check<E::BICONVEX_LENS, V>("biconvex lens", rays, primitives);
+    passed &= check<E::BICONCAVE_LENS, V>("biconcave lens", rays, primitives);
+    passed &= check<E::MENISCUS_LENS, V>("meniscus lens", rays, primitives);
+    passed &= check<E::PLANO_CONVEX_LENS, V>(
+        "plano-convex lens", rays, primitives);
+    passed &= check<E::PLANO_CONCAVE_LENS, V>(
+        "plano-concave lens", rays, primitives);
+
+    cout << V::SIZE << " wide packets match the scalar primitives: "
+         << (passed ? "ok" : "FAILED") << endl;
+    return passed;
+}
+
+/* The packet primitives of cpu_intersect_packet.h and
+   cpu_csg_intersect_packet.h give every lane the Intersection the scalar
+   code computes for its ray, bit for bit */
+int main()
+{
+    std::default_random_engine rng(11);
+    std::vector<TRayInput>       rayInputs       = rays(rng);
+    std::vector<TPrimitiveInput> primitiveInputs = primitives(rng);
+
+    bool passed = checkAll<vfloat4>(rayInputs, primitiveInputs);
+#if defined(__AVX2__)
+    passed = checkAll<vfloat8>(rayInputs, primitiveInputs) && passed;
+#endif
+    return passed ? 0 : 1;
+}
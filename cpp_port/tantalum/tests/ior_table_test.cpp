@@ -0,0 +1,55 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "scene_data.h"
+#include "scene_info.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+static const std::string scene_path = std::string(PROJECT_DIR) + "/scenes/";
+
+/* The IorData tables of every dielectric in the built-in scenes have to
+   follow the Sellmeier equation to within IOR_MAX_ERROR between their
+   samples; scene files outside the list only get a warning when loaded */
+int main()
+{
+    std::vector<TSceneInfo> scenes;
+    try
+    {
+        scenes = builtinSceneInfos(scene_path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    bool passed      = true;
+    int  dielectrics = 0;
+    for (const auto& scene : scenes)
+    {
+        for (const auto& material : scene.materials)
+        {
+            if (material.type != EMaterialType::DIELECTRIC &&
+                material.type != EMaterialType::ROUGH_DIELECTRIC)
+                continue;
+
+            double error = iorTableError(material);
+            bool   ok    = error <= IOR_MAX_ERROR;
+            cout << scene.name << ", material " << material.id << ": error "
+                 << error << (ok ? " ok" : " FAILED") << endl;
+            passed = passed && ok;
+            dielectrics++;
+        }
+    }
+    if (dielectrics == 0)
+    {
+        cerr << "no dielectrics in the built-in scenes" << endl;
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cpu_rand.h"
+#include "cpu_rand_packet.h"
+
+using std::cout;
+using std::endl;
+
+static constexpr int RAYS  = 1024;
+static constexpr int STEPS = 2000;
+
+static const int64_t multipliers[4] = {3423, 2646, 1707, 1999};
+static const int64_t moduli[4]      = {4194287, 4194277, 4194191, 4194167};
+
+static bool sameBits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* Seeds across the whole state range [1, m), with the edges of the
+   Schrage decomposition: multiples of q, one below them, and m - 1 */
+static std::vector<glm::vec4> seeds()
+{
+    static const int64_t q[4] = {1225, 1585, 2457, 2098};
+
+    std::default_random_engine rng(5);
+    std::vector<glm::vec4>     result(RAYS);
+    for (int i = 0; i < RAYS; i++)
+    {
+        for (int t = 0; t < 4; t++)
+        {
+            std::uniform_int_distribution<int64_t> dist(1, moduli[t] - 1);
+            int64_t                                seed = dist(rng);
+            if (i % 8 == 1) seed = q[t] * (1 + i % 1000);
+            if (i % 8 == 3) seed = q[t] * (1 + i % 1000) - 1;
+            if (i == 5) seed = moduli[t] - 1;
+            result[i][t] = float(seed);
+        }
+    }
+    return result;
+}
+
+/* The scalar mirror against the exact Lehmer recurrence, state = a*state
+   mod m in integers: float arithmetic has to reproduce it without error */
+static bool checkScalar(const std::vector<glm::vec4>& start)
+{
+    for (int i = 0; i < RAYS; i++)
+    {
+        glm::vec4 state = start[i];
+        int64_t   exact[4];
+        for (int t = 0; t < 4; t++)
+        {
+            exact[t] = int64_t(start[i][t]);
+        }
+
+        for (int step = 0; step < STEPS; step++)
+        {
+            rand(state);
+            for (int t = 0; t < 4; t++)
+            {
+                exact[t] = exact[t] * multipliers[t] % moduli[t];
+                if (state[t] != float(exact[t]))
+                {
+                    cout << "scalar: ray " << i << ", generator " << t
+                         << ", step " << step << ": " << state[t]
+                         << " instead of " << exact[t] << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* The packet generator against the scalar one, states and results */
+template <typename V>
+static bool checkPacket(const std::vector<glm::vec4>& start)
+{
+    constexpr int SIZE = V::SIZE;
+    alignas(64) float lanes[4][SIZE];
+    alignas(64) float result[SIZE];
+
+    for (int base = 0; base < RAYS; base += SIZE)
+    {
+        std::vector<glm::vec4> scalar(start.begin() + base,
+                                      start.begin() + base + SIZE);
+        V                      state[4];
+        for (int t = 0; t < 4; t++)
+        {
+            for (int k = 0; k < SIZE; k++)
+            {
+                lanes[t][k] = scalar[k][t];
+            }
+            state[t] = V::load(lanes[t]);
+        }
+
+        for (int step = 0; step < STEPS; step++)
+        {
+            rand(state).store(result);
+            for (int t = 0; t < 4; t++)
+            {
+                state[t].store(lanes[t]);
+            }
+
+            for (int k = 0; k < SIZE; k++)
+            {
+                bool ok = sameBits(rand(scalar[k]), result[k]);
+                for (int t = 0; t < 4; t++)
+                {
+                    ok = ok && sameBits(scalar[k][t], lanes[t][k]);
+                }
+                if (!ok)
+                {
+                    cout << SIZE << " wide: ray " << base + k << ", step "
+                         << step << " differs from the scalar generator"
+                         << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* rand() of cpu_rand.h follows the exact integer recurrence, and
+   cpu_rand_packet.h repeats it bit for bit in every packet width */
+int main()
+{
+    std::vector<glm::vec4> start = seeds();
+
+    bool passed = checkScalar(start);
+    cout << "scalar matches the integer recurrence: "
+         << (passed ? "ok" : "FAILED") << endl;
+
+    bool sse = checkPacket<vfloat4>(start);
+    cout << "4 wide packets match the scalar generator: "
+         << (sse ? "ok" : "FAILED") << endl;
+    passed = passed && sse;
+
+#if defined(__AVX2__)
+    bool avx = checkPacket<vfloat8>(start);
+    cout << "8 wide packets match the scalar generator: "
+         << (avx ? "ok" : "FAILED") << endl;
+    passed = passed && avx;
+#endif
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cpu_renderer.h"
+#include "scene_info.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+static const std::string scene_path = std::string(PROJECT_DIR) + "/scenes/";
+
+/* Mean radiance of a finished render of scene, per pixel and channel */
+static double renderMean(const std::vector<TSceneInfo>& scenes,
+                         int                            scene,
+                         int                            samples,
+                         bool                           regenerate)
+{
+    TCpuRenderer renderer(160, 90, scenes);
+    renderer.regenerate = regenerate;
+    renderer.setMaxSampleCount(samples);
+    renderer.changeScene(scene);
+    renderer.setSpreadType(scenes[scene].spread);
+    renderer.setNormalizedEmitterPos(scenes[scene].posA, scenes[scene].posB);
+    while (!renderer.finished())
+    {
+        renderer.render();
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < renderer.screenBuffer.size(); i += 4)
+    {
+        sum += renderer.screenBuffer[i + 0] + renderer.screenBuffer[i + 1] +
+               renderer.screenBuffer[i + 2];
+    }
+    return sum * renderer.exposure() / (renderer.screenBuffer.size() / 4 * 3);
+}
+
+/* Regeneration re-emits rays as their paths end, but must converge to the
+   same image as whole waves: every path that was emitted has to reach the
+   image before the render finishes, and nothing else. Scene 0 is open, so
+   paths end at all depths. 100000 samples is less than one ray buffer */
+int main()
+{
+    std::vector<TSceneInfo> scenes;
+    try
+    {
+        scenes = builtinSceneInfos(scene_path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    bool passed = true;
+    for (int samples : {100000, 600000})
+    {
+        double waves       = renderMean(scenes, 0, samples, false);
+        double regenerated = renderMean(scenes, 0, samples, true);
+        double error       = std::abs(regenerated - waves) / waves;
+
+        bool ok = error < 0.02;
+        cout << samples << " samples: waves " << waves << ", regenerated "
+             << regenerated << (ok ? " ok" : " FAILED") << endl;
+        passed = passed && ok;
+    }
+    return passed ? 0 : 1;
+}
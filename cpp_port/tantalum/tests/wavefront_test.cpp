@@ -0,0 +1,70 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cpu_renderer.h"
+#include "scene_info.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+static const std::string scene_path = std::string(PROJECT_DIR) + "/scenes/";
+
+static std::vector<float> render(const std::vector<TSceneInfo>& scenes,
+                                 int                            scene,
+                                 bool                           wavefront,
+                                 bool                           hero)
+{
+    TCpuRenderer renderer(96, 54, scenes);
+    renderer.wavefront       = wavefront;
+    renderer.heroWavelengths = hero;
+    renderer.setMaxSampleCount(40000);
+    renderer.changeScene(scene);
+    renderer.setSpreadType(scenes[scene].spread);
+    renderer.setNormalizedEmitterPos(scenes[scene].posA, scenes[scene].posB);
+    while (!renderer.finished())
+    {
+        renderer.render();
+    }
+    return renderer.screenBuffer;
+}
+
+/* Wavefront mode shades each run of one material in packets, which must
+   give every ray exactly what the scalar shading gives it: the images of
+   every built-in scene have to be the same bit for bit, with and without
+   hero wavelengths */
+int main()
+{
+    std::vector<TSceneInfo> scenes;
+    try
+    {
+        scenes = builtinSceneInfos(scene_path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    bool passed = true;
+    for (int scene = 0; scene < int(scenes.size()); scene++)
+    {
+        for (bool hero : {false, true})
+        {
+            std::vector<float> scalar = render(scenes, scene, false, hero);
+            std::vector<float> packet = render(scenes, scene, true, hero);
+
+            bool ok = scalar.size() == packet.size() &&
+                      std::memcmp(scalar.data(),
+                                  packet.data(),
+                                  scalar.size() * sizeof(float)) == 0;
+            cout << scenes[scene].name << (hero ? ", hero" : "") << ": "
+                 << (ok ? "ok" : "FAILED") << endl;
+            passed = passed && ok;
+        }
+    }
+    return passed ? 0 : 1;
+}